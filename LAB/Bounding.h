@@ -0,0 +1,5 @@
+#pragma once
+
+#include "Bounding/AABB.h"
+#include "Bounding/Sphere.h"
+#include "Bounding/OBB.h"
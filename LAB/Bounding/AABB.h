@@ -0,0 +1,250 @@
+#pragma once
+#include "../Matrix.h"
+#include "../Vector/VectorSoA.h"
+#include "../Support/SIMD.h"
+#include "../Support/Bitmask.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+//axis aligned bounding box as its min and max corners
+//the batched functions take the boxes as two VectorSoA<F, 3>, mins and maxs, and their SIMD paths are bit identical to the members
+
+namespace lab {
+    namespace detail {
+        //same lane semantics as SIMD::Min and SIMD::Max, so the scalar and SIMD paths agree even on signed zeros
+        template<std::floating_point F>
+        LAB_constexpr F BoundsMin(F const lhs, F const rhs) {
+            return (lhs < rhs) ? lhs : rhs;
+        }
+        template<std::floating_point F>
+        LAB_constexpr F BoundsMax(F const lhs, F const rhs) {
+            return (lhs > rhs) ? lhs : rhs;
+        }
+        //the point (w = 1) times the matrix, summed in the order the SIMD paths use
+        template<std::floating_point F>
+        LAB_constexpr Vector<F, 3> TransformBoundsPoint(Matrix<F, 4, 4> const& matrix, Vector<F, 3> const point) {
+            Vector<F, 3> ret;
+            for (uint8_t row = 0; row < 3; row++) {
+                ret[row] = ((matrix.At(0, row) * point.x + matrix.At(1, row) * point.y) + matrix.At(2, row) * point.z) + matrix.At(3, row);
+            }
+            return ret;
+        }
+    }
+
+    template<std::floating_point F>
+    struct AABB {
+        Vector<F, 3> min;
+        Vector<F, 3> max;
+
+        LAB_constexpr AABB() : min{F(0)}, max{F(0)} {}
+        LAB_constexpr AABB(Vector<F, 3> const min, Vector<F, 3> const max) : min{min}, max{max} {}
+
+        //inverted, merging anything into it gives that thing back
+        static LAB_constexpr AABB Empty() {
+            return AABB{Vector<F, 3>{std::numeric_limits<F>::max()}, Vector<F, 3>{std::numeric_limits<F>::lowest()}};
+        }
+        static LAB_constexpr AABB FromCenterExtents(Vector<F, 3> const center, Vector<F, 3> const extents) {
+            return AABB{center - extents, center + extents};
+        }
+
+        LAB_constexpr Vector<F, 3> GetCenter() const {
+            return (min + max) * F(0.5);
+        }
+        //half the size on each axis
+        LAB_constexpr Vector<F, 3> GetExtents() const {
+            return (max - min) * F(0.5);
+        }
+        LAB_constexpr F SurfaceArea() const {
+            const Vector<F, 3> size = max - min;
+            return F(2) * ((size.x * size.y + size.y * size.z) + size.z * size.x);
+        }
+        LAB_constexpr bool IsEmpty() const {
+            return (max.x < min.x) || (max.y < min.y) || (max.z < min.z);
+        }
+
+        LAB_constexpr bool Contains(Vector<F, 3> const point) const {
+            return (min.x <= point.x) && (point.x <= max.x)
+                && (min.y <= point.y) && (point.y <= max.y)
+                && (min.z <= point.z) && (point.z <= max.z);
+        }
+        LAB_constexpr bool Contains(AABB const& other) const {
+            return (min.x <= other.min.x) && (other.max.x <= max.x)
+                && (min.y <= other.min.y) && (other.max.y <= max.y)
+                && (min.z <= other.min.z) && (other.max.z <= max.z);
+        }
+        //touching counts as intersecting
+        LAB_constexpr bool Intersects(AABB const& other) const {
+            return !((max.x < other.min.x) || (other.max.x < min.x)
+                || (max.y < other.min.y) || (other.max.y < min.y)
+                || (max.z < other.min.z) || (other.max.z < min.z));
+        }
+
+        LAB_constexpr AABB Merge(AABB const& other) const {
+            return AABB{
+                Vector<F, 3>{detail::BoundsMin(min.x, other.min.x), detail::BoundsMin(min.y, other.min.y), detail::BoundsMin(min.z, other.min.z)},
+                Vector<F, 3>{detail::BoundsMax(max.x, other.max.x), detail::BoundsMax(max.y, other.max.y), detail::BoundsMax(max.z, other.max.z)}
+            };
+        }
+        LAB_constexpr AABB Merge(Vector<F, 3> const point) const {
+            return Merge(AABB{point, point});
+        }
+
+        //Arvo's method, the box around the transformed box without transforming its 8 corners
+        //each output axis starts at the translation and takes the smaller and larger of matrix element * min and * max per input axis
+        //an empty box does not stay empty
+        LAB_constexpr AABB Transformed(Matrix<F, 4, 4> const& matrix) const {
+            AABB ret;
+            for (uint8_t row = 0; row < 3; row++) {
+                F lower = matrix.At(3, row);
+                F upper = lower;
+                for (uint8_t column = 0; column < 3; column++) {
+                    const F a = matrix.At(column, row) * min[column];
+                    const F b = matrix.At(column, row) * max[column];
+                    lower += detail::BoundsMin(a, b);
+                    upper += detail::BoundsMax(a, b);
+                }
+                ret.min[row] = lower;
+                ret.max[row] = upper;
+            }
+            return ret;
+        }
+    };
+
+    //outMins and outMaxs are resized to match, and are allowed to be the same objects as mins and maxs
+    template<std::floating_point F>
+    LAB_constexpr void TransformAABBs(Matrix<F, 4, 4> const& matrix, VectorSoA<F, 3> const& mins, VectorSoA<F, 3> const& maxs, VectorSoA<F, 3>& outMins, VectorSoA<F, 3>& outMaxs) {
+#if LAB_DEBUGGING_ACCESS
+        assert(mins.Size() == maxs.Size());
+#endif
+        outMins.Resize(mins.Size());
+        outMaxs.Resize(mins.Size());
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                SIMD::Float elements[3][3];
+                SIMD::Float translation[3];
+                for (uint8_t row = 0; row < 3; row++) {
+                    for (uint8_t column = 0; column < 3; column++) {
+                        elements[column][row] = SIMD::Set1(matrix.At(column, row));
+                    }
+                    translation[row] = SIMD::Set1(matrix.At(3, row));
+                }
+                for (std::size_t i = 0; i < mins.PaddedSize(); i += SIMD::FloatWidth) {
+                    const SIMD::Float lowerIn[3] = {SIMD::Load(mins.X() + i), SIMD::Load(mins.Y() + i), SIMD::Load(mins.Z() + i)};
+                    const SIMD::Float upperIn[3] = {SIMD::Load(maxs.X() + i), SIMD::Load(maxs.Y() + i), SIMD::Load(maxs.Z() + i)};
+                    for (uint8_t row = 0; row < 3; row++) {
+                        SIMD::Float lower = translation[row];
+                        SIMD::Float upper = translation[row];
+                        for (uint8_t column = 0; column < 3; column++) {
+                            const SIMD::Float a = SIMD::Mul(elements[column][row], lowerIn[column]);
+                            const SIMD::Float b = SIMD::Mul(elements[column][row], upperIn[column]);
+                            lower = SIMD::Add(lower, SIMD::Min(a, b));
+                            upper = SIMD::Add(upper, SIMD::Max(a, b));
+                        }
+                        SIMD::Store(outMins.Stream(row) + i, lower);
+                        SIMD::Store(outMaxs.Stream(row) + i, upper);
+                    }
+                }
+                return;
+            }
+        }
+#endif
+        for (std::size_t i = 0; i < mins.Size(); i++) {
+            const AABB<F> box = AABB<F>{mins.Get(i), maxs.Get(i)}.Transformed(matrix);
+            outMins.Set(i, box.min);
+            outMaxs.Set(i, box.max);
+        }
+    }
+
+    //the box around every box, AABB<F>::Empty() when there are none
+    template<std::floating_point F>
+    LAB_constexpr AABB<F> MergeAABBs(VectorSoA<F, 3> const& mins, VectorSoA<F, 3> const& maxs) {
+#if LAB_DEBUGGING_ACCESS
+        assert(mins.Size() == maxs.Size());
+#endif
+        AABB<F> ret = AABB<F>::Empty();
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                if (mins.Size() >= SIMD::FloatWidth) {
+                    //the padding isn't part of the set, only whole blocks go through here
+                    SIMD::Float lower[3];
+                    SIMD::Float upper[3];
+                    for (uint8_t dim = 0; dim < 3; dim++) {
+                        lower[dim] = SIMD::Load(mins.Stream(dim));
+                        upper[dim] = SIMD::Load(maxs.Stream(dim));
+                    }
+                    for (i = SIMD::FloatWidth; i + SIMD::FloatWidth <= mins.Size(); i += SIMD::FloatWidth) {
+                        for (uint8_t dim = 0; dim < 3; dim++) {
+                            lower[dim] = SIMD::Min(lower[dim], SIMD::Load(mins.Stream(dim) + i));
+                            upper[dim] = SIMD::Max(upper[dim], SIMD::Load(maxs.Stream(dim) + i));
+                        }
+                    }
+                    alignas(SIMD::Alignment) float lowerLanes[3][SIMD::FloatWidth];
+                    alignas(SIMD::Alignment) float upperLanes[3][SIMD::FloatWidth];
+                    for (uint8_t dim = 0; dim < 3; dim++) {
+                        SIMD::Store(lowerLanes[dim], lower[dim]);
+                        SIMD::Store(upperLanes[dim], upper[dim]);
+                    }
+                    for (uint8_t lane = 0; lane < SIMD::FloatWidth; lane++) {
+                        ret = ret.Merge(AABB<F>{
+                            Vector<F, 3>{lowerLanes[0][lane], lowerLanes[1][lane], lowerLanes[2][lane]},
+                            Vector<F, 3>{upperLanes[0][lane], upperLanes[1][lane], upperLanes[2][lane]}
+                        });
+                    }
+                }
+            }
+        }
+#endif
+        for (; i < mins.Size(); i++) {
+            ret = ret.Merge(AABB<F>{mins.Get(i), maxs.Get(i)});
+        }
+        return ret;
+    }
+
+    //bit i % 64 of hits[i / 64] is set when box i intersects query, touching counts
+    //hits needs BitmaskWordCount(mins.Size()) words, every one of them is overwritten
+    template<std::floating_point F>
+    LAB_constexpr void IntersectAABBs(AABB<F> const& query, VectorSoA<F, 3> const& mins, VectorSoA<F, 3> const& maxs, std::span<uint64_t> const hits) {
+#if LAB_DEBUGGING_ACCESS
+        assert(mins.Size() == maxs.Size());
+#endif
+        const std::size_t count = mins.Size();
+        detail::ClearBitmask(hits, count);
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                constexpr int laneBits = (1 << SIMD::FloatWidth) - 1;
+                SIMD::Float queryMin[3];
+                SIMD::Float queryMax[3];
+                for (uint8_t dim = 0; dim < 3; dim++) {
+                    queryMin[dim] = SIMD::Set1(query.min[dim]);
+                    queryMax[dim] = SIMD::Set1(query.max[dim]);
+                }
+                for (std::size_t i = 0; i < count; i += SIMD::FloatWidth) {
+                    SIMD::Float separated = SIMD::Less(queryMax[0], SIMD::Load(mins.X() + i));
+                    separated = SIMD::Or(separated, SIMD::Less(SIMD::Load(maxs.X() + i), queryMin[0]));
+                    for (uint8_t dim = 1; dim < 3; dim++) {
+                        separated = SIMD::Or(separated, SIMD::Less(queryMax[dim], SIMD::Load(mins.Stream(dim) + i)));
+                        separated = SIMD::Or(separated, SIMD::Less(SIMD::Load(maxs.Stream(dim) + i), queryMin[dim]));
+                    }
+                    const uint64_t hit = static_cast<uint64_t>(~SIMD::MoveMask(separated) & laneBits);
+                    hits[i / 64] |= hit << (i % 64);
+                }
+                detail::MaskBitmaskTail(hits, count);
+                return;
+            }
+        }
+#endif
+        for (std::size_t i = 0; i < count; i++) {
+            if (query.Intersects(AABB<F>{mins.Get(i), maxs.Get(i)})) {
+                hits[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include "AABB.h"
+#include "Sphere.h"
+
+//oriented bounding box as a center, three unit axes and the half size along each axis
+//no batched form, OBBs are the narrow phase shape. the broadphase runs on AABBs and spheres
+
+namespace lab {
+    template<std::floating_point F>
+    struct OBB {
+        Vector<F, 3> center;
+        //half the size along each axis
+        Vector<F, 3> extents;
+        //orthonormal
+        Vector<F, 3> axes[3];
+
+        LAB_constexpr OBB() : center{F(0)}, extents{F(0)}, axes{Vector<F, 3>{F(1), F(0), F(0)}, Vector<F, 3>{F(0), F(1), F(0)}, Vector<F, 3>{F(0), F(0), F(1)}} {}
+        LAB_constexpr OBB(Vector<F, 3> const center, Vector<F, 3> const extents, Vector<F, 3> const axisX, Vector<F, 3> const axisY, Vector<F, 3> const axisZ)
+            : center{center}, extents{extents}, axes{axisX, axisY, axisZ}
+        {}
+
+        static LAB_constexpr OBB FromAABB(AABB<F> const& box) {
+            OBB ret;
+            ret.center = box.GetCenter();
+            ret.extents = box.GetExtents();
+            return ret;
+        }
+        //index bit 0 picks the side along axes[0], bit 1 along axes[1], bit 2 along axes[2]
+        LAB_constexpr Vector<F, 3> GetCorner(uint8_t const index) const {
+#if LAB_DEBUGGING_ACCESS
+            assert(index < 8);
+#endif
+            Vector<F, 3> ret = center;
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                const F side = (index >> axis) & 1 ? extents[axis] : -extents[axis];
+                ret += axes[axis] * side;
+            }
+            return ret;
+        }
+        LAB_constexpr AABB<F> ToAABB() const {
+            Vector<F, 3> worldExtents;
+            for (uint8_t dim = 0; dim < 3; dim++) {
+                worldExtents[dim] = (Abs(axes[0][dim]) * extents.x + Abs(axes[1][dim]) * extents.y) + Abs(axes[2][dim]) * extents.z;
+            }
+            return AABB<F>::FromCenterExtents(center, worldExtents);
+        }
+
+        LAB_constexpr bool Contains(Vector<F, 3> const point) const {
+            const Vector<F, 3> delta = point - center;
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                if (Abs(delta.Dot(axes[axis])) > extents[axis]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        LAB_constexpr Vector<F, 3> ClosestPoint(Vector<F, 3> const point) const {
+            const Vector<F, 3> delta = point - center;
+            Vector<F, 3> ret = center;
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                ret += axes[axis] * Clamp(delta.Dot(axes[axis]), -extents[axis], extents[axis]);
+            }
+            return ret;
+        }
+        LAB_constexpr bool Intersects(Sphere<F> const& sphere) const {
+            return (ClosestPoint(sphere.center) - sphere.center).SquaredMagnitude() <= sphere.radius * sphere.radius;
+        }
+        //separating axis test over the 3 + 3 face axes and the 9 edge cross products (Real-Time Collision Detection 4.4.1)
+        LAB_constexpr bool Intersects(OBB const& other) const {
+            //other's axes in this box's frame, the epsilon keeps near parallel edge pairs from producing a false separating axis
+            constexpr F epsilon = F(1e-6);
+            F rotation[3][3];
+            F absRotation[3][3];
+            for (uint8_t i = 0; i < 3; i++) {
+                for (uint8_t j = 0; j < 3; j++) {
+                    rotation[i][j] = axes[i].Dot(other.axes[j]);
+                    absRotation[i][j] = Abs(rotation[i][j]) + epsilon;
+                }
+            }
+            const Vector<F, 3> worldDelta = other.center - center;
+            const F delta[3] = {worldDelta.Dot(axes[0]), worldDelta.Dot(axes[1]), worldDelta.Dot(axes[2])};
+
+            for (uint8_t i = 0; i < 3; i++) {
+                const F otherRadius = (other.extents.x * absRotation[i][0] + other.extents.y * absRotation[i][1]) + other.extents.z * absRotation[i][2];
+                if (Abs(delta[i]) > extents[i] + otherRadius) {
+                    return false;
+                }
+            }
+            for (uint8_t j = 0; j < 3; j++) {
+                const F thisRadius = (extents.x * absRotation[0][j] + extents.y * absRotation[1][j]) + extents.z * absRotation[2][j];
+                const F distance = (delta[0] * rotation[0][j] + delta[1] * rotation[1][j]) + delta[2] * rotation[2][j];
+                if (Abs(distance) > thisRadius + other.extents[j]) {
+                    return false;
+                }
+            }
+            //axes[i] x other.axes[j]
+            for (uint8_t i = 0; i < 3; i++) {
+                const uint8_t i1 = static_cast<uint8_t>((i + 1) % 3);
+                const uint8_t i2 = static_cast<uint8_t>((i + 2) % 3);
+                for (uint8_t j = 0; j < 3; j++) {
+                    const uint8_t j1 = static_cast<uint8_t>((j + 1) % 3);
+                    const uint8_t j2 = static_cast<uint8_t>((j + 2) % 3);
+                    const F thisRadius = extents[i1] * absRotation[i2][j] + extents[i2] * absRotation[i1][j];
+                    const F otherRadius = other.extents[j1] * absRotation[i][j2] + other.extents[j2] * absRotation[i][j1];
+                    const F distance = delta[i2] * rotation[i1][j] - delta[i1] * rotation[i2][j];
+                    if (Abs(distance) > thisRadius + otherRadius) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        LAB_constexpr bool Intersects(AABB<F> const& box) const {
+            return Intersects(FromAABB(box));
+        }
+
+        //keeps this box's axes and grows it around other's corners, so the result depends on the order of the merge
+        LAB_constexpr OBB Merge(OBB const& other) const {
+            Vector<F, 3> lower = -extents;
+            Vector<F, 3> upper = extents;
+            for (uint8_t corner = 0; corner < 8; corner++) {
+                const Vector<F, 3> delta = other.GetCorner(corner) - center;
+                for (uint8_t axis = 0; axis < 3; axis++) {
+                    const F distance = delta.Dot(axes[axis]);
+                    lower[axis] = detail::BoundsMin(lower[axis], distance);
+                    upper[axis] = detail::BoundsMax(upper[axis], distance);
+                }
+            }
+            OBB ret = *this;
+            const Vector<F, 3> localCenter = (lower + upper) * F(0.5);
+            ret.center = center + axes[0] * localCenter.x + axes[1] * localCenter.y + axes[2] * localCenter.z;
+            ret.extents = (upper - lower) * F(0.5);
+            return ret;
+        }
+        LAB_constexpr OBB Merge(Vector<F, 3> const point) const {
+            return Merge(OBB{point, Vector<F, 3>{F(0)}, axes[0], axes[1], axes[2]});
+        }
+
+        //the axes are renormalized and their lengths move into the extents
+        //exact for rotation, translation and scale along the box axes, a scale across them shears the box and the result is not enclosing
+        LAB_constexpr OBB Transformed(Matrix<F, 4, 4> const& matrix) const {
+            OBB ret;
+            ret.center = detail::TransformBoundsPoint(matrix, center);
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                Vector<F, 3> transformed;
+                for (uint8_t row = 0; row < 3; row++) {
+                    transformed[row] = (matrix.At(0, row) * axes[axis].x + matrix.At(1, row) * axes[axis].y) + matrix.At(2, row) * axes[axis].z;
+                }
+                const F scale = transformed.Magnitude();
+                ret.axes[axis] = transformed / scale;
+                ret.extents[axis] = extents[axis] * scale;
+            }
+            return ret;
+        }
+    };
+}
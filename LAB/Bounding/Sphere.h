@@ -0,0 +1,156 @@
+#pragma once
+#include "AABB.h"
+
+//bounding sphere as a center and radius
+//the batched functions take the spheres as a VectorSoA<F, 4>, xyz is the center and w the radius, same as CullSpheres in Frustum.h
+
+namespace lab {
+    namespace detail {
+        //the largest axis scale of the upper 3x3, a sphere grows by this much under the matrix
+        template<std::floating_point F>
+        LAB_constexpr F MaxAxisScale(Matrix<F, 4, 4> const& matrix) {
+            F largest = F(0);
+            for (uint8_t column = 0; column < 3; column++) {
+                const F x = matrix.At(column, 0);
+                const F y = matrix.At(column, 1);
+                const F z = matrix.At(column, 2);
+                largest = BoundsMax(largest, (x * x + y * y) + z * z);
+            }
+            return Sqrt(largest);
+        }
+    }
+
+    template<std::floating_point F>
+    struct Sphere {
+        Vector<F, 3> center;
+        F radius;
+
+        LAB_constexpr Sphere() : center{F(0)}, radius{F(0)} {}
+        LAB_constexpr Sphere(Vector<F, 3> const center, F const radius) : center{center}, radius{radius} {}
+
+        //the sphere through the corners, not the smallest sphere around the box
+        static LAB_constexpr Sphere FromAABB(AABB<F> const& box) {
+            return Sphere{box.GetCenter(), box.GetExtents().Magnitude()};
+        }
+        LAB_constexpr AABB<F> ToAABB() const {
+            return AABB<F>::FromCenterExtents(center, Vector<F, 3>{radius});
+        }
+
+        LAB_constexpr bool Contains(Vector<F, 3> const point) const {
+            return (point - center).SquaredMagnitude() <= radius * radius;
+        }
+        LAB_constexpr bool Contains(Sphere const& other) const {
+            return (other.center - center).Magnitude() + other.radius <= radius;
+        }
+        //touching counts as intersecting
+        LAB_constexpr bool Intersects(Sphere const& other) const {
+            const Vector<F, 3> delta = other.center - center;
+            const F radii = radius + other.radius;
+            return ((delta.x * delta.x + delta.y * delta.y) + delta.z * delta.z) <= radii * radii;
+        }
+        //distance from the center to the closest point of the box
+        LAB_constexpr bool Intersects(AABB<F> const& box) const {
+            F sqrdDistance = F(0);
+            for (uint8_t dim = 0; dim < 3; dim++) {
+                const F closest = detail::BoundsMin(detail::BoundsMax(center[dim], box.min[dim]), box.max[dim]);
+                const F delta = center[dim] - closest;
+                sqrdDistance += delta * delta;
+            }
+            return sqrdDistance <= radius * radius;
+        }
+
+        //the smallest sphere around both
+        LAB_constexpr Sphere Merge(Sphere const& other) const {
+            const Vector<F, 3> delta = other.center - center;
+            const F distance = delta.Magnitude();
+            if (distance + other.radius <= radius) {
+                return *this;
+            }
+            if (distance + radius <= other.radius) {
+                return other;
+            }
+            const F mergedRadius = (distance + radius + other.radius) * F(0.5);
+            return Sphere{center + delta * ((mergedRadius - radius) / distance), mergedRadius};
+        }
+        LAB_constexpr Sphere Merge(Vector<F, 3> const point) const {
+            return Merge(Sphere{point, F(0)});
+        }
+
+        //the radius grows by the largest axis scale, so a non uniform scale gives a loose but still enclosing sphere
+        LAB_constexpr Sphere Transformed(Matrix<F, 4, 4> const& matrix) const {
+            return Sphere{detail::TransformBoundsPoint(matrix, center), radius * detail::MaxAxisScale(matrix)};
+        }
+    };
+
+    //out is resized to match, and is allowed to be the same object as spheres
+    template<std::floating_point F>
+    LAB_constexpr void TransformSpheres(Matrix<F, 4, 4> const& matrix, VectorSoA<F, 4> const& spheres, VectorSoA<F, 4>& out) {
+        out.Resize(spheres.Size());
+        const F scale = detail::MaxAxisScale(matrix);
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                SIMD::Float elements[4][3];
+                for (uint8_t column = 0; column < 4; column++) {
+                    for (uint8_t row = 0; row < 3; row++) {
+                        elements[column][row] = SIMD::Set1(matrix.At(column, row));
+                    }
+                }
+                const SIMD::Float scaleLanes = SIMD::Set1(scale);
+                for (std::size_t i = 0; i < spheres.PaddedSize(); i += SIMD::FloatWidth) {
+                    const SIMD::Float x = SIMD::Load(spheres.X() + i);
+                    const SIMD::Float y = SIMD::Load(spheres.Y() + i);
+                    const SIMD::Float z = SIMD::Load(spheres.Z() + i);
+                    for (uint8_t row = 0; row < 3; row++) {
+                        const SIMD::Float xy = SIMD::Add(SIMD::Mul(elements[0][row], x), SIMD::Mul(elements[1][row], y));
+                        SIMD::Store(out.Stream(row) + i, SIMD::Add(SIMD::Add(xy, SIMD::Mul(elements[2][row], z)), elements[3][row]));
+                    }
+                    SIMD::Store(out.W() + i, SIMD::Mul(SIMD::Load(spheres.W() + i), scaleLanes));
+                }
+                return;
+            }
+        }
+#endif
+        for (std::size_t i = 0; i < spheres.Size(); i++) {
+            const Vector<F, 4> sphere = spheres.Get(i);
+            const Vector<F, 3> center = detail::TransformBoundsPoint(matrix, Vector<F, 3>{sphere.x, sphere.y, sphere.z});
+            out.Set(i, Vector<F, 4>{center.x, center.y, center.z, sphere.w * scale});
+        }
+    }
+
+    //bit i % 64 of hits[i / 64] is set when sphere i intersects query, touching counts
+    //hits needs BitmaskWordCount(spheres.Size()) words, every one of them is overwritten
+    template<std::floating_point F>
+    LAB_constexpr void IntersectSpheres(Sphere<F> const& query, VectorSoA<F, 4> const& spheres, std::span<uint64_t> const hits) {
+        const std::size_t count = spheres.Size();
+        detail::ClearBitmask(hits, count);
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                constexpr int laneBits = (1 << SIMD::FloatWidth) - 1;
+                const SIMD::Float queryX = SIMD::Set1(query.center.x);
+                const SIMD::Float queryY = SIMD::Set1(query.center.y);
+                const SIMD::Float queryZ = SIMD::Set1(query.center.z);
+                const SIMD::Float queryRadius = SIMD::Set1(query.radius);
+                for (std::size_t i = 0; i < count; i += SIMD::FloatWidth) {
+                    const SIMD::Float dx = SIMD::Sub(SIMD::Load(spheres.X() + i), queryX);
+                    const SIMD::Float dy = SIMD::Sub(SIMD::Load(spheres.Y() + i), queryY);
+                    const SIMD::Float dz = SIMD::Sub(SIMD::Load(spheres.Z() + i), queryZ);
+                    const SIMD::Float sqrdDistance = SIMD::Add(SIMD::Add(SIMD::Mul(dx, dx), SIMD::Mul(dy, dy)), SIMD::Mul(dz, dz));
+                    const SIMD::Float radii = SIMD::Add(queryRadius, SIMD::Load(spheres.W() + i));
+                    const uint64_t hit = static_cast<uint64_t>(SIMD::MoveMask(SIMD::LessEqual(sqrdDistance, SIMD::Mul(radii, radii))) & laneBits);
+                    hits[i / 64] |= hit << (i % 64);
+                }
+                detail::MaskBitmaskTail(hits, count);
+                return;
+            }
+        }
+#endif
+        for (std::size_t i = 0; i < count; i++) {
+            const Vector<F, 4> sphere = spheres.Get(i);
+            if (query.Intersects(Sphere<F>{Vector<F, 3>{sphere.x, sphere.y, sphere.z}, sphere.w})) {
+                hits[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+}
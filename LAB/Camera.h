@@ -82,8 +82,13 @@ namespace lab{
     requires(IsCoordinateSystem<CS>::value)
     LAB_constexpr Matrix<F, 4, 4> ViewDirection(Vector<F, 3> const position, Vector<F, 3> const forward, Vector<F, 3> const upDir = CS::unitUpVector){
         Matrix<F, 4, 4> ret{};
-        const Vector<float, 3> right = Cross(forward, upDir).Normalized();
-        const Vector<float, 3> up = Cross(right, forward).Normalized();
+#ifdef LAB_LEFT_HANDED
+        const Vector<F, 3> right = Cross(upDir, forward).Normalized();
+        const Vector<F, 3> up = Cross(forward, right).Normalized();
+#else
+        const Vector<F, 3> right = Cross(forward, upDir).Normalized();
+        const Vector<F, 3> up = Cross(right, forward).Normalized();
+#endif
         
         if constexpr(CS::f_sign){
             ret.columns[0][CS::f_axis] = -forward.x;
@@ -187,12 +192,9 @@ namespace lab{
     LAB_constexpr Matrix<F, 4, 4> ViewRotation(lab::Vector<F, 3> const position, lab::Vector<F, 3> const rotation){
         lab::mat4 view{};
         
-        const F c3 = lab::Cos(rotation.z);
-        const F s3 = lab::Sin(rotation.z);
-        const F c2 = lab::Cos(rotation.x);
-        const F s2 = lab::Sin(rotation.x);
-        const F c1 = lab::Cos(rotation.y);
-        const F s1 = lab::Sin(rotation.y);
+        const auto [s3, c3] = lab::SinCos(rotation.z);
+        const auto [s2, c2] = lab::SinCos(rotation.x);
+        const auto [s1, c1] = lab::SinCos(rotation.y);
     
         const F fx = (c2 * s1);
         const F fy = (-s2);
@@ -249,12 +251,9 @@ namespace lab{
     template<typename CS, std::floating_point F>
     requires(IsCoordinateSystem<CS>::value)
     LAB_constexpr void ViewRotation(Matrix<F, 4, 4>& view, lab::Vector<F, 3> const position, lab::Vector<F, 3> const rotation) {
-        const F c3 = lab::Cos(rotation.z);
-        const F s3 = lab::Sin(rotation.z);
-        const F c2 = lab::Cos(rotation.x);
-        const F s2 = lab::Sin(rotation.x);
-        const F c1 = lab::Cos(rotation.y);
-        const F s1 = lab::Sin(rotation.y);
+        const auto [s3, c3] = lab::SinCos(rotation.z);
+        const auto [s2, c2] = lab::SinCos(rotation.x);
+        const auto [s1, c1] = lab::SinCos(rotation.y);
     
         const F fx = (c2 * s1);
         const F fy = (-s2);
@@ -122,12 +122,9 @@ namespace lab {
         Matrix<F, 4, 4> ViewRotation(CoordinateSystem const csR, lab::Vector<F, 3> const position, lab::Vector<F, 3> const rotation){
             lab::mat4 view{};
             
-            const F c3 = lab::Cos(rotation.z);
-            const F s3 = lab::Sin(rotation.z);
-            const F c2 = lab::Cos(rotation.x);
-            const F s2 = lab::Sin(rotation.x);
-            const F c1 = lab::Cos(rotation.y);
-            const F s1 = lab::Sin(rotation.y);
+            const auto [s3, c3] = lab::SinCos(rotation.z);
+            const auto [s2, c2] = lab::SinCos(rotation.x);
+            const auto [s1, c1] = lab::SinCos(rotation.y);
         
             const F fx = (c2 * s1);
             const F fy = (-s2);
@@ -174,21 +171,18 @@ namespace lab {
                 view.columns[3][csR.r_axis] = -(rx * position.x + ry * position.y + rz * position.z);
             }
 
-            view.columns[0].component.w = F(0);
-            view.columns[1].component.w = F(0);
-            view.columns[2].component.w = F(0);
-            view.columns[3].component.w = F(1);
+            view.columns[0][3] = F(0);
+            view.columns[1][3] = F(0);
+            view.columns[2][3] = F(0);
+            view.columns[3][3] = F(1);
             return view;
         }
 
         template<std::floating_point F>
         void ViewRotation(CoordinateSystem const csR, Matrix<F, 4, 4>& view, lab::Vector<F, 3> const position, lab::Vector<F, 3> const rotation) {
-            const F c3 = lab::Cos(rotation.z);
-            const F s3 = lab::Sin(rotation.z);
-            const F c2 = lab::Cos(rotation.x);
-            const F s2 = lab::Sin(rotation.x);
-            const F c1 = lab::Cos(rotation.y);
-            const F s1 = lab::Sin(rotation.y);
+            const auto [s3, c3] = lab::SinCos(rotation.z);
+            const auto [s2, c2] = lab::SinCos(rotation.x);
+            const auto [s1, c1] = lab::SinCos(rotation.y);
         
             const F fx = (c2 * s1);
             const F fy = (-s2);
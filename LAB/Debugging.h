@@ -30,6 +30,12 @@ namespace lab {
 		#define LAB_UNREACHABLE	__builtin_unreachable();
 	#endif
 #endif
+
+#if defined(_MSC_VER) && !defined(__clang__) // MSVC
+	#define LAB_NOINLINE __declspec(noinline)
+#else // GCC, Clang
+	#define LAB_NOINLINE __attribute__((noinline))
+#endif
 }
 
 #if LAB_DEBUG_LEVEL < LAB_DEBUG_FLOAT_ANOMALIES
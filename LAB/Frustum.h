@@ -0,0 +1,268 @@
+#pragma once
+#include "Matrix.h"
+#include "CoordinateSystems.h"
+#include "Support/Trig.h"
+#include "Support/SIMD.h"
+#include "Support/Bitmask.h"
+#include "Vector/VectorSoA.h"
+#include "Bounding/Sphere.h"
+#include "Debugging.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+//view frustum as 6 planes, for culling bounds against a camera
+//a plane is (normal, d) with the normal pointing into the frustum, a point p is inside when normal.Dot(p) + d >= 0
+//the tests are conservative, something near a corner can pass every plane and still be outside. nothing visible is ever culled
+
+namespace lab {
+    //clip space depth range of the projection a frustum is extracted from
+    enum class DepthRange : uint8_t {
+        //DirectX, Vulkan, Metal. ProjectionMatrix in Camera.h writes this one
+        ZeroToOne,
+        //OpenGL. OrthographicMatrix in Camera.h writes this one
+        NegativeOneToOne
+    };
+
+    template<std::floating_point F>
+    struct Frustum {
+        enum Plane : uint8_t {
+            Left,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+            PlaneCount
+        };
+        Vector<F, 4> planes[PlaneCount];
+
+        //Gribb/Hartmann extraction, each plane is a sum or difference of two rows of the matrix
+        //works for perspective and orthographic, and the planes come out in the space the matrix transforms from
+        //(world space for view * projection). a reversed z projection swaps which plane is Near and which is Far, culling is unaffected
+        static LAB_constexpr Frustum FromMatrix(Matrix<F, 4, 4> const& viewProjection, DepthRange const depthRange = DepthRange::ZeroToOne) {
+            Vector<F, 4> rows[4];
+            for (uint8_t row = 0; row < 4; row++) {
+                rows[row] = Vector<F, 4>{viewProjection.At(0, row), viewProjection.At(1, row), viewProjection.At(2, row), viewProjection.At(3, row)};
+            }
+            Frustum ret;
+            ret.planes[Left] = rows[3] + rows[0];
+            ret.planes[Right] = rows[3] - rows[0];
+            ret.planes[Bottom] = rows[3] + rows[1];
+            ret.planes[Top] = rows[3] - rows[1];
+            ret.planes[Near] = (depthRange == DepthRange::ZeroToOne) ? rows[2] : rows[3] + rows[2];
+            ret.planes[Far] = rows[3] - rows[2];
+            for (uint8_t plane = 0; plane < PlaneCount; plane++) {
+                ret.planes[plane] = NormalizePlane(ret.planes[plane]);
+            }
+            return ret;
+        }
+
+        //built straight from the camera, no matrix involved. forward is expected to be normalized, field of view is vertical
+        //gives the planes of FromMatrix(ProjectionMatrix * ViewDirection<CS>) with the same arguments. right and up are built like ViewDirection builds them,
+        //then CS decides which of forward, right and up land on view x, y and z, and ProjectionMatrix reads those as horizontal, vertical and depth
+        template<typename CS>
+        requires(IsCoordinateSystem<CS>::value)
+        static LAB_constexpr Frustum FromCamera(Vector<F, 3> const position, Vector<F, 3> const forward, F const field_of_view_radians, F const aspectRatio,
+            F const close_distance, F const far_distance, Vector<F, 3> const upDir = CS::unitUpVector
+        ) {
+#ifdef LAB_LEFT_HANDED
+            const Vector<F, 3> right = Cross(upDir, forward).Normalized();
+            const Vector<F, 3> up = Cross(forward, right).Normalized();
+#else
+            const Vector<F, 3> right = Cross(forward, upDir).Normalized();
+            const Vector<F, 3> up = Cross(right, forward).Normalized();
+#endif
+            Vector<F, 3> viewAxes[3];
+            viewAxes[CS::f_axis] = CS::f_sign ? -forward : forward;
+            viewAxes[CS::r_axis] = CS::r_sign ? -right : right;
+            viewAxes[CS::u_axis] = CS::u_sign ? -up : up;
+            const Vector<F, 3> horizontal = viewAxes[0];
+            const Vector<F, 3> vertical = viewAxes[1];
+            const Vector<F, 3> depth = viewAxes[2];
+
+            const auto [sine, cosine] = SinCos(field_of_view_radians * F(0.5));
+            const F halfHeight = sine / cosine;
+            const F halfWidth = halfHeight * aspectRatio;
+
+            //each side plane holds the camera position, its normal leans toward depth by the half extent of that side
+            const Vector<F, 3> normals[4] = {
+                horizontal + depth * halfWidth,
+                depth * halfWidth - horizontal,
+                vertical + depth * halfHeight,
+                depth * halfHeight - vertical
+            };
+            Frustum ret;
+            for (uint8_t plane = 0; plane < 4; plane++) {
+                const Vector<F, 3> normal = normals[plane].Normalized();
+                ret.planes[plane] = Vector<F, 4>{normal.x, normal.y, normal.z, -normal.Dot(position)};
+            }
+            const F depthDistance = depth.Dot(position);
+            ret.planes[Near] = Vector<F, 4>{depth.x, depth.y, depth.z, -(depthDistance + close_distance)};
+            ret.planes[Far] = Vector<F, 4>{-depth.x, -depth.y, -depth.z, depthDistance + far_distance};
+            return ret;
+        }
+
+        //signed distance, positive inside
+        LAB_constexpr F Distance(uint8_t const plane, Vector<F, 3> const point) const {
+#if LAB_DEBUGGING_ACCESS
+            assert(plane < PlaneCount);
+#endif
+            Vector<F, 4> const& p = planes[plane];
+            return ((p.x * point.x + p.y * point.y) + p.z * point.z) + p.w;
+        }
+
+        LAB_constexpr bool ContainsPoint(Vector<F, 3> const point) const {
+            for (uint8_t plane = 0; plane < PlaneCount; plane++) {
+                if (Distance(plane, point) < F(0)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        LAB_constexpr bool IntersectsSphere(Vector<F, 3> const center, F const radius) const {
+            for (uint8_t plane = 0; plane < PlaneCount; plane++) {
+                if (Distance(plane, center) < -radius) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        LAB_constexpr bool IntersectsSphere(Sphere<F> const& sphere) const {
+            return IntersectsSphere(sphere.center, sphere.radius);
+        }
+        //tests the corner furthest along each plane normal
+        LAB_constexpr bool IntersectsAABB(Vector<F, 3> const min, Vector<F, 3> const max) const {
+            for (uint8_t plane = 0; plane < PlaneCount; plane++) {
+                Vector<F, 4> const& p = planes[plane];
+                const Vector<F, 3> corner{
+                    p.x >= F(0) ? max.x : min.x,
+                    p.y >= F(0) ? max.y : min.y,
+                    p.z >= F(0) ? max.z : min.z
+                };
+                if (Distance(plane, corner) < F(0)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        LAB_constexpr bool IntersectsAABB(AABB<F> const& box) const {
+            return IntersectsAABB(box.min, box.max);
+        }
+
+    private:
+        static LAB_constexpr Vector<F, 4> NormalizePlane(Vector<F, 4> const plane) {
+            const F invMag = F(1) / Sqrt((plane.x * plane.x + plane.y * plane.y) + plane.z * plane.z);
+            return Vector<F, 4>{plane.x * invMag, plane.y * invMag, plane.z * invMag, plane.w * invMag};
+        }
+    };
+
+#ifdef USING_SIMD
+    namespace detail {
+        //the planes broadcast once per batch instead of once per block of objects
+        struct FrustumLanes {
+            SIMD::Float normals[Frustum<float>::PlaneCount][3];
+            SIMD::Float distances[Frustum<float>::PlaneCount];
+            //the aabb corner pick depends only on the plane normal, so it becomes a choice of stream made once per batch
+            bool pickMax[Frustum<float>::PlaneCount][3];
+
+            explicit FrustumLanes(Frustum<float> const& frustum) {
+                for (uint8_t plane = 0; plane < Frustum<float>::PlaneCount; plane++) {
+                    for (uint8_t c = 0; c < 3; c++) {
+                        normals[plane][c] = SIMD::Set1(frustum.planes[plane][c]);
+                        pickMax[plane][c] = frustum.planes[plane][c] >= 0.f;
+                    }
+                    distances[plane] = SIMD::Set1(frustum.planes[plane].w);
+                }
+            }
+        };
+
+        //the plane test the scalar members do, for FloatWidth objects. returns a lane mask of the objects that are outside any plane
+        template<bool Spheres>
+        inline SIMD::Float FrustumOutsideLanes(FrustumLanes const& lanes, SIMD::Float const (&lower)[3], SIMD::Float const (&upper)[3], SIMD::Float const radius) {
+            const SIMD::Float zero = SIMD::Set1(0.f);
+            SIMD::Float outside = zero;
+            for (uint8_t plane = 0; plane < Frustum<float>::PlaneCount; plane++) {
+                SIMD::Float corner[3];
+                for (uint8_t c = 0; c < 3; c++) {
+                    corner[c] = (Spheres || !lanes.pickMax[plane][c]) ? lower[c] : upper[c];
+                }
+                SIMD::Float const (&normal)[3] = lanes.normals[plane];
+                const SIMD::Float distance = SIMD::Add(SIMD::Add(SIMD::Add(SIMD::Mul(normal[0], corner[0]), SIMD::Mul(normal[1], corner[1])), SIMD::Mul(normal[2], corner[2])), lanes.distances[plane]);
+                if constexpr (Spheres) {
+                    outside = SIMD::Or(outside, SIMD::Less(distance, SIMD::Sub(zero, radius)));
+                }
+                else {
+                    outside = SIMD::Or(outside, SIMD::Less(distance, zero));
+                }
+            }
+            return outside;
+        }
+    }
+#endif
+
+    //bit i % 64 of visibility[i / 64] is set when sphere i is at least partly inside. xyz is the center, w the radius
+    //visibility needs BitmaskWordCount(spheres.Size()) words, every one of them is overwritten
+    template<std::floating_point F>
+    LAB_constexpr void CullSpheres(Frustum<F> const& frustum, VectorSoA<F, 4> const& spheres, std::span<uint64_t> const visibility) {
+        const std::size_t count = spheres.Size();
+        detail::ClearBitmask(visibility, count);
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                constexpr int laneBits = (1 << SIMD::FloatWidth) - 1;
+                const detail::FrustumLanes lanes{frustum};
+                for (std::size_t i = 0; i < count; i += SIMD::FloatWidth) {
+                    const SIMD::Float center[3] = {SIMD::Load(spheres.X() + i), SIMD::Load(spheres.Y() + i), SIMD::Load(spheres.Z() + i)};
+                    const SIMD::Float outside = detail::FrustumOutsideLanes<true>(lanes, center, center, SIMD::Load(spheres.W() + i));
+                    const uint64_t visible = static_cast<uint64_t>(~SIMD::MoveMask(outside) & laneBits);
+                    visibility[i / 64] |= visible << (i % 64);
+                }
+                detail::MaskBitmaskTail(visibility, count);
+                return;
+            }
+        }
+#endif
+        for (std::size_t i = 0; i < count; i++) {
+            const Vector<F, 4> sphere = spheres.Get(i);
+            if (frustum.IntersectsSphere(Vector<F, 3>{sphere.x, sphere.y, sphere.z}, sphere.w)) {
+                visibility[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+
+    //bit i % 64 of visibility[i / 64] is set when box i is at least partly inside. mins and maxs are the corners of each box
+    //visibility needs BitmaskWordCount(mins.Size()) words, every one of them is overwritten
+    template<std::floating_point F>
+    LAB_constexpr void CullAABBs(Frustum<F> const& frustum, VectorSoA<F, 3> const& mins, VectorSoA<F, 3> const& maxs, std::span<uint64_t> const visibility) {
+#if LAB_DEBUGGING_ACCESS
+        assert(mins.Size() == maxs.Size());
+#endif
+        const std::size_t count = mins.Size();
+        detail::ClearBitmask(visibility, count);
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                constexpr int laneBits = (1 << SIMD::FloatWidth) - 1;
+                const detail::FrustumLanes lanes{frustum};
+                for (std::size_t i = 0; i < count; i += SIMD::FloatWidth) {
+                    const SIMD::Float lower[3] = {SIMD::Load(mins.X() + i), SIMD::Load(mins.Y() + i), SIMD::Load(mins.Z() + i)};
+                    const SIMD::Float upper[3] = {SIMD::Load(maxs.X() + i), SIMD::Load(maxs.Y() + i), SIMD::Load(maxs.Z() + i)};
+                    const SIMD::Float outside = detail::FrustumOutsideLanes<false>(lanes, lower, upper, SIMD::Set1(0.f));
+                    const uint64_t visible = static_cast<uint64_t>(~SIMD::MoveMask(outside) & laneBits);
+                    visibility[i / 64] |= visible << (i % 64);
+                }
+                detail::MaskBitmaskTail(visibility, count);
+                return;
+            }
+        }
+#endif
+        for (std::size_t i = 0; i < count; i++) {
+            if (frustum.IntersectsAABB(mins.Get(i), maxs.Get(i))) {
+                visibility[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "Geometry/Ray.h"
+#include "Geometry/TriangleSoA.h"
+#include "Geometry/BVH.h"
+#include "Geometry/SpatialHashGrid.h"
+#include "Geometry/Weld.h"
@@ -0,0 +1,464 @@
+#pragma once
+#include "Ray.h"
+#include "../Bounding/AABB.h"
+#include "../Support/SIMD.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+//bounding volume hierarchy over a triangle mesh, built with binned SAH (Wald, "On fast Construction of SAH-based Bounding Volume Hierarchies")
+//a node holds the boxes of both of its children, so one node load decides which children a ray enters
+//the batched Intersect runs packets of SIMD::FloatWidth rays through the tree together, with the slab tests and Moller-Trumbore done across the rays
+//a packet returns the same hits as its rays one at a time, except which triangle wins when two are hit at exactly the same distance
+
+namespace lab {
+    namespace detail {
+        //1 / direction without the division by zero, which isn't allowed in constant evaluation
+        //big enough to act as infinity, small enough that the slab distances don't overflow (also not allowed) for any sane coordinates
+        template<std::floating_point F>
+        LAB_constexpr F SlabInverse(F const direction) {
+            return (direction != F(0)) ? F(1) / direction : F(1e30);
+        }
+
+        //where the ray enters the box, if it does before maxDistance
+        template<std::floating_point F>
+        LAB_constexpr bool RaySlab(AABB<F> const& box, Vector<F, 3> const origin, Vector<F, 3> const inverseDirection, F const maxDistance, F& entry) {
+            F near = F(0);
+            F far = maxDistance;
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                const F t0 = (box.min[axis] - origin[axis]) * inverseDirection[axis];
+                const F t1 = (box.max[axis] - origin[axis]) * inverseDirection[axis];
+                near = BoundsMax(near, BoundsMin(t0, t1));
+                far = BoundsMin(far, BoundsMax(t0, t1));
+            }
+            entry = near;
+            return near <= far;
+        }
+    }
+
+    template<std::floating_point F>
+    struct BVH {
+        //64 bytes for float, a cache line
+        struct alignas(64) Node {
+            AABB<F> bounds[2];
+            //an interior child is the index of its node, a leaf child is LeafFlag | its first triangle
+            uint32_t child[2];
+            //triangles in a leaf child, 0 for an interior child
+            uint32_t count[2];
+        };
+        static constexpr uint32_t LeafFlag = 0x80000000u;
+        static constexpr uint8_t BinCount = 16;
+        static constexpr uint32_t MaxLeafTriangles = 8;
+        //SAH cost of visiting a node, relative to testing one triangle
+        static constexpr F TraversalCost = F(1);
+        //size of the traversal stack, the builder stops splitting at this depth
+        static constexpr uint8_t MaxDepth = 64;
+
+        //nodes[0] holds the root's children
+        std::vector<Node> nodes;
+        //v0, edge1 and edge2 of every triangle, in leaf order
+        std::vector<Vector<F, 3>> triangles;
+        //the index each triangle had in the input, RayHit::triangle reports this one
+        std::vector<uint32_t> triangleIndices;
+        AABB<F> bounds = AABB<F>::Empty();
+
+        //every 3 vertices are a triangle
+        static LAB_constexpr BVH Build(std::span<const Vector<F, 3>> const vertices) {
+#if LAB_DEBUGGING_ACCESS
+            assert(vertices.size() % 3 == 0);
+#endif
+            return BuildTriangles(static_cast<uint32_t>(vertices.size() / 3), [&](uint32_t const triangle, uint8_t const corner) {
+                return vertices[triangle * 3 + corner];
+            });
+        }
+        //every 3 indices are a triangle
+        static LAB_constexpr BVH Build(std::span<const Vector<F, 3>> const vertices, std::span<const uint32_t> const indices) {
+#if LAB_DEBUGGING_ACCESS
+            assert(indices.size() % 3 == 0);
+#endif
+            return BuildTriangles(static_cast<uint32_t>(indices.size() / 3), [&](uint32_t const triangle, uint8_t const corner) {
+                return vertices[indices[triangle * 3 + corner]];
+            });
+        }
+
+        LAB_constexpr std::size_t TriangleCount() const {
+            return triangleIndices.size();
+        }
+
+        //closest hit nearer than hit.distance, hit is only written when there is one
+        LAB_constexpr bool Intersect(Ray<F> const& ray, RayHit<F>& hit) const {
+            return Traverse<false>(ray, hit);
+        }
+        //any hit nearer than maxDistance, for line of sight. stops at the first one found
+        LAB_constexpr bool Occluded(Ray<F> const& ray, F const maxDistance) const {
+            RayHit<F> hit;
+            hit.distance = maxDistance;
+            return Traverse<true>(ray, hit);
+        }
+
+        //hits[i] is the closest hit of rays[i], with the same in/out meaning as the single ray Intersect
+        LAB_constexpr void Intersect(std::span<const Ray<F>> const rays, std::span<RayHit<F>> const hits) const {
+#if LAB_DEBUGGING_ACCESS
+            assert(hits.size() >= rays.size());
+#endif
+#ifdef USING_SIMD
+            if !consteval {
+                if constexpr (std::is_same_v<F, float>) {
+                    if (nodes.empty()) {
+                        return;
+                    }
+                    for (std::size_t i = 0; i < rays.size(); i += SIMD::FloatWidth) {
+                        const std::size_t packetSize = std::min(SIMD::FloatWidth, rays.size() - i);
+                        IntersectPacket(rays.subspan(i, packetSize), hits.subspan(i, packetSize));
+                    }
+                    return;
+                }
+            }
+#endif
+            for (std::size_t i = 0; i < rays.size(); i++) {
+                Intersect(rays[i], hits[i]);
+            }
+        }
+
+    private:
+        struct BuildScratch {
+            std::vector<AABB<F>> boxes;
+            std::vector<Vector<F, 3>> centroids;
+            //triangle indices, partitioned in place as the tree is built
+            std::vector<uint32_t> order;
+        };
+
+        template<typename GetVertex>
+        static LAB_constexpr BVH BuildTriangles(uint32_t const triangleCount, GetVertex const& getVertex) {
+            BVH ret;
+            if (triangleCount == 0) {
+                return ret;
+            }
+            BuildScratch scratch;
+            scratch.boxes.resize(triangleCount);
+            scratch.centroids.resize(triangleCount);
+            scratch.order.resize(triangleCount);
+            for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+                const AABB<F> box = AABB<F>{getVertex(triangle, 0), getVertex(triangle, 0)}.Merge(getVertex(triangle, 1)).Merge(getVertex(triangle, 2));
+                scratch.boxes[triangle] = box;
+                scratch.centroids[triangle] = box.GetCenter();
+                scratch.order[triangle] = triangle;
+            }
+
+            ret.bounds = RangeBounds(scratch, 0, triangleCount);
+            ret.nodes.push_back(Node{});
+            if (triangleCount == 1) {
+                //the second child is an empty leaf
+                Node& root = ret.nodes[0];
+                root.bounds[0] = ret.bounds;
+                root.bounds[1] = ret.bounds;
+                root.child[0] = LeafFlag;
+                root.child[1] = LeafFlag;
+                root.count[0] = 1;
+                root.count[1] = 0;
+            }
+            else {
+                const uint32_t mid = Partition(scratch, 0, triangleCount, ret.bounds, false);
+                ret.MakeChild(scratch, 0, 0, 0, mid, 1);
+                ret.MakeChild(scratch, 0, 1, mid, triangleCount, 1);
+            }
+
+            ret.triangles.reserve(triangleCount * 3);
+            ret.triangleIndices = scratch.order;
+            for (uint32_t const triangle : scratch.order) {
+                const Vector<F, 3> v0 = getVertex(triangle, 0);
+                ret.triangles.push_back(v0);
+                ret.triangles.push_back(getVertex(triangle, 1) - v0);
+                ret.triangles.push_back(getVertex(triangle, 2) - v0);
+            }
+            return ret;
+        }
+
+        static LAB_constexpr AABB<F> RangeBounds(BuildScratch const& scratch, uint32_t const begin, uint32_t const end) {
+            AABB<F> ret = AABB<F>::Empty();
+            for (uint32_t i = begin; i < end; i++) {
+                ret = ret.Merge(scratch.boxes[scratch.order[i]]);
+            }
+            return ret;
+        }
+
+        static LAB_constexpr uint8_t BinOf(F const centroid, F const binMin, F const binScale) {
+            const F bin = (centroid - binMin) * binScale;
+            return (bin < F(BinCount - 1)) ? static_cast<uint8_t>(bin) : static_cast<uint8_t>(BinCount - 1);
+        }
+
+        //splits [begin, end) along the cheapest SAH bin boundary and returns where the right side starts
+        //returns begin when a leaf is allowed and cheaper than any split
+        static LAB_constexpr uint32_t Partition(BuildScratch& scratch, uint32_t const begin, uint32_t const end, AABB<F> const& box, bool const allowLeaf) {
+            const uint32_t count = end - begin;
+            AABB<F> centroidBounds = AABB<F>::Empty();
+            for (uint32_t i = begin; i < end; i++) {
+                centroidBounds = centroidBounds.Merge(scratch.centroids[scratch.order[i]]);
+            }
+
+            F bestCost = std::numeric_limits<F>::max();
+            uint8_t bestAxis = 0;
+            uint8_t bestSplit = 0;
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                const F extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+                if (!(extent > F(0))) {
+                    continue;
+                }
+                const F binScale = F(BinCount) / extent;
+                uint32_t binCounts[BinCount] = {};
+                AABB<F> binBoxes[BinCount];
+                for (uint8_t bin = 0; bin < BinCount; bin++) {
+                    binBoxes[bin] = AABB<F>::Empty();
+                }
+                for (uint32_t i = begin; i < end; i++) {
+                    const uint32_t triangle = scratch.order[i];
+                    const uint8_t bin = BinOf(scratch.centroids[triangle][axis], centroidBounds.min[axis], binScale);
+                    binCounts[bin]++;
+                    binBoxes[bin] = binBoxes[bin].Merge(scratch.boxes[triangle]);
+                }
+
+                //leftCost[split] covers bins [0, split), the right side is accumulated in the second sweep
+                F leftCost[BinCount] = {};
+                AABB<F> leftBox = AABB<F>::Empty();
+                uint32_t leftCount = 0;
+                for (uint8_t split = 1; split < BinCount; split++) {
+                    leftBox = leftBox.Merge(binBoxes[split - 1]);
+                    leftCount += binCounts[split - 1];
+                    leftCost[split] = (leftCount == 0) ? F(0) : F(leftCount) * leftBox.SurfaceArea();
+                }
+                AABB<F> rightBox = AABB<F>::Empty();
+                uint32_t rightCount = 0;
+                for (uint8_t split = BinCount - 1; split > 0; split--) {
+                    rightBox = rightBox.Merge(binBoxes[split]);
+                    rightCount += binCounts[split];
+                    if (rightCount == 0 || rightCount == count) {
+                        continue;
+                    }
+                    const F cost = leftCost[split] + F(rightCount) * rightBox.SurfaceArea();
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = split;
+                    }
+                }
+            }
+
+            if (bestSplit == 0) {
+                //every centroid is in the same spot, no boundary separates them
+                return allowLeaf ? begin : begin + count / 2;
+            }
+            const F area = box.SurfaceArea();
+            if (allowLeaf && (area > F(0)) && (F(count) <= TraversalCost + bestCost / area)) {
+                return begin;
+            }
+            const F binMin = centroidBounds.min[bestAxis];
+            const F binScale = F(BinCount) / (centroidBounds.max[bestAxis] - binMin);
+            uint32_t* const first = scratch.order.data() + begin;
+            uint32_t* const mid = std::partition(first, scratch.order.data() + end, [&](uint32_t const triangle) {
+                return BinOf(scratch.centroids[triangle][bestAxis], binMin, binScale) < bestSplit;
+            });
+            return begin + static_cast<uint32_t>(mid - first);
+        }
+
+        LAB_constexpr void MakeChild(BuildScratch& scratch, uint32_t const node, uint8_t const slot, uint32_t const begin, uint32_t const end, uint8_t const depth) {
+            const AABB<F> box = RangeBounds(scratch, begin, end);
+            nodes[node].bounds[slot] = box;
+            const uint32_t count = end - begin;
+            uint32_t mid = begin;
+            if ((count > 1) && (depth + 1 < MaxDepth)) {
+                mid = Partition(scratch, begin, end, box, count <= MaxLeafTriangles);
+            }
+            if (mid == begin) {
+                nodes[node].child[slot] = LeafFlag | begin;
+                nodes[node].count[slot] = count;
+                return;
+            }
+            const uint32_t child = static_cast<uint32_t>(nodes.size());
+            nodes.push_back(Node{});
+            nodes[node].child[slot] = child;
+            nodes[node].count[slot] = 0;
+            MakeChild(scratch, child, 0, begin, mid, depth + 1);
+            MakeChild(scratch, child, 1, mid, end, depth + 1);
+        }
+
+        template<bool AnyHit>
+        LAB_constexpr bool Traverse(Ray<F> const& ray, RayHit<F>& hit) const {
+            if (nodes.empty()) {
+                return false;
+            }
+            const Vector<F, 3> inverseDirection{detail::SlabInverse(ray.direction.x), detail::SlabInverse(ray.direction.y), detail::SlabInverse(ray.direction.z)};
+            uint32_t stack[MaxDepth];
+            uint8_t stackSize = 0;
+            uint32_t node = 0;
+            bool found = false;
+            while (true) {
+                Node const& current = nodes[node];
+                F entry[2];
+                const bool enter[2] = {
+                    detail::RaySlab(current.bounds[0], ray.origin, inverseDirection, hit.distance, entry[0]),
+                    detail::RaySlab(current.bounds[1], ray.origin, inverseDirection, hit.distance, entry[1])
+                };
+                //nearer child first
+                const uint8_t first = (enter[0] && enter[1] && entry[1] < entry[0]) ? 1 : 0;
+                uint32_t next[2];
+                uint8_t nextCount = 0;
+                for (uint8_t k = 0; k < 2; k++) {
+                    const uint8_t slot = first ^ k;
+                    if (!enter[slot]) {
+                        continue;
+                    }
+                    if (current.child[slot] & LeafFlag) {
+                        const uint32_t begin = current.child[slot] & ~LeafFlag;
+                        for (uint32_t i = begin; i < begin + current.count[slot]; i++) {
+                            if (detail::IntersectTriangleEdges(ray, triangles[i * 3], triangles[i * 3 + 1], triangles[i * 3 + 2], triangleIndices[i], hit)) {
+                                found = true;
+                                if constexpr (AnyHit) {
+                                    return true;
+                                }
+                            }
+                        }
+                    }
+                    else {
+                        next[nextCount++] = current.child[slot];
+                    }
+                }
+                if (nextCount == 0) {
+                    if (stackSize == 0) {
+                        return found;
+                    }
+                    node = stack[--stackSize];
+                    continue;
+                }
+                node = next[0];
+                if (nextCount == 2) {
+                    stack[stackSize++] = next[1];
+                }
+            }
+        }
+
+#ifdef USING_SIMD
+        //one ray per lane. the lanes past rays.size() get a negative max distance, which no box or triangle passes
+        void IntersectPacket(std::span<const Ray<float>> const rays, std::span<RayHit<float>> const hits) const requires(std::is_same_v<F, float>) {
+            alignas(SIMD::Alignment) float lanes[12][SIMD::FloatWidth];
+            alignas(SIMD::Alignment) int32_t laneTriangles[SIMD::FloatWidth];
+            for (std::size_t lane = 0; lane < SIMD::FloatWidth; lane++) {
+                const bool used = lane < rays.size();
+                Ray<float> const& ray = rays[used ? lane : 0];
+                for (uint8_t axis = 0; axis < 3; axis++) {
+                    lanes[axis][lane] = ray.origin[axis];
+                    lanes[3 + axis][lane] = ray.direction[axis];
+                    lanes[6 + axis][lane] = detail::SlabInverse(ray.direction[axis]);
+                }
+                RayHit<float> const& hit = hits[used ? lane : 0];
+                lanes[9][lane] = used ? hit.distance : -1.f;
+                lanes[10][lane] = hit.u;
+                lanes[11][lane] = hit.v;
+                laneTriangles[lane] = static_cast<int32_t>(hit.triangle);
+            }
+            SIMD::Float origin[3];
+            SIMD::Float direction[3];
+            SIMD::Float inverseDirection[3];
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                origin[axis] = SIMD::Load(lanes[axis]);
+                direction[axis] = SIMD::Load(lanes[3 + axis]);
+                inverseDirection[axis] = SIMD::Load(lanes[6 + axis]);
+            }
+            SIMD::Float distance = SIMD::Load(lanes[9]);
+            SIMD::Float hitU = SIMD::Load(lanes[10]);
+            SIMD::Float hitV = SIMD::Load(lanes[11]);
+            SIMD::Float hitTriangle = SIMD::Load(reinterpret_cast<float const*>(laneTriangles));
+
+            const SIMD::Float zero = SIMD::Set1(0.f);
+
+            uint32_t stack[MaxDepth];
+            uint8_t stackSize = 0;
+            uint32_t node = 0;
+            while (true) {
+                Node const& current = nodes[node];
+                int enterMask[2];
+                alignas(SIMD::Alignment) float entry[2][SIMD::FloatWidth];
+                for (uint8_t slot = 0; slot < 2; slot++) {
+                    AABB<float> const& box = current.bounds[slot];
+                    SIMD::Float near = zero;
+                    SIMD::Float far = distance;
+                    for (uint8_t axis = 0; axis < 3; axis++) {
+                        const SIMD::Float t0 = SIMD::Mul(SIMD::Sub(SIMD::Set1(box.min[axis]), origin[axis]), inverseDirection[axis]);
+                        const SIMD::Float t1 = SIMD::Mul(SIMD::Sub(SIMD::Set1(box.max[axis]), origin[axis]), inverseDirection[axis]);
+                        near = SIMD::Max(near, SIMD::Min(t0, t1));
+                        far = SIMD::Min(far, SIMD::Max(t0, t1));
+                    }
+                    enterMask[slot] = SIMD::MoveMask(SIMD::LessEqual(near, far));
+                    SIMD::Store(entry[slot], near);
+                }
+                //nearer child first, judged by the first ray that enters both
+                uint8_t first = 0;
+                const int both = enterMask[0] & enterMask[1];
+                if (both != 0) {
+                    const int lane = std::countr_zero(static_cast<unsigned>(both));
+                    first = (entry[1][lane] < entry[0][lane]) ? 1 : 0;
+                }
+                uint32_t next[2];
+                uint8_t nextCount = 0;
+                for (uint8_t k = 0; k < 2; k++) {
+                    const uint8_t slot = first ^ k;
+                    if (enterMask[slot] == 0) {
+                        continue;
+                    }
+                    if (!(current.child[slot] & LeafFlag)) {
+                        next[nextCount++] = current.child[slot];
+                        continue;
+                    }
+                    const uint32_t begin = current.child[slot] & ~LeafFlag;
+                    for (uint32_t i = begin; i < begin + current.count[slot]; i++) {
+                        Vector<float, 3> const& v0 = triangles[i * 3];
+                        Vector<float, 3> const& edge1 = triangles[i * 3 + 1];
+                        Vector<float, 3> const& edge2 = triangles[i * 3 + 2];
+                        const SIMD::Float v0Lanes[3] = {SIMD::Set1(v0.x), SIMD::Set1(v0.y), SIMD::Set1(v0.z)};
+                        const SIMD::Float edge1Lanes[3] = {SIMD::Set1(edge1.x), SIMD::Set1(edge1.y), SIMD::Set1(edge1.z)};
+                        const SIMD::Float edge2Lanes[3] = {SIMD::Set1(edge2.x), SIMD::Set1(edge2.y), SIMD::Set1(edge2.z)};
+                        SIMD::Float t;
+                        SIMD::Float u;
+                        SIMD::Float v;
+                        const SIMD::Float valid = detail::IntersectTriangleLanes(origin, direction, v0Lanes, edge1Lanes, edge2Lanes, distance, t, u, v);
+                        if (SIMD::MoveMask(valid) == 0) {
+                            continue;
+                        }
+                        distance = SIMD::Select(valid, t, distance);
+                        hitU = SIMD::Select(valid, u, hitU);
+                        hitV = SIMD::Select(valid, v, hitV);
+                        hitTriangle = SIMD::Select(valid, SIMD::AsFloat(SIMD::Set1Int(static_cast<int32_t>(triangleIndices[i]))), hitTriangle);
+                    }
+                }
+                if (nextCount == 0) {
+                    if (stackSize == 0) {
+                        break;
+                    }
+                    node = stack[--stackSize];
+                    continue;
+                }
+                node = next[0];
+                if (nextCount == 2) {
+                    stack[stackSize++] = next[1];
+                }
+            }
+
+            SIMD::Store(lanes[9], distance);
+            SIMD::Store(lanes[10], hitU);
+            SIMD::Store(lanes[11], hitV);
+            SIMD::Store(reinterpret_cast<float*>(laneTriangles), hitTriangle);
+            for (std::size_t lane = 0; lane < rays.size(); lane++) {
+                hits[lane].distance = lanes[9][lane];
+                hits[lane].u = lanes[10][lane];
+                hits[lane].v = lanes[11][lane];
+                hits[lane].triangle = static_cast<uint32_t>(laneTriangles[lane]);
+            }
+        }
+#endif
+    };
+}
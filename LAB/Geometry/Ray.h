@@ -0,0 +1,117 @@
+#pragma once
+#include "../Vector.h"
+#include "../Support/Generic.h"
+#include "../Support/SIMD.h"
+
+#include <cstdint>
+#include <limits>
+
+namespace lab {
+    //the direction doesn't need to be normalized, hit distances are in multiples of it
+    template<std::floating_point F>
+    struct Ray {
+        Vector<F, 3> origin;
+        Vector<F, 3> direction;
+
+        LAB_constexpr Ray() : origin{F(0)}, direction{F(0), F(0), F(1)} {}
+        LAB_constexpr Ray(Vector<F, 3> const origin, Vector<F, 3> const direction) : origin{origin}, direction{direction} {}
+
+        LAB_constexpr Vector<F, 3> At(F const distance) const {
+            return origin + direction * distance;
+        }
+    };
+
+    //closest hit so far. the intersect functions only report hits closer than distance, so set it to limit the range of a query
+    template<std::floating_point F>
+    struct RayHit {
+        static constexpr uint32_t NoHit = UINT32_MAX;
+
+        F distance = std::numeric_limits<F>::max();
+        //barycentrics of the hit, the point is v0 * (1 - u - v) + v1 * u + v2 * v
+        F u = F(0);
+        F v = F(0);
+        uint32_t triangle = NoHit;
+
+        LAB_constexpr bool Hit() const {
+            return triangle != NoHit;
+        }
+    };
+
+    namespace detail {
+        //Moller-Trumbore with the edges precomputed, two sided. same epsilon and bounds as IntersectTri in HelperFunctions/DXFunctions.h
+        //IntersectTriangleLanes repeats these operations in this order, keep them in sync
+        //the tests are negated accept conditions so a NaN is rejected, the same way the SIMD lane masks reject it
+        template<std::floating_point F>
+        LAB_constexpr bool IntersectTriangleEdges(Ray<F> const& ray, Vector<F, 3> const v0, Vector<F, 3> const edge1, Vector<F, 3> const edge2,
+            uint32_t const triangle, RayHit<F>& hit
+        ) {
+            constexpr F epsilon = F(1e-6);
+            const Vector<F, 3> h = ray.direction.Cross(edge2);
+            const F a = edge1.Dot(h);
+            if (!(Abs(a) >= epsilon)) {
+                return false;
+            }
+            const F f = F(1) / a;
+            const Vector<F, 3> s = ray.origin - v0;
+            const F u = f * s.Dot(h);
+            if (!(u >= F(0) && u <= F(1))) {
+                return false;
+            }
+            const Vector<F, 3> q = s.Cross(edge1);
+            const F v = f * ray.direction.Dot(q);
+            if (!(v >= F(0) && u + v <= F(1))) {
+                return false;
+            }
+            const F t = f * edge2.Dot(q);
+            if (!(t > epsilon && t < hit.distance)) {
+                return false;
+            }
+            hit.distance = t;
+            hit.u = u;
+            hit.v = v;
+            hit.triangle = triangle;
+            return true;
+        }
+#ifdef USING_SIMD
+        //IntersectTriangleEdges across the lanes, each lane is its own ray and triangle, broadcast whichever side is shared
+        //returns the mask of lanes hit closer than maxDistance, t, u and v are only meaningful in those lanes
+        inline SIMD::Float IntersectTriangleLanes(SIMD::Float const origin[3], SIMD::Float const direction[3],
+            SIMD::Float const v0[3], SIMD::Float const edge1[3], SIMD::Float const edge2[3], SIMD::Float const maxDistance,
+            SIMD::Float& t, SIMD::Float& u, SIMD::Float& v
+        ) {
+            const SIMD::Float zero = SIMD::Set1(0.f);
+            const SIMD::Float one = SIMD::Set1(1.f);
+            const SIMD::Float epsilon = SIMD::Set1(1e-6f);
+            const SIMD::Float negativeEpsilon = SIMD::Set1(-1e-6f);
+
+            const SIMD::Float h[3] = {
+                SIMD::Sub(SIMD::Mul(direction[1], edge2[2]), SIMD::Mul(direction[2], edge2[1])),
+                SIMD::Sub(SIMD::Mul(direction[2], edge2[0]), SIMD::Mul(direction[0], edge2[2])),
+                SIMD::Sub(SIMD::Mul(direction[0], edge2[1]), SIMD::Mul(direction[1], edge2[0]))
+            };
+            const SIMD::Float a = SIMD::Add(SIMD::Add(SIMD::Mul(edge1[0], h[0]), SIMD::Mul(edge1[1], h[1])), SIMD::Mul(edge1[2], h[2]));
+            const SIMD::Float f = SIMD::Div(one, a);
+            const SIMD::Float s[3] = {SIMD::Sub(origin[0], v0[0]), SIMD::Sub(origin[1], v0[1]), SIMD::Sub(origin[2], v0[2])};
+            u = SIMD::Mul(f, SIMD::Add(SIMD::Add(SIMD::Mul(s[0], h[0]), SIMD::Mul(s[1], h[1])), SIMD::Mul(s[2], h[2])));
+            const SIMD::Float q[3] = {
+                SIMD::Sub(SIMD::Mul(s[1], edge1[2]), SIMD::Mul(s[2], edge1[1])),
+                SIMD::Sub(SIMD::Mul(s[2], edge1[0]), SIMD::Mul(s[0], edge1[2])),
+                SIMD::Sub(SIMD::Mul(s[0], edge1[1]), SIMD::Mul(s[1], edge1[0]))
+            };
+            v = SIMD::Mul(f, SIMD::Add(SIMD::Add(SIMD::Mul(direction[0], q[0]), SIMD::Mul(direction[1], q[1])), SIMD::Mul(direction[2], q[2])));
+            t = SIMD::Mul(f, SIMD::Add(SIMD::Add(SIMD::Mul(edge2[0], q[0]), SIMD::Mul(edge2[1], q[1])), SIMD::Mul(edge2[2], q[2])));
+
+            SIMD::Float valid = SIMD::Or(SIMD::LessEqual(epsilon, a), SIMD::LessEqual(a, negativeEpsilon));
+            valid = SIMD::And(valid, SIMD::And(SIMD::LessEqual(zero, u), SIMD::LessEqual(u, one)));
+            valid = SIMD::And(valid, SIMD::And(SIMD::LessEqual(zero, v), SIMD::LessEqual(SIMD::Add(u, v), one)));
+            return SIMD::And(valid, SIMD::And(SIMD::Less(epsilon, t), SIMD::Less(t, maxDistance)));
+        }
+#endif
+    }
+
+    //updates hit and returns true when the ray hits the triangle closer than hit.distance
+    template<std::floating_point F>
+    LAB_constexpr bool IntersectTriangle(Ray<F> const& ray, Vector<F, 3> const v0, Vector<F, 3> const v1, Vector<F, 3> const v2, uint32_t const triangle, RayHit<F>& hit) {
+        return detail::IntersectTriangleEdges(ray, v0, v1 - v0, v2 - v0, triangle, hit);
+    }
+}
@@ -0,0 +1,304 @@
+#pragma once
+#include "../Vector.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+//uniform grid over points, cellSize wide. only the occupied cells exist, they live in an open addressing (linear probing) table keyed by the cell
+//the points are counting sorted by cell, so a cell's points are one contiguous run of positions and indices and a query reads them front to back
+//meant to be refilled every frame for moving points, Clear keeps every allocation for the next Insert
+
+namespace lab {
+    namespace detail {
+        //Teschner et al., "Optimized Spatial Hashing for Collision Detection of Deformable Objects", then a Fibonacci multiply so the top bits are usable as the slot
+        template<uint8_t Dimensions>
+        LAB_constexpr uint32_t HashCell(IntVector<int32_t, Dimensions> const cell) {
+            constexpr uint32_t primes[4] = {73856093u, 19349663u, 83492791u, 50331653u};
+            uint32_t hash = 0;
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                hash ^= static_cast<uint32_t>(cell[dim]) * primes[dim];
+            }
+            return hash * 0x9E3779B9u;
+        }
+    }
+
+    template<std::floating_point F, uint8_t Dimensions>
+    requires((Dimensions > 1) && (Dimensions <= 4))
+    struct SpatialHashGrid {
+        using Cell = IntVector<int32_t, Dimensions>;
+
+        struct Neighbor {
+            //the point's index, in the order the points were inserted
+            uint32_t index;
+            F squaredDistance;
+        };
+
+        struct Slot {
+            Cell cell;
+            //first point of the cell in positions and indices
+            uint32_t begin;
+            //0 marks an empty slot
+            uint32_t count;
+        };
+        static constexpr uint32_t NoSlot = UINT32_MAX;
+
+        F cellSize;
+        F inverseCellSize;
+        //power of two, kept at most half full
+        std::vector<Slot> slots;
+        //the points and their insertion indices, sorted by cell
+        std::vector<Vector<F, Dimensions>> positions;
+        std::vector<uint32_t> indices;
+        //range of the occupied cells, min is past max while the grid is empty
+        Cell minCell{INT32_MAX};
+        Cell maxCell{INT32_MIN};
+        //Sort's buffers, kept between refills
+        std::vector<uint32_t> pointSlots;
+        std::vector<Vector<F, Dimensions>> sortedPositions;
+        std::vector<uint32_t> sortedIndices;
+
+        LAB_constexpr SpatialHashGrid() : SpatialHashGrid(F(1)) {}
+        explicit LAB_constexpr SpatialHashGrid(F const cellSize) : cellSize{cellSize}, inverseCellSize{F(1) / cellSize} {
+#if LAB_DEBUGGING_ACCESS
+            assert(cellSize > F(0));
+#endif
+        }
+
+        LAB_constexpr std::size_t Size() const {
+            return indices.size();
+        }
+        LAB_constexpr void Clear() {
+            positions.clear();
+            indices.clear();
+            for (Slot& slot : slots) {
+                slot.count = 0;
+            }
+            minCell = Cell{INT32_MAX};
+            maxCell = Cell{INT32_MIN};
+        }
+
+        LAB_constexpr Cell CellOf(Vector<F, Dimensions> const position) const {
+            Cell ret;
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                ret[dim] = static_cast<int32_t>(Floor(position[dim] * inverseCellSize));
+            }
+            return ret;
+        }
+
+        //adds the points after the ones already in the grid, the first one gets index Size() and the rest follow in order
+        //re-sorts every point, one Insert with all of them is cheaper than many small ones
+        LAB_constexpr void Insert(std::span<const Vector<F, Dimensions>> const points) {
+            const uint32_t first = static_cast<uint32_t>(indices.size());
+            positions.insert(positions.end(), points.begin(), points.end());
+            for (uint32_t i = 0; i < points.size(); i++) {
+                indices.push_back(first + i);
+            }
+            Sort();
+        }
+
+        //every point with a distance to center of at most radius, in no particular order. out is overwritten
+        LAB_constexpr void QueryRadius(Vector<F, Dimensions> const center, F const radius, std::vector<Neighbor>& out) const {
+            out.clear();
+            ForEachInRadius(center, radius, [&](uint32_t const index, F const squaredDistance) {
+                out.push_back(Neighbor{index, squaredDistance});
+            });
+        }
+        //callback(index, squaredDistance) for every point with a distance to center of at most radius
+        template<typename Callback>
+        LAB_constexpr void ForEachInRadius(Vector<F, Dimensions> const center, F const radius, Callback&& callback) const {
+            const F squaredRadius = radius * radius;
+            const Cell low = CellOf(center - Vector<F, Dimensions>{radius});
+            const Cell high = CellOf(center + Vector<F, Dimensions>{radius});
+            ForEachCell(low, high, false, [&](uint32_t const slot) {
+                VisitCell(slot, center, [&](uint32_t const index, F const squaredDistance) {
+                    if (squaredDistance <= squaredRadius) {
+                        callback(index, squaredDistance);
+                    }
+                });
+            });
+        }
+
+        //the k points closest to point, nearest first, ties go to the lower index. out is overwritten and has fewer than k when the grid does
+        //searches outward one ring of cells at a time, and stops once the ring is further than the kth closest point found so far
+        LAB_constexpr void QueryNearest(Vector<F, Dimensions> const point, uint32_t const k, std::vector<Neighbor>& out) const {
+            out.clear();
+            if (k == 0 || indices.empty()) {
+                return;
+            }
+            //a max heap on (squaredDistance, index), the front is the one to drop next
+            auto closer = [](Neighbor const& lhs, Neighbor const& rhs) {
+                return (lhs.squaredDistance < rhs.squaredDistance) || (lhs.squaredDistance == rhs.squaredDistance && lhs.index < rhs.index);
+            };
+            const Cell center = CellOf(point);
+            //the rings closer than this miss the occupied range
+            int32_t firstRing = 0;
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                firstRing = std::max({firstRing, minCell[dim] - center[dim], center[dim] - maxCell[dim]});
+            }
+            for (int32_t ring = firstRing;; ring++) {
+                Cell low;
+                Cell high;
+                bool coversGrid = true;
+                for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                    low[dim] = center[dim] - ring;
+                    high[dim] = center[dim] + ring;
+                    coversGrid &= (low[dim] <= minCell[dim]) && (maxCell[dim] <= high[dim]);
+                }
+                ForEachCell(low, high, ring > firstRing, [&](uint32_t const slot) {
+                    VisitCell(slot, point, [&](uint32_t const index, F const squaredDistance) {
+                        const Neighbor candidate{index, squaredDistance};
+                        if (out.size() < k) {
+                            out.push_back(candidate);
+                            std::push_heap(out.begin(), out.end(), closer);
+                        }
+                        else if (closer(candidate, out.front())) {
+                            std::pop_heap(out.begin(), out.end(), closer);
+                            out.back() = candidate;
+                            std::push_heap(out.begin(), out.end(), closer);
+                        }
+                    });
+                });
+                if (coversGrid) {
+                    break;
+                }
+                //every cell past this ring is at least ring whole cells away
+                const F reach = static_cast<F>(ring) * cellSize;
+                if (out.size() == k && out.front().squaredDistance <= reach * reach) {
+                    break;
+                }
+            }
+            std::sort_heap(out.begin(), out.end(), closer);
+        }
+
+    private:
+        LAB_constexpr uint32_t FindSlot(Cell const cell) const {
+            if (slots.empty()) {
+                return NoSlot;
+            }
+            const uint32_t mask = static_cast<uint32_t>(slots.size()) - 1;
+            for (uint32_t slot = detail::HashCell(cell) >> SlotShift(); slots[slot].count != 0; slot = (slot + 1) & mask) {
+                if (slots[slot].cell == cell) {
+                    return slot;
+                }
+            }
+            return NoSlot;
+        }
+        LAB_constexpr uint8_t SlotShift() const {
+            return static_cast<uint8_t>(32 - std::countr_zero(static_cast<uint32_t>(slots.size())));
+        }
+
+        //counting sort by cell, stable so the points of a cell stay in insertion order
+        LAB_constexpr void Sort() {
+            const std::size_t count = indices.size();
+            const std::size_t capacity = std::max<std::size_t>(16, std::bit_ceil(count * 2));
+            if (slots.size() != capacity) {
+                slots.resize(capacity);
+            }
+            for (Slot& slot : slots) {
+                slot.count = 0;
+            }
+            minCell = Cell{INT32_MAX};
+            maxCell = Cell{INT32_MIN};
+
+            const uint32_t mask = static_cast<uint32_t>(capacity) - 1;
+            const uint8_t shift = SlotShift();
+            pointSlots.resize(count);
+            for (std::size_t i = 0; i < count; i++) {
+                const Cell cell = CellOf(positions[i]);
+                for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                    minCell[dim] = std::min(minCell[dim], cell[dim]);
+                    maxCell[dim] = std::max(maxCell[dim], cell[dim]);
+                }
+                uint32_t slot = detail::HashCell(cell) >> shift;
+                while (slots[slot].count != 0 && slots[slot].cell != cell) {
+                    slot = (slot + 1) & mask;
+                }
+                slots[slot].cell = cell;
+                slots[slot].count++;
+                pointSlots[i] = slot;
+            }
+            //begin starts at the end of the run and counts down as the points are placed back to front
+            uint32_t runEnd = 0;
+            for (Slot& slot : slots) {
+                runEnd += slot.count;
+                slot.begin = runEnd;
+            }
+            sortedPositions.resize(count);
+            sortedIndices.resize(count);
+            for (std::size_t i = count; i-- > 0;) {
+                const uint32_t destination = --slots[pointSlots[i]].begin;
+                sortedPositions[destination] = positions[i];
+                sortedIndices[destination] = indices[i];
+            }
+            positions.swap(sortedPositions);
+            indices.swap(sortedIndices);
+        }
+
+        //visit(slot) for the occupied cells in the box [low, high], clipped to the occupied range
+        //shellOnly skips the cells inside the box and keeps the ones on its faces, for the ring by ring search
+        template<typename Visit>
+        LAB_constexpr void ForEachCell(Cell const low, Cell const high, bool const shellOnly, Visit&& visit) const {
+            Cell clippedLow;
+            Cell clippedHigh;
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                clippedLow[dim] = std::max(low[dim], minCell[dim]);
+                clippedHigh[dim] = std::min(high[dim], maxCell[dim]);
+                if (clippedLow[dim] > clippedHigh[dim]) {
+                    return;
+                }
+            }
+            auto visitCell = [&](Cell const& cell) {
+                const uint32_t slot = FindSlot(cell);
+                if (slot != NoSlot) {
+                    visit(slot);
+                }
+            };
+            Cell cell = clippedLow;
+            while (true) {
+                //dimension 0 is the inner loop, when no other dimension is on a face only the two ends of the row are
+                bool onFace = !shellOnly;
+                for (uint8_t dim = 1; dim < Dimensions; dim++) {
+                    onFace |= (cell[dim] == low[dim]) || (cell[dim] == high[dim]);
+                }
+                if (onFace) {
+                    for (cell[0] = clippedLow[0]; cell[0] <= clippedHigh[0]; cell[0]++) {
+                        visitCell(cell);
+                    }
+                }
+                else {
+                    if (clippedLow[0] == low[0]) {
+                        cell[0] = low[0];
+                        visitCell(cell);
+                    }
+                    if (clippedHigh[0] == high[0] && high[0] != low[0]) {
+                        cell[0] = high[0];
+                        visitCell(cell);
+                    }
+                }
+                uint8_t dim = 1;
+                for (; dim < Dimensions; dim++) {
+                    if (cell[dim] < clippedHigh[dim]) {
+                        cell[dim]++;
+                        break;
+                    }
+                    cell[dim] = clippedLow[dim];
+                }
+                if (dim == Dimensions) {
+                    return;
+                }
+            }
+        }
+
+        template<typename Visit>
+        LAB_constexpr void VisitCell(uint32_t const slot, Vector<F, Dimensions> const point, Visit&& visit) const {
+            const uint32_t end = slots[slot].begin + slots[slot].count;
+            for (uint32_t i = slots[slot].begin; i < end; i++) {
+                visit(indices[i], (positions[i] - point).SquaredMagnitude());
+            }
+        }
+    };
+}
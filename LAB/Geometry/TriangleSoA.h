@@ -0,0 +1,126 @@
+#pragma once
+#include "Ray.h"
+#include "../Vector/VectorSoA.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+//triangles as v0 and the two edges out of it, each in its own VectorSoA, for testing one ray against many triangles without a BVH
+//the SIMD path tests SIMD::FloatWidth triangles per step with lane masks instead of branching per triangle
+
+namespace lab {
+    template<std::floating_point F>
+    struct TriangleSoA {
+        VectorSoA<F, 3> v0;
+        //v1 - v0
+        VectorSoA<F, 3> edge1;
+        //v2 - v0
+        VectorSoA<F, 3> edge2;
+
+        //every 3 indices are a triangle, triangle i of the result is indices [i * 3, i * 3 + 3)
+        static LAB_constexpr TriangleSoA FromMesh(std::span<const Vector<F, 3>> const vertices, std::span<const uint32_t> const indices) {
+#if LAB_DEBUGGING_ACCESS
+            assert(indices.size() % 3 == 0);
+#endif
+            TriangleSoA ret;
+            ret.Reserve(indices.size() / 3);
+            for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+                ret.PushBack(vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]]);
+            }
+            return ret;
+        }
+
+        LAB_constexpr std::size_t Size() const {
+            return v0.Size();
+        }
+        LAB_constexpr void Reserve(std::size_t const capacity) {
+            v0.Reserve(capacity);
+            edge1.Reserve(capacity);
+            edge2.Reserve(capacity);
+        }
+        LAB_constexpr void PushBack(Vector<F, 3> const vertex0, Vector<F, 3> const vertex1, Vector<F, 3> const vertex2) {
+            v0.PushBack(vertex0);
+            edge1.PushBack(vertex1 - vertex0);
+            edge2.PushBack(vertex2 - vertex0);
+        }
+    };
+
+    //closest hit nearer than hit.distance, hit is only written when there is one. RayHit::triangle is the index into triangles
+    //the SIMD path gives the same hit as testing the triangles in order, including the lowest index winning a tie
+    template<std::floating_point F>
+    LAB_constexpr bool IntersectTriangles(Ray<F> const& ray, TriangleSoA<F> const& triangles, RayHit<F>& hit) {
+        const std::size_t count = triangles.Size();
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                const SIMD::Float origin[3] = {SIMD::Set1(ray.origin.x), SIMD::Set1(ray.origin.y), SIMD::Set1(ray.origin.z)};
+                const SIMD::Float direction[3] = {SIMD::Set1(ray.direction.x), SIMD::Set1(ray.direction.y), SIMD::Set1(ray.direction.z)};
+                //every lane keeps the closest hit among the triangles that land in it, the lanes are reduced at the end
+                SIMD::Float distance = SIMD::Set1(hit.distance);
+                SIMD::Float hitU = SIMD::Set1(0.f);
+                SIMD::Float hitV = SIMD::Set1(0.f);
+                //where the lane's hit block starts, as int bits
+                SIMD::Float hitBlock = SIMD::Set1(0.f);
+                SIMD::Float found = SIMD::Set1(0.f);
+                for (std::size_t i = 0; i < count; i += SIMD::FloatWidth) {
+                    const SIMD::Float v0[3] = {SIMD::Load(triangles.v0.X() + i), SIMD::Load(triangles.v0.Y() + i), SIMD::Load(triangles.v0.Z() + i)};
+                    const SIMD::Float edge1[3] = {SIMD::Load(triangles.edge1.X() + i), SIMD::Load(triangles.edge1.Y() + i), SIMD::Load(triangles.edge1.Z() + i)};
+                    const SIMD::Float edge2[3] = {SIMD::Load(triangles.edge2.X() + i), SIMD::Load(triangles.edge2.Y() + i), SIMD::Load(triangles.edge2.Z() + i)};
+                    SIMD::Float t;
+                    SIMD::Float u;
+                    SIMD::Float v;
+                    SIMD::Float valid = detail::IntersectTriangleLanes(origin, direction, v0, edge1, edge2, distance, t, u, v);
+                    if (i + SIMD::FloatWidth > count) {
+                        //the padding past count isn't guaranteed to be zeroed triangles
+                        alignas(SIMD::Alignment) float laneIndices[SIMD::FloatWidth];
+                        for (std::size_t lane = 0; lane < SIMD::FloatWidth; lane++) {
+                            laneIndices[lane] = static_cast<float>(lane);
+                        }
+                        valid = SIMD::And(valid, SIMD::Less(SIMD::Load(laneIndices), SIMD::Set1(static_cast<float>(count - i))));
+                    }
+                    if (SIMD::MoveMask(valid) == 0) {
+                        continue;
+                    }
+                    distance = SIMD::Select(valid, t, distance);
+                    hitU = SIMD::Select(valid, u, hitU);
+                    hitV = SIMD::Select(valid, v, hitV);
+                    hitBlock = SIMD::Select(valid, SIMD::AsFloat(SIMD::Set1Int(static_cast<int32_t>(i))), hitBlock);
+                    found = SIMD::Or(found, valid);
+                }
+                const int foundMask = SIMD::MoveMask(found);
+                if (foundMask == 0) {
+                    return false;
+                }
+                alignas(SIMD::Alignment) float distanceLanes[SIMD::FloatWidth];
+                alignas(SIMD::Alignment) float uLanes[SIMD::FloatWidth];
+                alignas(SIMD::Alignment) float vLanes[SIMD::FloatWidth];
+                alignas(SIMD::Alignment) int32_t blockLanes[SIMD::FloatWidth];
+                SIMD::Store(distanceLanes, distance);
+                SIMD::Store(uLanes, hitU);
+                SIMD::Store(vLanes, hitV);
+                SIMD::Store(reinterpret_cast<float*>(blockLanes), hitBlock);
+                for (std::size_t lane = 0; lane < SIMD::FloatWidth; lane++) {
+                    if (!((foundMask >> lane) & 1)) {
+                        continue;
+                    }
+                    const uint32_t triangle = static_cast<uint32_t>(blockLanes[lane]) + static_cast<uint32_t>(lane);
+                    if (distanceLanes[lane] < hit.distance || (distanceLanes[lane] == hit.distance && triangle < hit.triangle)) {
+                        hit.distance = distanceLanes[lane];
+                        hit.u = uLanes[lane];
+                        hit.v = vLanes[lane];
+                        hit.triangle = triangle;
+                    }
+                }
+                return true;
+            }
+        }
+#endif
+        bool found = false;
+        for (std::size_t i = 0; i < count; i++) {
+            found |= detail::IntersectTriangleEdges(ray, triangles.v0.Get(i), triangles.edge1.Get(i), triangles.edge2.Get(i), static_cast<uint32_t>(i), hit);
+        }
+        return found;
+    }
+}
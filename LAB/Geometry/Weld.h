@@ -0,0 +1,160 @@
+#pragma once
+#include "../Vector.h"
+#include "../Vector/Hash.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+//vertex welding, for merging the duplicated corners of imported meshes
+//the vertices go into a flat open addressing table keyed by lab::Hash of their quantized position, no node per entry like std::unordered_map
+
+namespace lab {
+    template<std::floating_point F>
+    struct WeldResult {
+        //the first vertex of every group, in the order the groups were found
+        std::vector<Vector<F, 3>> vertices;
+        //remap[i] is the index in vertices that input vertex i was welded to
+        std::vector<uint32_t> remap;
+    };
+
+    namespace detail {
+        //8 bytes so most of a cell's probe run is one cache line, the key itself is the head vertex, or its cell when there is an epsilon
+        struct WeldSlot {
+            //newest unique vertex in the cell, with an epsilon the rest follow through WeldVertices' next list
+            uint32_t head;
+            //lab::Hash of the key, compared before the key so a probe past another cell rarely reads the vertices
+            uint32_t hash;
+        };
+        inline constexpr uint32_t NoWeldVertex = UINT32_MAX;
+
+        //equal after folding -0 into 0 and every NaN into one, the same way lab::Hash sees them
+        template<std::floating_point F>
+        LAB_constexpr bool SameWeldKey(Vector<F, 3> const lhs, Vector<F, 3> const rhs) {
+            return (CanonicalBits(lhs.x) == CanonicalBits(rhs.x)) && (CanonicalBits(lhs.y) == CanonicalBits(rhs.y)) && (CanonicalBits(lhs.z) == CanonicalBits(rhs.z));
+        }
+
+        //the key's slot, or the empty slot it would go in
+        template<std::floating_point F>
+        LAB_constexpr uint32_t FindWeldSlot(std::vector<WeldSlot> const& slots, std::vector<Vector<F, 3>> const& cellKeys, Vector<F, 3> const key, uint32_t const hash) {
+            const uint32_t mask = static_cast<uint32_t>(slots.size()) - 1;
+            uint32_t slot = hash & mask;
+            while (slots[slot].head != NoWeldVertex && (slots[slot].hash != hash || !SameWeldKey(cellKeys[slots[slot].head], key))) {
+                slot = (slot + 1) & mask;
+            }
+            return slot;
+        }
+    }
+
+    //vertices within epsilon of each other on every axis are welded, epsilon 0 welds exact duplicates only (0 and -0 are the same, so are all NaNs)
+    //the vertices are visited in order and each joins the lowest index group that has its first vertex within epsilon, or starts a new one
+    //that makes the result depend only on the input order, never on the hash table layout, and it's only multiplies, floors and compares,
+    //nothing a compiler can contract into an fma, so it is the same on every compiler
+    //the cells are 8 * epsilon wide, so on each axis only the vertices within epsilon of a border also look in the next cell over, about 2 cells per vertex
+    template<std::floating_point F>
+    LAB_constexpr WeldResult<F> WeldVertices(std::type_identity_t<std::span<const Vector<F, 3>>> const vertices, F const epsilon) {
+#if LAB_DEBUGGING_ACCESS
+        assert(epsilon >= F(0));
+#endif
+        WeldResult<F> ret;
+        ret.remap.resize(vertices.size());
+        ret.vertices.reserve(vertices.size());
+        //there are never more cells than input vertices, so at twice the input the table is at most half full and never has to grow
+        //growing it as cells are found was a third of the exact weld's time
+        std::vector<detail::WeldSlot> slots(std::bit_ceil(vertices.size() * 2), detail::WeldSlot{detail::NoWeldVertex, 0});
+
+        if (!(epsilon > F(0))) {
+            //the cells are keyed by the vertex itself, so every cell is one unique vertex and the lookup is the whole search
+            for (std::size_t i = 0; i < vertices.size(); i++) {
+                const Vector<F, 3> vertex = vertices[i];
+                const uint32_t hash = Hash(vertex);
+                const uint32_t slot = detail::FindWeldSlot(slots, ret.vertices, vertex, hash);
+                uint32_t match = slots[slot].head;
+                if (match == detail::NoWeldVertex) {
+                    match = static_cast<uint32_t>(ret.vertices.size());
+                    ret.vertices.push_back(vertex);
+                    slots[slot] = detail::WeldSlot{match, hash};
+                }
+                ret.remap[i] = match;
+            }
+            return ret;
+        }
+
+        //per unique vertex, the next older one in the same cell
+        std::vector<uint32_t> next;
+        next.reserve(vertices.size());
+        //per unique vertex, its cell
+        std::vector<Vector<F, 3>> cells;
+        cells.reserve(vertices.size());
+
+        const F inverseCellSize = F(1) / (epsilon * F(8));
+        for (std::size_t i = 0; i < vertices.size(); i++) {
+            const Vector<F, 3> vertex = vertices[i];
+            Vector<F, 3> cell = vertex;
+            uint32_t cellHash = 0;
+            uint32_t cellSlot = 0;
+            uint32_t match = detail::NoWeldVertex;
+            //rounding is monotonic, so anything within epsilon is in a cell between the cells of vertex - epsilon and vertex + epsilon
+            //that's 1 or 2 cells per axis, and room for 3 in case a huge coordinate rounds them apart. the vertex's own is always one of them
+            F axisCells[3][3];
+            uint8_t axisCount[3];
+            uint8_t cellIndex[3];
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                const F below = vertex[axis] - epsilon;
+                const F above = vertex[axis] + epsilon;
+                const F scaledBelow = below * inverseCellSize;
+                const F scaledAbove = above * inverseCellSize;
+                cell[axis] = Floor(vertex[axis] * inverseCellSize);
+                //Floor is the slow part, most of the time both ends are in the vertex's own cell
+                const F low = (scaledBelow < cell[axis]) ? Floor(scaledBelow) : cell[axis];
+                const F high = (scaledAbove >= cell[axis] + F(1)) ? Floor(scaledAbove) : cell[axis];
+                axisCount[axis] = 0;
+                axisCells[axis][axisCount[axis]++] = low;
+                if (cell[axis] != low) {
+                    axisCells[axis][axisCount[axis]++] = cell[axis];
+                }
+                cellIndex[axis] = axisCount[axis] - 1;
+                if (high != cell[axis]) {
+                    axisCells[axis][axisCount[axis]++] = high;
+                }
+            }
+            const uint8_t cellCorner = static_cast<uint8_t>(cellIndex[0] + (cellIndex[1] + cellIndex[2] * axisCount[1]) * axisCount[0]);
+            for (uint8_t corner = 0; corner < axisCount[0] * axisCount[1] * axisCount[2]; corner++) {
+                const Vector<F, 3> neighbor{
+                    axisCells[0][corner % axisCount[0]],
+                    axisCells[1][(corner / axisCount[0]) % axisCount[1]],
+                    axisCells[2][corner / (axisCount[0] * axisCount[1])]
+                };
+                const uint32_t hash = Hash(neighbor);
+                const uint32_t slot = detail::FindWeldSlot(slots, cells, neighbor, hash);
+                if (corner == cellCorner) {
+                    cellHash = hash;
+                    cellSlot = slot;
+                }
+                for (uint32_t candidate = slots[slot].head; candidate != detail::NoWeldVertex; candidate = next[candidate]) {
+                    if (candidate < match) {
+                        const Vector<F, 3> delta = ret.vertices[candidate] - vertex;
+                        if (Abs(delta.x) <= epsilon && Abs(delta.y) <= epsilon && Abs(delta.z) <= epsilon) {
+                            match = candidate;
+                        }
+                    }
+                }
+            }
+
+            if (match == detail::NoWeldVertex) {
+                match = static_cast<uint32_t>(ret.vertices.size());
+                ret.vertices.push_back(vertex);
+                cells.push_back(cell);
+                next.push_back(slots[cellSlot].head);
+                slots[cellSlot].head = match;
+                slots[cellSlot].hash = cellHash;
+            }
+            ret.remap[i] = match;
+        }
+        return ret;
+    }
+}
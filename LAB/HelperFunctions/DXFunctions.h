@@ -217,12 +217,9 @@ namespace lab{
     }
 
     inline Matrix<float, 4, 4> MatrixRotationYawPitchRoll(const float yaw, const float pitch, const float roll) {
-        const float sy = lab::Sin(yaw);
-        const float cy = lab::Cos(yaw);
-        const float sp = lab::Sin(pitch);
-        const float cp = lab::Cos(pitch);
-        const float sr = lab::Sin(roll);
-        const float cr = lab::Cos(roll);
+        const auto [sy, cy] = lab::SinCos(yaw);
+        const auto [sp, cp] = lab::SinCos(pitch);
+        const auto [sr, cr] = lab::SinCos(roll);
 
         return Matrix<float, 4, 4>{
             Vector<float, 4>(
@@ -248,12 +245,9 @@ namespace lab{
     }
 
     inline lab::Quat QuaternionRotationYawPitchRoll(float yaw, float pitch, float roll) {
-        const float cy = lab::Cos(yaw * 0.5f);
-        const float sy = lab::Sin(yaw * 0.5f);
-        const float cp = lab::Cos(pitch * 0.5f);
-        const float sp = lab::Sin(pitch * 0.5f);
-        const float cr = lab::Cos(roll * 0.5f);
-        const float sr = lab::Sin(roll * 0.5f);
+        const auto [sy, cy] = lab::SinCos(yaw * 0.5f);
+        const auto [sp, cp] = lab::SinCos(pitch * 0.5f);
+        const auto [sr, cr] = lab::SinCos(roll * 0.5f);
 
         return lab::Quat{
             sr * cp * cy - cr * sp * sy,
@@ -3,6 +3,7 @@
 #include "Matrix/Matrix2x2.h"
 #include "Matrix/Matrix3x3.h"
 #include "Matrix/Matrix4x4.h"
+#include "Matrix/Matrix4x4Batch.h"
 
 
 namespace lab{
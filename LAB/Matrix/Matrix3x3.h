@@ -200,8 +200,7 @@ namespace lab {
         }
 
         Matrix GetRotated(F const angle, Vector<F, 2> const axis) const {
-            F const cosine = Cos(angle);
-            F const sine = Sin(angle);
+            const auto [sine, cosine] = SinCos(angle);
 #if LAB_DEBUGGING_FLOAT_ANOMALY
 			//ensure axis is normalized
 			const Vector<F, 3> axisNormDiff  axis - axis.Normalized();
@@ -431,8 +430,7 @@ namespace lab {
         }
 
         Matrix GetRotated(F const angle, Vector<F, 2> const axis) const {
-            F const cosine = Cos(angle);
-            F const sine = Sin(angle);
+            const auto [sine, cosine] = SinCos(angle);
 			
 #if LAB_DEBUGGING_FLOAT_ANOMALIES
 			//ensure axis is normalized
@@ -4,8 +4,10 @@
 #include "../Vector.h"
 #include "../Debugging.h"
 #include "../Support/Trig.h"
+#include "../Support/SIMD.h"
 
 #include <concepts>
+#include <type_traits>
 
 #ifdef LAB_ROW_MAJOR
 #define XM_PERMUTE_PS( v, c ) _mm_shuffle_ps((v), (v), c )
@@ -13,8 +15,106 @@
 #endif
 
 namespace lab {
+#ifdef USING_SIMD
+    namespace detail {
+        //lanes are the 2x2 determinants of rows RowA and RowB over the column pairs 2/3, 2/3, 1/3, 1/2
+        template<int RowA, int RowB>
+        inline __m128 InverseFactor(__m128 const col1, __m128 const col2, __m128 const col3) {
+            const __m128 swapA = _mm_shuffle_ps(col3, col2, _MM_SHUFFLE(RowB, RowB, RowB, RowB));
+            const __m128 swapB = _mm_shuffle_ps(col3, col2, _MM_SHUFFLE(RowA, RowA, RowA, RowA));
+
+            const __m128 swap0 = _mm_shuffle_ps(col2, col1, _MM_SHUFFLE(RowA, RowA, RowA, RowA));
+            const __m128 swap1 = _mm_shuffle_ps(swapA, swapA, _MM_SHUFFLE(2, 0, 0, 0));
+            const __m128 swap2 = _mm_shuffle_ps(swapB, swapB, _MM_SHUFFLE(2, 0, 0, 0));
+            const __m128 swap3 = _mm_shuffle_ps(col2, col1, _MM_SHUFFLE(RowB, RowB, RowB, RowB));
+            return _mm_sub_ps(_mm_mul_ps(swap0, swap1), _mm_mul_ps(swap2, swap3));
+        }
+        //(col1[Row], col0[Row], col0[Row], col0[Row])
+        template<int Row>
+        inline __m128 InverseRow(__m128 const col0, __m128 const col1) {
+            const __m128 temp = _mm_shuffle_ps(col1, col0, _MM_SHUFFLE(Row, Row, Row, Row));
+            return _mm_shuffle_ps(temp, temp, _MM_SHUFFLE(2, 2, 2, 0));
+        }
+
+        //the SIMD half of Matrix<float, 4, 4>::GetInverse, false if the matrix is singular
+        inline bool InverseSIMD(__m128 const col0, __m128 const col1, __m128 const col2, __m128 const col3, __m128 (&out)[4]) {
+            const __m128 fac0 = InverseFactor<2, 3>(col1, col2, col3);
+            const __m128 fac1 = InverseFactor<1, 3>(col1, col2, col3);
+            const __m128 fac2 = InverseFactor<1, 2>(col1, col2, col3);
+            const __m128 fac3 = InverseFactor<0, 3>(col1, col2, col3);
+            const __m128 fac4 = InverseFactor<0, 2>(col1, col2, col3);
+            const __m128 fac5 = InverseFactor<0, 1>(col1, col2, col3);
+
+            const __m128 vec0 = InverseRow<0>(col0, col1);
+            const __m128 vec1 = InverseRow<1>(col0, col1);
+            const __m128 vec2 = InverseRow<2>(col0, col1);
+            const __m128 vec3 = InverseRow<3>(col0, col1);
+
+            const __m128 signA = _mm_set_ps(-1.f, 1.f, -1.f, 1.f);
+            const __m128 signB = _mm_set_ps(1.f, -1.f, 1.f, -1.f);
+
+            const __m128 inv0 = _mm_mul_ps(signA, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vec1, fac0), _mm_mul_ps(vec2, fac1)), _mm_mul_ps(vec3, fac2)));
+            const __m128 inv1 = _mm_mul_ps(signB, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vec0, fac0), _mm_mul_ps(vec2, fac3)), _mm_mul_ps(vec3, fac4)));
+            const __m128 inv2 = _mm_mul_ps(signA, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vec0, fac1), _mm_mul_ps(vec1, fac3)), _mm_mul_ps(vec3, fac5)));
+            const __m128 inv3 = _mm_mul_ps(signB, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vec0, fac2), _mm_mul_ps(vec1, fac4)), _mm_mul_ps(vec2, fac5)));
+
+            //first row of the adjugate, (inv0[0], inv1[0], inv2[0], inv3[0])
+            const __m128 row01 = _mm_shuffle_ps(inv0, inv1, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 row23 = _mm_shuffle_ps(inv2, inv3, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 row = _mm_shuffle_ps(row01, row23, _MM_SHUFFLE(2, 0, 2, 0));
+
+            //(x + y) + (z + w) in every lane, matching the scalar sum
+            const __m128 products = _mm_mul_ps(col0, row);
+            const __m128 pairs = _mm_add_ps(products, _mm_shuffle_ps(products, products, _MM_SHUFFLE(2, 3, 0, 1)));
+            const __m128 det = _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+
+            const float detScalar = _mm_cvtss_f32(det);
+            if (((detScalar < 0.f) ? -detScalar : detScalar) < 1e-6f) {
+                return false;
+            }
+
+            const __m128 oneOverDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+            out[0] = _mm_mul_ps(inv0, oneOverDet);
+            out[1] = _mm_mul_ps(inv1, oneOverDet);
+            out[2] = _mm_mul_ps(inv2, oneOverDet);
+            out[3] = _mm_mul_ps(inv3, oneOverDet);
+            return true;
+        }
+
+        //the SIMD half of Matrix<float, 4, 4>::GetAffineInverse
+        inline void AffineInverseSIMD(__m128 const col0, __m128 const col1, __m128 const col2, __m128 const col3, __m128 (&out)[4]) {
+            //transpose the 3x3, the w lanes end up 0
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 low01 = _mm_unpacklo_ps(col0, col1);
+            const __m128 high01 = _mm_unpackhi_ps(col0, col1);
+            const __m128 low2z = _mm_unpacklo_ps(col2, zero);
+            const __m128 high2z = _mm_unpackhi_ps(col2, zero);
+            const __m128 rows0 = _mm_movelh_ps(low01, low2z);
+            const __m128 rows1 = _mm_movehl_ps(low2z, low01);
+            const __m128 rows2 = _mm_movelh_ps(high01, high2z);
+
+            //squared column lengths, w is forced to 1 so it doesnt divide by zero
+            __m128 squaredScale = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rows0, rows0), _mm_mul_ps(rows1, rows1)), _mm_mul_ps(rows2, rows2));
+            squaredScale = _mm_blend_ps(squaredScale, _mm_set1_ps(1.f), 0b1000);
+            const __m128 inverseSquaredScale = _mm_div_ps(_mm_set1_ps(1.f), squaredScale);
+
+            out[0] = _mm_mul_ps(rows0, inverseSquaredScale);
+            out[1] = _mm_mul_ps(rows1, inverseSquaredScale);
+            out[2] = _mm_mul_ps(rows2, inverseSquaredScale);
+
+            const __m128 tx = _mm_shuffle_ps(col3, col3, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 ty = _mm_shuffle_ps(col3, col3, _MM_SHUFFLE(1, 1, 1, 1));
+            const __m128 tz = _mm_shuffle_ps(col3, col3, _MM_SHUFFLE(2, 2, 2, 2));
+            const __m128 rotated = _mm_add_ps(_mm_add_ps(_mm_mul_ps(out[0], tx), _mm_mul_ps(out[1], ty)), _mm_mul_ps(out[2], tz));
+            //flip the sign bit rather than 0 - x, so a zero translation stays +0 like the scalar negate. w = 1
+            out[3] = _mm_blend_ps(_mm_xor_ps(rotated, _mm_set1_ps(-0.f)), _mm_set1_ps(1.f), 0b1000);
+        }
+    }
+#endif
+
+    //aligned to the SIMD width, so with AVX2 a column pair is one aligned 256 bit load and no matrix straddles two cache lines
     template<::std::floating_point F>
-    struct Matrix<F, 4, 4, 4> {
+    struct alignas(BatchAlignment) Matrix<F, 4, 4, 4> {
 #ifdef USING_SIMD
         using ColType = VectorSIMD;
 #else
@@ -139,6 +239,24 @@ namespace lab {
             return mul0 + mul1 + mul2 + mul3;
         }
 #endif
+#ifdef LAB_USING_AVX2
+        //transforms two vec4s at once, one per half
+        LAB_constexpr VectorSIMD8 operator*(VectorSIMD8 const vectors) const {
+            if consteval {
+                return VectorSIMD8{
+                    operator*(vectors.components[0]),
+                    operator*(vectors.components[1])
+                };
+            }
+            else {
+                const VectorSIMD8 col0{columns[0], columns[0]};
+                const VectorSIMD8 col1{columns[1], columns[1]};
+                const VectorSIMD8 col2{columns[2], columns[2]};
+                const VectorSIMD8 col3{columns[3], columns[3]};
+                return col0 * vectors.BroadcastLane<0>() + col1 * vectors.BroadcastLane<1>() + col2 * vectors.BroadcastLane<2>() + col3 * vectors.BroadcastLane<3>();
+            }
+        }
+#endif
 #endif
 
 
@@ -268,17 +386,34 @@ namespace lab {
             }
             else {
 
+                //the adds are kept in the same order as the scalar branch, so constexpr and runtime results match
+#ifdef LAB_USING_AVX2
+                //two result columns per register, each lhs column is duplicated into both halves
+                const VectorSIMD8 lhs0{columns[0], columns[0]};
+                const VectorSIMD8 lhs1{columns[1], columns[1]};
+                const VectorSIMD8 lhs2{columns[2], columns[2]};
+                const VectorSIMD8 lhs3{columns[3], columns[3]};
+
+                Matrix ret;
+                for(uint8_t i = 0; i < 4; i += 2){
+                    const VectorSIMD8 rhs{other.columns[i], other.columns[i + 1]};
+                    const VectorSIMD8 result = lhs0 * rhs.BroadcastLane<0>() + lhs1 * rhs.BroadcastLane<1>() + lhs2 * rhs.BroadcastLane<2>() + lhs3 * rhs.BroadcastLane<3>();
+                    ret.columns[i] = result.Low();
+                    ret.columns[i + 1] = result.High();
+                }
+                return ret;
+#else
                 Matrix ret;
                 for(uint8_t i = 0; i < 4; i++){
-                    const __m128 v[4] = {
-                        _mm_shuffle_ps(columns[i].vec, columns[i].vec, _MM_SHUFFLE(0, 0, 0, 0)),
-                        _mm_shuffle_ps(columns[i].vec, columns[i].vec, _MM_SHUFFLE(1, 1, 1, 1)),
-                        _mm_shuffle_ps(columns[i].vec, columns[i].vec, _MM_SHUFFLE(2, 2, 2, 2)),
-                        _mm_shuffle_ps(columns[i].vec, columns[i].vec, _MM_SHUFFLE(3, 3, 3, 3)),
-                    };
-                    ret.columns[i].vec = _mm_add_ps(_mm_add_ps(v[0], v[2]), _mm_add_ps(v[1], v[3]));
+                    const __m128 rhs = other.columns[i].vec;
+                    __m128 result = _mm_mul_ps(columns[0].vec, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(0, 0, 0, 0)));
+                    result = _mm_add_ps(result, _mm_mul_ps(columns[1].vec, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 1, 1, 1))));
+                    result = _mm_add_ps(result, _mm_mul_ps(columns[2].vec, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(2, 2, 2, 2))));
+                    result = _mm_add_ps(result, _mm_mul_ps(columns[3].vec, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 3, 3, 3))));
+                    ret.columns[i].vec = result;
                 }
                 return ret;
+#endif
             }
 #endif
 #endif
@@ -355,138 +490,132 @@ namespace lab {
                 columns[0][0] * DetCoeff[0] + columns[0][1] * DetCoeff[1] +
                 columns[0][2] * DetCoeff[2] + columns[0][3] * DetCoeff[3];
         }
+        //glm's cofactor expansion. the SIMD branch does the same multiplies, subtracts and adds per lane in the same order, so both branches give the same bits
+        //a singular matrix (|determinant| < 1e-6) returns a zero matrix
         LAB_constexpr Matrix GetInverse() const {
-            Matrix inv{F(0)};
-
-            float invOut[16];
-
-            invOut[0] = At(1, 1) * At(2, 2) * At(3, 3) -
-                At(1, 1) * At(2, 3) * At(3, 2) -
-                At(2, 1) * At(1, 2) * At(3, 3) +
-                At(2, 1) * At(1, 3) * At(3, 2) +
-                At(3, 1) * At(1, 2) * At(2, 3) -
-                At(3, 1) * At(1, 3) * At(2, 2);
-
-            invOut[1] = -At(0, 1) * At(2, 2) * At(3, 3) +
-                At(0, 1) * At(2, 3) * At(3, 2) +
-                At(2, 1) * At(0, 2) * At(3, 3) -
-                At(2, 1) * At(0, 3) * At(3, 2) -
-                At(3, 1) * At(0, 2) * At(2, 3) +
-                At(3, 1) * At(0, 3) * At(2, 2);
-
-            invOut[2] = At(0, 1) * At(1, 2) * At(3, 3) -
-                At(0, 1) * At(1, 3) * At(3, 2) -
-                At(1, 1) * At(0, 2) * At(3, 3) +
-                At(1, 1) * At(0, 3) * At(3, 2) +
-                At(3, 1) * At(0, 2) * At(1, 3) -
-                At(3, 1) * At(0, 3) * At(1, 2);
-
-            invOut[3] = -At(0, 1) * At(1, 2) * At(2, 3) +
-                At(0, 1) * At(1, 3) * At(2, 2) +
-                At(1, 1) * At(0, 2) * At(2, 3) -
-                At(1, 1) * At(0, 3) * At(2, 2) -
-                At(2, 1) * At(0, 2) * At(1, 3) +
-                At(2, 1) * At(0, 3) * At(1, 2);
-
-            invOut[4] = -At(1, 0) * At(2, 2) * At(3, 3) +
-                At(1, 0) * At(2, 3) * At(3, 2) +
-                At(2, 0) * At(1, 2) * At(3, 3) -
-                At(2, 0) * At(1, 3) * At(3, 2) -
-                At(3, 0) * At(1, 2) * At(2, 3) +
-                At(3, 0) * At(1, 3) * At(2, 2);
-
-            invOut[5] = At(0, 0) * At(2, 2) * At(3, 3) -
-                At(0, 0) * At(2, 3) * At(3, 2) -
-                At(2, 0) * At(0, 2) * At(3, 3) +
-                At(2, 0) * At(0, 3) * At(3, 2) +
-                At(3, 0) * At(0, 2) * At(2, 3) -
-                At(3, 0) * At(0, 3) * At(2, 2);
-
-            invOut[6] = -At(0, 0) * At(1, 2) * At(3, 3) +
-                At(0, 0) * At(1, 3) * At(3, 2) +
-                At(1, 0) * At(0, 2) * At(3, 3) -
-                At(1, 0) * At(0, 3) * At(3, 2) -
-                At(3, 0) * At(0, 2) * At(1, 3) +
-                At(3, 0) * At(0, 3) * At(1, 2);
-
-            invOut[7] = At(0, 0) * At(1, 2) * At(2, 3) -
-                At(0, 0) * At(1, 3) * At(2, 2) -
-                At(1, 0) * At(0, 2) * At(2, 3) +
-                At(1, 0) * At(0, 3) * At(2, 2) +
-                At(2, 0) * At(0, 2) * At(1, 3) -
-                At(2, 0) * At(0, 3) * At(1, 2);
-
-            invOut[8] = At(1, 0) * At(2, 1) * At(3, 3) -
-                At(1, 0) * At(2, 3) * At(3, 1) -
-                At(2, 0) * At(1, 1) * At(3, 3) +
-                At(2, 0) * At(1, 3) * At(3, 1) +
-                At(3, 0) * At(1, 1) * At(2, 3) -
-                At(3, 0) * At(1, 3) * At(2, 1);
-
-            invOut[9] = -At(0, 0) * At(2, 1) * At(3, 3) +
-                At(0, 0) * At(2, 3) * At(3, 1) +
-                At(2, 0) * At(0, 1) * At(3, 3) -
-                At(2, 0) * At(0, 3) * At(3, 1) -
-                At(3, 0) * At(0, 1) * At(2, 3) +
-                At(3, 0) * At(0, 3) * At(2, 1);
-
-            invOut[10] = At(0, 0) * At(1, 1) * At(3, 3) -
-                At(0, 0) * At(1, 3) * At(3, 1) -
-                At(1, 0) * At(0, 1) * At(3, 3) +
-                At(1, 0) * At(0, 3) * At(3, 1) +
-                At(3, 0) * At(0, 1) * At(1, 3) -
-                At(3, 0) * At(0, 3) * At(1, 1);
-
-            invOut[11] = -At(0, 0) * At(1, 1) * At(2, 3) +
-                At(0, 0) * At(1, 3) * At(2, 1) +
-                At(1, 0) * At(0, 1) * At(2, 3) -
-                At(1, 0) * At(0, 3) * At(2, 1) -
-                At(2, 0) * At(0, 1) * At(1, 3) +
-                At(2, 0) * At(0, 3) * At(1, 1);
-
-            invOut[12] = -At(1, 0) * At(2, 1) * At(3, 2) +
-                At(1, 0) * At(2, 2) * At(3, 1) +
-                At(2, 0) * At(1, 1) * At(3, 2) -
-                At(2, 0) * At(1, 2) * At(3, 1) -
-                At(3, 0) * At(1, 1) * At(2, 2) +
-                At(3, 0) * At(1, 2) * At(2, 1);
-
-            invOut[13] = At(0, 0) * At(2, 1) * At(3, 2) -
-                At(0, 0) * At(2, 2) * At(3, 1) -
-                At(2, 0) * At(0, 1) * At(3, 2) +
-                At(2, 0) * At(0, 2) * At(3, 1) +
-                At(3, 0) * At(0, 1) * At(2, 2) -
-                At(3, 0) * At(0, 2) * At(2, 1);
-
-            invOut[14] = -At(0, 0) * At(1, 1) * At(3, 2) +
-                At(0, 0) * At(1, 2) * At(3, 1) +
-                At(1, 0) * At(0, 1) * At(3, 2) -
-                At(1, 0) * At(0, 2) * At(3, 1) -
-                At(3, 0) * At(0, 1) * At(1, 2) +
-                At(3, 0) * At(0, 2) * At(1, 1);
-
-            invOut[15] = At(0, 0) * At(1, 1) * At(2, 2) -
-                At(0, 0) * At(1, 2) * At(2, 1) -
-                At(1, 0) * At(0, 1) * At(2, 2) +
-                At(1, 0) * At(0, 2) * At(2, 1) +
-                At(2, 0) * At(0, 1) * At(1, 2) -
-                At(2, 0) * At(0, 2) * At(1, 1);
-
-            float det = At(0, 0) * invOut[0] + At(0, 1) * invOut[4] + At(0, 2) * invOut[8] + At(0, 3) * invOut[12];
+#ifdef USING_SIMD
+            if constexpr (std::is_same_v<F, float>) {
+                if !consteval {
+                    __m128 out[4];
+                    if (!detail::InverseSIMD(columns[0].vec, columns[1].vec, columns[2].vec, columns[3].vec, out)) {
+                        return Matrix{F(0)};
+                    }
+                    Matrix ret;
+                    for (uint8_t column = 0; column < 4; column++) {
+                        ret.columns[column].vec = out[column];
+                    }
+                    return ret;
+                }
+            }
+#endif
+            //each pair is the 2x2 determinant of two rows, over columns 2/3, 1/3 and 1/2
+            const F coef00 = columns[2][2] * columns[3][3] - columns[3][2] * columns[2][3];
+            const F coef02 = columns[1][2] * columns[3][3] - columns[3][2] * columns[1][3];
+            const F coef03 = columns[1][2] * columns[2][3] - columns[2][2] * columns[1][3];
+
+            const F coef04 = columns[2][1] * columns[3][3] - columns[3][1] * columns[2][3];
+            const F coef06 = columns[1][1] * columns[3][3] - columns[3][1] * columns[1][3];
+            const F coef07 = columns[1][1] * columns[2][3] - columns[2][1] * columns[1][3];
+
+            const F coef08 = columns[2][1] * columns[3][2] - columns[3][1] * columns[2][2];
+            const F coef10 = columns[1][1] * columns[3][2] - columns[3][1] * columns[1][2];
+            const F coef11 = columns[1][1] * columns[2][2] - columns[2][1] * columns[1][2];
+
+            const F coef12 = columns[2][0] * columns[3][3] - columns[3][0] * columns[2][3];
+            const F coef14 = columns[1][0] * columns[3][3] - columns[3][0] * columns[1][3];
+            const F coef15 = columns[1][0] * columns[2][3] - columns[2][0] * columns[1][3];
+
+            const F coef16 = columns[2][0] * columns[3][2] - columns[3][0] * columns[2][2];
+            const F coef18 = columns[1][0] * columns[3][2] - columns[3][0] * columns[1][2];
+            const F coef19 = columns[1][0] * columns[2][2] - columns[2][0] * columns[1][2];
+
+            const F coef20 = columns[2][0] * columns[3][1] - columns[3][0] * columns[2][1];
+            const F coef22 = columns[1][0] * columns[3][1] - columns[3][0] * columns[1][1];
+            const F coef23 = columns[1][0] * columns[2][1] - columns[2][0] * columns[1][1];
 
+            auto cofactor = [](F const vec0, F const fac0, F const vec1, F const fac1, F const vec2, F const fac2) {
+                return vec0 * fac0 - vec1 * fac1 + vec2 * fac2;
+            };
+            const F m0[4] = {columns[0][0], columns[0][1], columns[0][2], columns[0][3]};
+            const F m1[4] = {columns[1][0], columns[1][1], columns[1][2], columns[1][3]};
+
+            Matrix inv;
+            inv.columns[0] = ColType{
+                cofactor(m1[1], coef00, m1[2], coef04, m1[3], coef08),
+                -cofactor(m0[1], coef00, m0[2], coef04, m0[3], coef08),
+                cofactor(m0[1], coef02, m0[2], coef06, m0[3], coef10),
+                -cofactor(m0[1], coef03, m0[2], coef07, m0[3], coef11)
+            };
+            inv.columns[1] = ColType{
+                -cofactor(m1[0], coef00, m1[2], coef12, m1[3], coef16),
+                cofactor(m0[0], coef00, m0[2], coef12, m0[3], coef16),
+                -cofactor(m0[0], coef02, m0[2], coef14, m0[3], coef18),
+                cofactor(m0[0], coef03, m0[2], coef15, m0[3], coef19)
+            };
+            inv.columns[2] = ColType{
+                cofactor(m1[0], coef04, m1[1], coef12, m1[3], coef20),
+                -cofactor(m0[0], coef04, m0[1], coef12, m0[3], coef20),
+                cofactor(m0[0], coef06, m0[1], coef14, m0[3], coef22),
+                -cofactor(m0[0], coef07, m0[1], coef15, m0[3], coef23)
+            };
+            inv.columns[3] = ColType{
+                -cofactor(m1[0], coef08, m1[1], coef16, m1[2], coef20),
+                cofactor(m0[0], coef08, m0[1], coef16, m0[2], coef20),
+                -cofactor(m0[0], coef10, m0[1], coef18, m0[2], coef22),
+                cofactor(m0[0], coef11, m0[1], coef19, m0[2], coef23)
+            };
+
+            const F det = (m0[0] * inv.columns[0][0] + m0[1] * inv.columns[1][0]) + (m0[2] * inv.columns[2][0] + m0[3] * inv.columns[3][0]);
 //wrap this in a debug expression?
 #if LAB_DEBUGGING_FLOAT_ANOMALIES
             //if (lab::Abs(det) < 1e-6f)
 #endif
-            if (lab::Abs(det) < 1e-6f)
-                return {}; // Singular, return identity or zero
+            if (lab::Abs(det) < F(1e-6)) {
+                return Matrix{F(0)}; // Singular, return zero
+            }
 
-            det = 1.0f / det;
+            const F oneOverDet = F(1) / det;
+            for (uint8_t column = 0; column < 4; column++) {
+                for (uint8_t row = 0; row < 4; row++) {
+                    inv.columns[column][row] *= oneOverDet;
+                }
+            }
+            return inv;
+        }
 
-            float* dest = reinterpret_cast<float*>(&inv);
-            for (int i = 0; i < 16; i++)
-                dest[i] = invOut[i] * det;
+        //inverse of a transform built only from rotation, per axis scale and translation (T * R * S, no shear or projection)
+        //the 3x3 is inverted as transpose(R) / scale^2 per column, the translation is rotated back into the inverted space
+        //the result is wrong if the upper 3x3 columns arent orthogonal, use GetInverse for those
+        LAB_constexpr Matrix GetAffineInverse() const {
+#ifdef USING_SIMD
+            if constexpr (std::is_same_v<F, float>) {
+                if !consteval {
+                    Matrix ret;
+                    __m128 out[4];
+                    detail::AffineInverseSIMD(columns[0].vec, columns[1].vec, columns[2].vec, columns[3].vec, out);
+                    for (uint8_t column = 0; column < 4; column++) {
+                        ret.columns[column].vec = out[column];
+                    }
+                    return ret;
+                }
+            }
+#endif
+            F inverseSquaredScale[3];
+            for (uint8_t column = 0; column < 3; column++) {
+                inverseSquaredScale[column] = F(1) / ((columns[column][0] * columns[column][0] + columns[column][1] * columns[column][1]) + columns[column][2] * columns[column][2]);
+            }
 
+            Matrix inv;
+            for (uint8_t column = 0; column < 3; column++) {
+                for (uint8_t row = 0; row < 3; row++) {
+                    inv.columns[column][row] = columns[row][column] * inverseSquaredScale[row];
+                }
+                inv.columns[column][3] = F(0);
+            }
+            for (uint8_t row = 0; row < 3; row++) {
+                inv.columns[3][row] = -((inv.columns[0][row] * columns[3][0] + inv.columns[1][row] * columns[3][1]) + inv.columns[2][row] * columns[3][2]);
+            }
+            inv.columns[3][3] = F(1);
             return inv;
         }
     };
@@ -532,8 +661,7 @@ namespace lab {
         const F y = axis.y * invLen;
         const F z = axis.z * invLen;
 
-        const F c = Cos(angle);
-        const F s = Sin(angle);
+        const auto [s, c] = SinCos(angle);
         const F t = F(1) - c;
 
         return Matrix<F, 4, 4>{
@@ -545,12 +673,12 @@ namespace lab {
     }
 
     template<std::floating_point F>
-    Matrix<F, 4, 4> RotateAroundX(F const angle) {
-        F const cosine = Cos(angle);       
+    LAB_constexpr Matrix<F, 4, 4> RotateAroundX(F const angle) {
+        const auto [sinAngle, cosine] = SinCos(angle);
 #ifdef LAB_LEFT_HANDED
-        F const sine = -Sin(angle);
+        F const sine = -sinAngle;
 #else
-        F const sine = Sin(angle);
+        F const sine = sinAngle;
 #endif
     
         return Matrix<F, 4, 4>(
@@ -562,12 +690,12 @@ namespace lab {
     }
 
     template<std::floating_point F>
-    Matrix<F, 4, 4> RotateAroundY(F const angle) {
-        F const cosine = Cos(angle);       
+    LAB_constexpr Matrix<F, 4, 4> RotateAroundY(F const angle) {
+        const auto [sinAngle, cosine] = SinCos(angle);
 #ifdef LAB_LEFT_HANDED
-        F const sine = -Sin(angle);
+        F const sine = -sinAngle;
 #else
-        F const sine = Sin(angle);
+        F const sine = sinAngle;
 #endif
     
         return Matrix<F, 4, 4>(
@@ -578,12 +706,12 @@ namespace lab {
         );
     }
     template<std::floating_point F>
-    Matrix<F, 4, 4> RotateAroundZ(F const angle) {
-        F const cosine = Cos(angle);        
+    LAB_constexpr Matrix<F, 4, 4> RotateAroundZ(F const angle) {
+        const auto [sinAngle, cosine] = SinCos(angle);
 #ifdef LAB_LEFT_HANDED
-        F const sine = -Sin(angle);
+        F const sine = -sinAngle;
 #else
-        F const sine = Sin(angle);
+        F const sine = sinAngle;
 #endif
     
         return Matrix<F, 4, 4>(
@@ -0,0 +1,339 @@
+#pragma once
+#include "Matrix4x4.h"
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+//batched versions of the Matrix<F, 4, 4> operations
+//the matrix is loaded into registers once per call instead of once per element
+//every kernel adds in the same order as its scalar branch, so constexpr and runtime results match
+//input and output are allowed to be the same span
+
+namespace lab {
+    namespace detail {
+        //vec4 = c0 * x + c1 * y + c2 * z + c3 * w, written column wise so the scalar build can auto vectorize it
+        template<std::floating_point F>
+        LAB_constexpr Vector<F, 4> TransformScalar(Matrix<F, 4, 4> const& matrix, Vector<F, 4> const vec) {
+            return matrix.columns[0] * vec.x + matrix.columns[1] * vec.y + matrix.columns[2] * vec.z + matrix.columns[3] * vec.w;
+        }
+        //not matrix * vec4, its runtime branch adds the products pairwise and the tails have to match the lanes
+        template<std::floating_point F>
+        LAB_constexpr Vector<F, 3> TransformPointScalar(Matrix<F, 4, 4> const& matrix, Vector<F, 3> const point) {
+            return Vector<F, 3>{TransformScalar(matrix, Vector<F, 4>{point, F(1)})};
+        }
+        //the w column is left out instead of multiplied by 0, like the lanes. adding c3 * 0 would turn a -0 result into 0
+        template<std::floating_point F>
+        LAB_constexpr Vector<F, 3> TransformDirectionScalar(Matrix<F, 4, 4> const& matrix, Vector<F, 3> const dir) {
+            return Vector<F, 3>{matrix.columns[0] * dir.x + matrix.columns[1] * dir.y + matrix.columns[2] * dir.z};
+        }
+
+#ifdef USING_SIMD
+        template<bool IsPoint>
+        inline __m128 TransformLanes(__m128 const (&cols)[4], __m128 const x, __m128 const y, __m128 const z) {
+            __m128 ret = _mm_add_ps(_mm_mul_ps(cols[0], x), _mm_mul_ps(cols[1], y));
+            ret = _mm_add_ps(ret, _mm_mul_ps(cols[2], z));
+            if constexpr (IsPoint) {
+                ret = _mm_add_ps(ret, cols[3]);
+            }
+            return ret;
+        }
+
+        //vec3 spans are 12 byte strided, so 4 vectors are loaded as 3 registers and repacked on the way out
+        //all 3 registers are loaded before any store, which keeps in place transforms safe
+        template<bool IsPoint>
+        inline void TransformVec3Block(__m128 const (&cols)[4], float const* input, float* output) {
+            const __m128 a = _mm_loadu_ps(input);     //x0 y0 z0 x1
+            const __m128 b = _mm_loadu_ps(input + 4); //y1 z1 x2 y2
+            const __m128 c = _mm_loadu_ps(input + 8); //z2 x3 y3 z3
+
+            const __m128 r0 = TransformLanes<IsPoint>(cols,
+                _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)));
+            const __m128 r1 = TransformLanes<IsPoint>(cols,
+                _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1)));
+            const __m128 r2 = TransformLanes<IsPoint>(cols,
+                _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0)));
+            const __m128 r3 = TransformLanes<IsPoint>(cols,
+                _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3)));
+
+            //x0 y0 z0 x1
+            _mm_storeu_ps(output, _mm_blend_ps(r0, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(0, 0, 0, 0)), 0b1000));
+            //y1 z1 x2 y2
+            _mm_storeu_ps(output + 4, _mm_shuffle_ps(r1, r2, _MM_SHUFFLE(1, 0, 2, 1)));
+            //z2 x3 y3 z3
+            _mm_storeu_ps(output + 8, _mm_blend_ps(_mm_shuffle_ps(r3, r3, _MM_SHUFFLE(2, 1, 0, 0)), _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(2, 2, 2, 2)), 0b0001));
+        }
+
+        //matrices ahead of the current one to prefetch, a matrix is one cache line
+        inline constexpr std::size_t MultiplyPrefetchDistance = 8;
+
+#ifdef LAB_USING_AVX2
+        //both 128 bit halves hold the same column
+        inline void LoadDuplicatedColumns(Matrix<float, 4, 4> const& matrix, __m256 (&cols)[4]) {
+            for (uint8_t column = 0; column < 4; column++) {
+                cols[column] = _mm256_broadcast_ps(&matrix.columns[column].vec);
+            }
+        }
+        //two result columns, same add order as operator*
+        inline __m256 MultiplyColumnPair(__m256 const (&lhs)[4], __m256 const rhsPair) {
+            __m256 ret = _mm256_mul_ps(lhs[0], _mm256_permute_ps(rhsPair, _MM_SHUFFLE(0, 0, 0, 0)));
+            ret = _mm256_add_ps(ret, _mm256_mul_ps(lhs[1], _mm256_permute_ps(rhsPair, _MM_SHUFFLE(1, 1, 1, 1))));
+            ret = _mm256_add_ps(ret, _mm256_mul_ps(lhs[2], _mm256_permute_ps(rhsPair, _MM_SHUFFLE(2, 2, 2, 2))));
+            ret = _mm256_add_ps(ret, _mm256_mul_ps(lhs[3], _mm256_permute_ps(rhsPair, _MM_SHUFFLE(3, 3, 3, 3))));
+            return ret;
+        }
+#else
+        inline __m128 MultiplyColumn(__m128 const (&lhs)[4], __m128 const rhs) {
+            __m128 ret = _mm_mul_ps(lhs[0], _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(0, 0, 0, 0)));
+            ret = _mm_add_ps(ret, _mm_mul_ps(lhs[1], _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 1, 1, 1))));
+            ret = _mm_add_ps(ret, _mm_mul_ps(lhs[2], _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(2, 2, 2, 2))));
+            ret = _mm_add_ps(ret, _mm_mul_ps(lhs[3], _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 3, 3, 3))));
+            return ret;
+        }
+#endif
+
+        //a broadcast side is a single matrix, loaded once outside the loop
+        //a Matrix<float, 4, 4> is 32 byte aligned with AVX2, so its column pairs are aligned loads and stores
+        //every input of a matrix is loaded before its result is stored, so out can alias lhs or rhs
+        template<bool BroadcastLhs, bool BroadcastRhs>
+        inline void MultiplyBatchSIMD(Matrix<float, 4, 4> const* lhs, Matrix<float, 4, 4> const* rhs, Matrix<float, 4, 4>* out, std::size_t const count) {
+#ifdef LAB_USING_AVX2
+            __m256 lhsCols[4];
+            __m256 rhsPairs[2];
+            if constexpr (BroadcastLhs) {
+                LoadDuplicatedColumns(*lhs, lhsCols);
+            }
+            if constexpr (BroadcastRhs) {
+                rhsPairs[0] = _mm256_load_ps(reinterpret_cast<float const*>(&rhs->columns[0]));
+                rhsPairs[1] = _mm256_load_ps(reinterpret_cast<float const*>(&rhs->columns[2]));
+            }
+#else
+            __m128 lhsCols[4];
+            __m128 rhsCols[4];
+            if constexpr (BroadcastLhs) {
+                for (uint8_t column = 0; column < 4; column++) {
+                    lhsCols[column] = lhs->columns[column].vec;
+                }
+            }
+            if constexpr (BroadcastRhs) {
+                for (uint8_t column = 0; column < 4; column++) {
+                    rhsCols[column] = rhs->columns[column].vec;
+                }
+            }
+#endif
+            for (std::size_t i = 0; i < count; i++) {
+                if (i + MultiplyPrefetchDistance < count) {
+                    if constexpr (!BroadcastLhs) {
+                        _mm_prefetch(reinterpret_cast<char const*>(lhs + i + MultiplyPrefetchDistance), _MM_HINT_T0);
+                    }
+                    if constexpr (!BroadcastRhs) {
+                        _mm_prefetch(reinterpret_cast<char const*>(rhs + i + MultiplyPrefetchDistance), _MM_HINT_T0);
+                    }
+                }
+#ifdef LAB_USING_AVX2
+                if constexpr (!BroadcastLhs) {
+                    LoadDuplicatedColumns(lhs[i], lhsCols);
+                }
+                if constexpr (!BroadcastRhs) {
+                    rhsPairs[0] = _mm256_load_ps(reinterpret_cast<float const*>(&rhs[i].columns[0]));
+                    rhsPairs[1] = _mm256_load_ps(reinterpret_cast<float const*>(&rhs[i].columns[2]));
+                }
+                const __m256 result01 = MultiplyColumnPair(lhsCols, rhsPairs[0]);
+                const __m256 result23 = MultiplyColumnPair(lhsCols, rhsPairs[1]);
+                _mm256_store_ps(reinterpret_cast<float*>(&out[i].columns[0]), result01);
+                _mm256_store_ps(reinterpret_cast<float*>(&out[i].columns[2]), result23);
+#else
+                for (uint8_t column = 0; column < 4; column++) {
+                    if constexpr (!BroadcastLhs) {
+                        lhsCols[column] = lhs[i].columns[column].vec;
+                    }
+                    if constexpr (!BroadcastRhs) {
+                        rhsCols[column] = rhs[i].columns[column].vec;
+                    }
+                }
+                for (uint8_t column = 0; column < 4; column++) {
+                    out[i].columns[column].vec = MultiplyColumn(lhsCols, rhsCols[column]);
+                }
+#endif
+            }
+        }
+
+#ifdef LAB_USING_AVX2
+        //8 vec3s as x, y and z lanes, each output row is the matrix row broadcast across the lanes. same add order as TransformLanes
+        template<bool IsPoint>
+        inline void TransformVec3Block8(Matrix<float, 4, 4> const& matrix, float const* input, float* output) {
+            SIMD::Float lanes[3];
+            SIMD::LoadVec3s(input, lanes);
+            SIMD::Float result[3];
+            for (uint8_t row = 0; row < 3; row++) {
+                SIMD::Float ret = SIMD::Add(SIMD::Mul(SIMD::Set1(matrix.columns[0].component[row]), lanes[0]), SIMD::Mul(SIMD::Set1(matrix.columns[1].component[row]), lanes[1]));
+                ret = SIMD::Add(ret, SIMD::Mul(SIMD::Set1(matrix.columns[2].component[row]), lanes[2]));
+                if constexpr (IsPoint) {
+                    ret = SIMD::Add(ret, SIMD::Set1(matrix.columns[3].component[row]));
+                }
+                result[row] = ret;
+            }
+            SIMD::StoreVec3s(output, result);
+        }
+#endif
+
+        //AVX2 does 8 vectors per step, then SSE finishes with blocks of 4
+        template<bool IsPoint>
+        inline std::size_t TransformVec3SIMD(Matrix<float, 4, 4> const& matrix, Vector<float, 3> const* input, Vector<float, 3>* output, std::size_t const count) {
+            std::size_t i = 0;
+#ifdef LAB_USING_AVX2
+            for (; i + 8 <= count; i += 8) {
+                TransformVec3Block8<IsPoint>(matrix, &input[i].x, &output[i].x);
+            }
+#endif
+            const __m128 cols[4] = { matrix.columns[0].vec, matrix.columns[1].vec, matrix.columns[2].vec, matrix.columns[3].vec };
+            for (; i + 4 <= count; i += 4) {
+                TransformVec3Block<IsPoint>(cols, &input[i].x, &output[i].x);
+            }
+            return i;
+        }
+#endif
+    }
+
+    template<std::floating_point F>
+    LAB_constexpr void TransformPoints(Matrix<F, 4, 4> const& matrix, std::type_identity_t<std::span<const Vector<F, 4>>> const input, std::type_identity_t<std::span<Vector<F, 4>>> const output) {
+#if LAB_DEBUGGING_ACCESS
+        assert(output.size() >= input.size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+#ifdef LAB_USING_AVX2
+                const VectorSIMD8 col0{matrix.columns[0], matrix.columns[0]};
+                const VectorSIMD8 col1{matrix.columns[1], matrix.columns[1]};
+                const VectorSIMD8 col2{matrix.columns[2], matrix.columns[2]};
+                const VectorSIMD8 col3{matrix.columns[3], matrix.columns[3]};
+                for (; i + 2 <= input.size(); i += 2) {
+                    const VectorSIMD8 vecs{_mm256_loadu_ps(&input[i].x)};
+                    const VectorSIMD8 result = col0 * vecs.BroadcastLane<0>() + col1 * vecs.BroadcastLane<1>() + col2 * vecs.BroadcastLane<2>() + col3 * vecs.BroadcastLane<3>();
+                    _mm256_storeu_ps(&output[i].x, result.vec);
+                }
+#else
+                const __m128 cols[4] = { matrix.columns[0].vec, matrix.columns[1].vec, matrix.columns[2].vec, matrix.columns[3].vec };
+                for (; i < input.size(); i++) {
+                    const __m128 vec = _mm_loadu_ps(&input[i].x);
+                    __m128 result = _mm_add_ps(_mm_mul_ps(cols[0], _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(0, 0, 0, 0))), _mm_mul_ps(cols[1], _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 1, 1, 1))));
+                    result = _mm_add_ps(result, _mm_mul_ps(cols[2], _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(2, 2, 2, 2))));
+                    result = _mm_add_ps(result, _mm_mul_ps(cols[3], _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(3, 3, 3, 3))));
+                    _mm_storeu_ps(&output[i].x, result);
+                }
+#endif
+            }
+        }
+#endif
+        //local copy, otherwise the stores through output force the matrix to be reloaded every iteration
+        const Matrix<F, 4, 4> mat = matrix;
+        for (; i < input.size(); i++) {
+            output[i] = detail::TransformScalar(mat, input[i]);
+        }
+    }
+
+    //w is treated as 1, there is no perspective divide
+    template<std::floating_point F>
+    LAB_constexpr void TransformPoints(Matrix<F, 4, 4> const& matrix, std::type_identity_t<std::span<const Vector<F, 3>>> const input, std::type_identity_t<std::span<Vector<F, 3>>> const output) {
+#if LAB_DEBUGGING_ACCESS
+        assert(output.size() >= input.size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                i = detail::TransformVec3SIMD<true>(matrix, input.data(), output.data(), input.size());
+            }
+        }
+#endif
+        //local copy, otherwise the stores through output force the matrix to be reloaded every iteration
+        const Matrix<F, 4, 4> mat = matrix;
+        for (; i < input.size(); i++) {
+            output[i] = detail::TransformPointScalar(mat, input[i]);
+        }
+    }
+
+    //w is treated as 0, translation is ignored
+    template<std::floating_point F>
+    LAB_constexpr void TransformDirections(Matrix<F, 4, 4> const& matrix, std::type_identity_t<std::span<const Vector<F, 3>>> const input, std::type_identity_t<std::span<Vector<F, 3>>> const output) {
+#if LAB_DEBUGGING_ACCESS
+        assert(output.size() >= input.size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                i = detail::TransformVec3SIMD<false>(matrix, input.data(), output.data(), input.size());
+            }
+        }
+#endif
+        //local copy, otherwise the stores through output force the matrix to be reloaded every iteration
+        const Matrix<F, 4, 4> mat = matrix;
+        for (; i < input.size(); i++) {
+            output[i] = detail::TransformDirectionScalar(mat, input[i]);
+        }
+    }
+
+    //out[i] = lhs[i] * rhs[i], bit identical to calling operator* per matrix
+    //out may be the same span as lhs or rhs. F isnt deduced from spans, call it as MultiplyBatch<float>(lhs, rhs, out)
+    template<std::floating_point F>
+    LAB_constexpr void MultiplyBatch(std::type_identity_t<std::span<const Matrix<F, 4, 4>>> const lhs, std::type_identity_t<std::span<const Matrix<F, 4, 4>>> const rhs, std::type_identity_t<std::span<Matrix<F, 4, 4>>> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(lhs.size() == rhs.size());
+        assert(out.size() >= lhs.size());
+#endif
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                detail::MultiplyBatchSIMD<false, false>(lhs.data(), rhs.data(), out.data(), lhs.size());
+                return;
+            }
+        }
+#endif
+        for (std::size_t i = 0; i < lhs.size(); i++) {
+            out[i] = lhs[i] * rhs[i];
+        }
+    }
+
+    //out[i] = lhs * rhs[i], one parent against many locals
+    template<std::floating_point F>
+    LAB_constexpr void MultiplyBatch(Matrix<F, 4, 4> const& lhs, std::type_identity_t<std::span<const Matrix<F, 4, 4>>> const rhs, std::type_identity_t<std::span<Matrix<F, 4, 4>>> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(out.size() >= rhs.size());
+#endif
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                detail::MultiplyBatchSIMD<true, false>(&lhs, rhs.data(), out.data(), rhs.size());
+                return;
+            }
+        }
+#endif
+        const Matrix<F, 4, 4> mat = lhs;
+        for (std::size_t i = 0; i < rhs.size(); i++) {
+            out[i] = mat * rhs[i];
+        }
+    }
+
+    //out[i] = lhs[i] * rhs, many matrices against one
+    template<std::floating_point F>
+    LAB_constexpr void MultiplyBatch(std::type_identity_t<std::span<const Matrix<F, 4, 4>>> const lhs, Matrix<F, 4, 4> const& rhs, std::type_identity_t<std::span<Matrix<F, 4, 4>>> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(out.size() >= lhs.size());
+#endif
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                detail::MultiplyBatchSIMD<false, true>(lhs.data(), &rhs, out.data(), lhs.size());
+                return;
+            }
+        }
+#endif
+        const Matrix<F, 4, 4> mat = rhs;
+        for (std::size_t i = 0; i < lhs.size(); i++) {
+            out[i] = lhs[i] * mat;
+        }
+    }
+}
@@ -2,6 +2,9 @@
 
 #include "Vector.h"
 #include "Matrix.h"
+#include "Quaternion/QuaternionSIMD.h"
+
+#include <type_traits>
 
 namespace lab{
     //this is row major and left handed, while the rest of the lib is right handed and column major. idk when I'll fix it
@@ -21,7 +24,7 @@ namespace lab{
             const F trace = matrix.At(0, 0) + matrix.At(1, 1) + matrix.At(2, 2) + F(1);
 
             if (trace > F(1)) {
-                const F s = F(2) * sqrt(trace);
+                const F s = F(2) * lab::Sqrt(trace);
                 x = (matrix.At(1, 2) - matrix.At(2, 1)) / s;
                 y = (matrix.At(2, 0) - matrix.At(0, 2)) / s;
                 z = (matrix.At(0, 1) - matrix.At(1, 0)) / s;
@@ -34,7 +37,7 @@ namespace lab{
 
                 switch (maxi) {
                 case 0: {
-                    const F s = F(2) * sqrt(F(1) + matrix.At(0, 0) - matrix.At(1, 1) - matrix.At(2, 2));
+                    const F s = F(2) * lab::Sqrt(F(1) + matrix.At(0, 0) - matrix.At(1, 1) - matrix.At(2, 2));
                     x = F(0.25) * s;
                     y = (matrix.At(0, 1) + matrix.At(1, 0)) / s;
                     z = (matrix.At(0, 2) + matrix.At(2, 0)) / s;
@@ -42,7 +45,7 @@ namespace lab{
                     break;
                 }
                 case 1: {
-                    const F s = F(2) * sqrt(F(1) + matrix.At(1, 1) - matrix.At(0, 0) - matrix.At(2, 2));
+                    const F s = F(2) * lab::Sqrt(F(1) + matrix.At(1, 1) - matrix.At(0, 0) - matrix.At(2, 2));
                     x = (matrix.At(0, 1) + matrix.At(1, 0)) / s;
                     y = F(0.25) * s;
                     z = (matrix.At(1, 2) + matrix.At(2, 1)) / s;
@@ -50,7 +53,7 @@ namespace lab{
                     break;
                 }
                 default: {
-                    const F s = F(2) * sqrt(F(1) + matrix.At(2, 2) - matrix.At(0, 0) - matrix.At(1, 1));
+                    const F s = F(2) * lab::Sqrt(F(1) + matrix.At(2, 2) - matrix.At(0, 0) - matrix.At(1, 1));
                     x = (matrix.At(0, 2) + matrix.At(2, 0)) / s;
                     y = (matrix.At(1, 2) + matrix.At(2, 1)) / s;
                     z = F(0.25) * s;
@@ -65,6 +68,18 @@ namespace lab{
 			return Quaternion(matrix);
 		}
 
+#ifdef USING_SIMD
+        //x y z w are contiguous, so the quaternion loads straight into an __m128
+        static Quaternion FromSIMD(__m128 const vec) requires(std::is_same_v<F, float>) {
+            Quaternion ret;
+            _mm_storeu_ps(&ret.x, vec);
+            return ret;
+        }
+        __m128 ToSIMD() const requires(std::is_same_v<F, float>) {
+            return _mm_loadu_ps(&x);
+        }
+#endif
+
         LAB_constexpr F SquaredMagnitude() const{
             return x * x + y * y + z * z + w * w;
         }
@@ -72,19 +87,22 @@ namespace lab{
             return lab::Sqrt(SquaredMagnitude());
         }
         LAB_constexpr void Normalize(){
-            const F magnitude = Magnitude();
-            x /= magnitude;
-            y /= magnitude;
-            z /= magnitude;
-            w /= magnitude;
+            *this = Normalized();
         }
         LAB_constexpr Quaternion Normalized() const{
-            const F magnitude = Magnitude();
+#ifdef USING_SIMD
+            if !consteval {
+                if constexpr (std::is_same_v<F, float>) {
+                    return FromSIMD(detail::QuaternionNormalizeSIMD(ToSIMD()));
+                }
+            }
+#endif
+            const F invMag = lab::InverseSqrt(SquaredMagnitude());
             return {
-                x / magnitude,
-                y / magnitude,
-                z / magnitude,
-                w / magnitude
+                x * invMag,
+                y * invMag,
+                z * invMag,
+                w * invMag
             };
         }
 
@@ -131,6 +149,13 @@ namespace lab{
 
         //cml copy
         LAB_constexpr Quaternion operator*(Quaternion const& other) const{
+#ifdef USING_SIMD
+            if !consteval {
+                if constexpr (std::is_same_v<F, float>) {
+                    return FromSIMD(detail::QuaternionMultiplySIMD(ToSIMD(), other.ToSIMD()));
+                }
+            }
+#endif
             return Quaternion {
 
                 (other.w * x) + (other.x * w) + (other.y * z) - (other.z * y),
@@ -150,7 +175,28 @@ namespace lab{
         }
 
         
+        //rotates by the same rotation as ToMat4, without building the matrix
+        //vec + w * t + axis x t, where t = 2 * (axis x vec)
+        LAB_constexpr Vector<F, 3> RotateVector(Vector<F, 3> const vec) const {
+            const Vector<F, 3> axis{x, y, z};
+            const Vector<F, 3> t = axis.Cross(vec) * F(2);
+            return vec + t * w + axis.Cross(t);
+        }
+
         LAB_constexpr Matrix<F, 4, 4> ToMat4() const {
+#ifdef USING_SIMD
+            if !consteval {
+                if constexpr (std::is_same_v<F, float>) {
+                    Matrix<F, 4, 4> ret;
+                    __m128 cols[4];
+                    detail::QuaternionToMat4SIMD(ToSIMD(), cols);
+                    for (uint8_t column = 0; column < 4; column++) {
+                        ret.columns[column].vec = cols[column];
+                    }
+                    return ret;
+                }
+            }
+#endif
             Matrix<F, 4, 4> ret{};
             const Quaternion reflected = this->operator-();
 
@@ -233,8 +279,7 @@ namespace lab{
             const Vector<F, 3> normAxis = axis.Normalized();
 
             const F halfAngle = angle * 0.5f;
-            const F sinHalf = lab::Sin(halfAngle);
-            const F cosHalf = lab::Cos(halfAngle);
+            const auto [sinHalf, cosHalf] = lab::SinCos(halfAngle);
 
             return Quaternion{
                 normAxis.x * sinHalf,
@@ -261,6 +306,32 @@ namespace lab{
         static LAB_constexpr Quaternion Slerp(Quaternion const& q1, Quaternion const& q2, F const weight) {
             return Mix(q1, q2, weight);
         }
+
+        //normalized lerp along the shortest path, no trig and no branches
+        //the rotation is right at 0, 0.5 and 1, in between nlerp's speed isnt constant, it's slow near the ends and fast in the middle
+        //max angular error against Mix is 0.142 rad (8.1 degrees), at the widest angle (q1 and q2 180 degrees apart)
+        //it shrinks quickly with the angle, so it's fine for blending nearby poses
+        static LAB_constexpr Quaternion Nlerp(Quaternion const& q1, Quaternion const& q2, F const weight) {
+            //flipping the weight is the same as flipping q2
+            const F weight2 = q1.Dot(q2) < F(0) ? -weight : weight;
+            return ((q1 * (F(1) - weight)) + (q2 * weight2)).Normalized();
+        }
+
+        //the error numbers here and on FastSlerp come from the LinearAlgebraAccuracy target
+        //nlerp with the weight corrected by a polynomial fit to slerp (zeux.io, "approximating slerp")
+        //max angular error is 0.0010 rad against Mix, and 0.00077 rad against an exact slerp
+        //that is below Mix's own error from ArcCos/Sin, which is 0.0010 rad against an exact slerp
+        static LAB_constexpr Quaternion FastSlerp(Quaternion const& q1, Quaternion const& q2, F const weight) {
+            const F dot = q1.Dot(q2);
+            const F absDot = dot < F(0) ? -dot : dot;
+            const F ca = F(1.0904) + absDot * (F(-3.2452) + absDot * (F(3.55645) - absDot * F(1.43519)));
+            const F cb = F(0.848013) + absDot * (F(-1.06021) + absDot * F(0.215638));
+            const F centered = weight - F(0.5);
+            const F k = ca * centered * centered + cb;
+            const F adjusted = weight + weight * centered * (weight - F(1)) * k;
+            const F weight2 = dot < F(0) ? -adjusted : adjusted;
+            return ((q1 * (F(1) - adjusted)) + (q2 * weight2)).Normalized();
+        }
     };
 
     using Quat = Quaternion<float>;
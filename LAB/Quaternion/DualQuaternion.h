@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../Quaternion.h"
+
+namespace lab {
+    //a rigid transform, rotation then translation, as real + dual * epsilon
+    //the real part is the rotation, the dual part is 0.5 * (translation, 0) * real as a hamilton product
+    //only rotation and translation survive the conversion, a matrix with scale or shear loses it
+    template<std::floating_point F>
+    struct DualQuaternion {
+        Quaternion<F> real;
+        Quaternion<F> dual;
+
+        LAB_constexpr DualQuaternion() : real{F(0), F(0), F(0), F(1)}, dual{} {}
+        LAB_constexpr DualQuaternion(Quaternion<F> const& real, Quaternion<F> const& dual) : real{real}, dual{dual} {}
+
+        //rotation is expected to be normalized
+        static LAB_constexpr DualQuaternion FromRotationTranslation(Quaternion<F> const& rotation, Vector<F, 3> const translation) {
+            const Vector<F, 3> axis{rotation.x, rotation.y, rotation.z};
+            const Vector<F, 3> dualAxis = (translation * rotation.w + translation.Cross(axis)) * F(0.5);
+            return DualQuaternion{
+                rotation,
+                Quaternion<F>{dualAxis.x, dualAxis.y, dualAxis.z, -translation.Dot(axis) * F(0.5)}
+            };
+        }
+        static LAB_constexpr DualQuaternion FromMatrix(Matrix<F, 4, 4> const& matrix) {
+            return FromRotationTranslation(Quaternion<F>::FromMatrix(matrix), Vector<F, 3>{matrix.At(3, 0), matrix.At(3, 1), matrix.At(3, 2)});
+        }
+
+        LAB_constexpr Vector<F, 3> GetTranslation() const {
+            const Vector<F, 3> axis{real.x, real.y, real.z};
+            const Vector<F, 3> dualAxis{dual.x, dual.y, dual.z};
+            return (dualAxis * real.w - axis * dual.w + axis.Cross(dualAxis)) * F(2);
+        }
+
+        //divides both parts by the magnitude of the real part, which is what a blend of unit dual quaternions needs
+        LAB_constexpr DualQuaternion Normalized() const {
+            const F invMag = lab::InverseSqrt(real.SquaredMagnitude());
+            return DualQuaternion{real * invMag, dual * invMag};
+        }
+
+        //both expect a normalized dual quaternion
+        LAB_constexpr Vector<F, 3> TransformPoint(Vector<F, 3> const point) const {
+            return real.RotateVector(point) + GetTranslation();
+        }
+        LAB_constexpr Vector<F, 3> TransformDirection(Vector<F, 3> const direction) const {
+            return real.RotateVector(direction);
+        }
+
+        LAB_constexpr DualQuaternion operator+(DualQuaternion const& other) const {
+            return DualQuaternion{real + other.real, dual + other.dual};
+        }
+        LAB_constexpr DualQuaternion operator*(F const multiplier) const {
+            return DualQuaternion{real * multiplier, dual * multiplier};
+        }
+    };
+
+    using DualQuat = DualQuaternion<float>;
+}
@@ -0,0 +1,233 @@
+#pragma once
+#include "../Quaternion.h"
+#include "../Support/SIMD.h"
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+//batched versions of the Quaternion<F> operations, for animation workloads (one quaternion per bone or instance)
+//the SIMD kernels transpose 4 (8 with AVX2) quaternions into x y z w registers, so every lane runs the scalar member's math in its order
+//results are bit identical to calling the member per element. Normalize goes through InverseSqrt, see Support/Sqrt.h
+//the SIMD path is float only, double and the leftover tail go through the scalar members
+//input and output are allowed to be the same span
+
+namespace lab {
+    namespace detail {
+#ifdef USING_SIMD
+        inline void QuaternionMultiplyLanes(SIMD::Float const (&lhs)[4], SIMD::Float const (&rhs)[4], SIMD::Float (&out)[4]) {
+            out[0] = SIMD::Sub(SIMD::Add(SIMD::Add(SIMD::Mul(rhs[3], lhs[0]), SIMD::Mul(rhs[0], lhs[3])), SIMD::Mul(rhs[1], lhs[2])), SIMD::Mul(rhs[2], lhs[1]));
+            out[1] = SIMD::Add(SIMD::Add(SIMD::Sub(SIMD::Mul(rhs[3], lhs[1]), SIMD::Mul(rhs[0], lhs[2])), SIMD::Mul(rhs[1], lhs[3])), SIMD::Mul(rhs[2], lhs[0]));
+            out[2] = SIMD::Add(SIMD::Sub(SIMD::Add(SIMD::Mul(rhs[3], lhs[2]), SIMD::Mul(rhs[0], lhs[1])), SIMD::Mul(rhs[1], lhs[0])), SIMD::Mul(rhs[2], lhs[3]));
+            out[3] = SIMD::Sub(SIMD::Sub(SIMD::Sub(SIMD::Mul(rhs[3], lhs[3]), SIMD::Mul(rhs[0], lhs[0])), SIMD::Mul(rhs[1], lhs[1])), SIMD::Mul(rhs[2], lhs[2]));
+        }
+
+        //lane for lane the same as (a.yzx * b.zxy) - (a.zxy * b.yzx)
+        inline void CrossLanes(SIMD::Float const ax, SIMD::Float const ay, SIMD::Float const az, SIMD::Float const (&b)[3], SIMD::Float (&out)[3]) {
+            out[0] = SIMD::Sub(SIMD::Mul(ay, b[2]), SIMD::Mul(az, b[1]));
+            out[1] = SIMD::Sub(SIMD::Mul(az, b[0]), SIMD::Mul(ax, b[2]));
+            out[2] = SIMD::Sub(SIMD::Mul(ax, b[1]), SIMD::Mul(ay, b[0]));
+        }
+
+        //shared tail of Nlerp and FastSlerp, (q1 * (1 - weight)) + (q2 * +-weight) normalized
+        template<bool Fast>
+        inline void InterpolateLanes(SIMD::Float const (&q1)[4], SIMD::Float const (&q2)[4], SIMD::Float weight, SIMD::Float (&out)[4]) {
+            const SIMD::Float zero = SIMD::Set1(0.f);
+            const SIMD::Float negativeOne = SIMD::Set1(-1.f);
+            const SIMD::Float dot = SIMD::Add(SIMD::Add(SIMD::Add(SIMD::Mul(q1[0], q2[0]), SIMD::Mul(q1[1], q2[1])), SIMD::Mul(q1[2], q2[2])), SIMD::Mul(q1[3], q2[3]));
+            const SIMD::Float negativeDot = SIMD::Less(dot, zero);
+            if constexpr (Fast) {
+                const SIMD::Float absDot = SIMD::Select(negativeDot, SIMD::Mul(dot, negativeOne), dot);
+                SIMD::Float ca = SIMD::Sub(SIMD::Set1(float(3.55645)), SIMD::Mul(absDot, SIMD::Set1(float(1.43519))));
+                ca = SIMD::Add(SIMD::Set1(float(1.0904)), SIMD::Mul(absDot, SIMD::Add(SIMD::Set1(float(-3.2452)), SIMD::Mul(absDot, ca))));
+                const SIMD::Float cb = SIMD::Add(SIMD::Set1(float(0.848013)), SIMD::Mul(absDot, SIMD::Add(SIMD::Set1(float(-1.06021)), SIMD::Mul(absDot, SIMD::Set1(float(0.215638))))));
+                const SIMD::Float centered = SIMD::Sub(weight, SIMD::Set1(0.5f));
+                const SIMD::Float k = SIMD::Add(SIMD::Mul(SIMD::Mul(ca, centered), centered), cb);
+                weight = SIMD::Add(weight, SIMD::Mul(SIMD::Mul(SIMD::Mul(weight, centered), SIMD::Sub(weight, SIMD::Set1(1.f))), k));
+            }
+            const SIMD::Float weight1 = SIMD::Sub(SIMD::Set1(1.f), weight);
+            //multiplying by -1 flips the sign exactly, zeros included, the same as the scalar negate
+            const SIMD::Float weight2 = SIMD::Select(negativeDot, SIMD::Mul(weight, negativeOne), weight);
+            for (uint8_t c = 0; c < 4; c++) {
+                out[c] = SIMD::Add(SIMD::Mul(q1[c], weight1), SIMD::Mul(q2[c], weight2));
+            }
+            const SIMD::Float sqrdMag = SIMD::Add(SIMD::Add(SIMD::Add(SIMD::Mul(out[0], out[0]), SIMD::Mul(out[1], out[1])), SIMD::Mul(out[2], out[2])), SIMD::Mul(out[3], out[3]));
+            const SIMD::Float invMag = SIMD::InverseSqrt(sqrdMag);
+            for (uint8_t c = 0; c < 4; c++) {
+                out[c] = SIMD::Mul(out[c], invMag);
+            }
+        }
+#endif
+
+        //weights is either one weight per pair, or a single weight for every pair
+        template<bool Fast, std::floating_point F>
+        LAB_constexpr void InterpolateBatch(std::span<const Quaternion<F>> const lhs, std::span<const Quaternion<F>> const rhs, std::span<const F> const weights, std::span<Quaternion<F>> const out) {
+#if LAB_DEBUGGING_ACCESS
+            assert(lhs.size() == rhs.size());
+            assert(out.size() >= lhs.size());
+            assert(weights.size() == lhs.size() || weights.size() == 1);
+#endif
+            const bool singleWeight = weights.size() == 1;
+            std::size_t i = 0;
+#ifdef USING_SIMD
+            if !consteval {
+                if constexpr (std::is_same_v<F, float>) {
+                    const SIMD::Float broadcastWeight = SIMD::Set1(singleWeight ? weights[0] : 0.f);
+                    for (; i + SIMD::FloatWidth <= lhs.size(); i += SIMD::FloatWidth) {
+                        SIMD::Float lhsLanes[4];
+                        SIMD::Float rhsLanes[4];
+                        SIMD::LoadTransposed(&lhs[i].x, 4, lhsLanes);
+                        SIMD::LoadTransposed(&rhs[i].x, 4, rhsLanes);
+                        const SIMD::Float weight = singleWeight ? broadcastWeight : SIMD::LoadU(&weights[i]);
+                        SIMD::Float result[4];
+                        InterpolateLanes<Fast>(lhsLanes, rhsLanes, weight, result);
+                        SIMD::StoreTransposed(&out[i].x, 4, result);
+                    }
+                }
+            }
+#endif
+            for (; i < lhs.size(); i++) {
+                const F weight = singleWeight ? weights[0] : weights[i];
+                if constexpr (Fast) {
+                    out[i] = Quaternion<F>::FastSlerp(lhs[i], rhs[i], weight);
+                }
+                else {
+                    out[i] = Quaternion<F>::Nlerp(lhs[i], rhs[i], weight);
+                }
+            }
+        }
+    }
+
+    //out[i] = lhs[i] * rhs[i]
+    //F isnt deduced from spans, call it as MultiplyBatch<float>(lhs, rhs, out)
+    template<std::floating_point F>
+    LAB_constexpr void MultiplyBatch(std::type_identity_t<std::span<const Quaternion<F>>> const lhs, std::type_identity_t<std::span<const Quaternion<F>>> const rhs, std::type_identity_t<std::span<Quaternion<F>>> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(lhs.size() == rhs.size());
+        assert(out.size() >= lhs.size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                for (; i + SIMD::FloatWidth <= lhs.size(); i += SIMD::FloatWidth) {
+                    SIMD::Float lhsLanes[4];
+                    SIMD::Float rhsLanes[4];
+                    SIMD::LoadTransposed(&lhs[i].x, 4, lhsLanes);
+                    SIMD::LoadTransposed(&rhs[i].x, 4, rhsLanes);
+                    SIMD::Float result[4];
+                    detail::QuaternionMultiplyLanes(lhsLanes, rhsLanes, result);
+                    SIMD::StoreTransposed(&out[i].x, 4, result);
+                }
+            }
+        }
+#endif
+        for (; i < lhs.size(); i++) {
+            out[i] = lhs[i] * rhs[i];
+        }
+    }
+
+    template<std::floating_point F>
+    LAB_constexpr void NormalizeBatch(std::type_identity_t<std::span<const Quaternion<F>>> const input, std::type_identity_t<std::span<Quaternion<F>>> const output) {
+#if LAB_DEBUGGING_ACCESS
+        assert(output.size() >= input.size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                for (; i + SIMD::FloatWidth <= input.size(); i += SIMD::FloatWidth) {
+                    SIMD::Float lanes[4];
+                    SIMD::LoadTransposed(&input[i].x, 4, lanes);
+                    const SIMD::Float sqrdMag = SIMD::Add(SIMD::Add(SIMD::Add(SIMD::Mul(lanes[0], lanes[0]), SIMD::Mul(lanes[1], lanes[1])), SIMD::Mul(lanes[2], lanes[2])), SIMD::Mul(lanes[3], lanes[3]));
+                    const SIMD::Float invMag = SIMD::InverseSqrt(sqrdMag);
+                    for (uint8_t c = 0; c < 4; c++) {
+                        lanes[c] = SIMD::Mul(lanes[c], invMag);
+                    }
+                    SIMD::StoreTransposed(&output[i].x, 4, lanes);
+                }
+            }
+        }
+#endif
+        for (; i < input.size(); i++) {
+            output[i] = input[i].Normalized();
+        }
+    }
+
+    //out[i] = quats[i].RotateVector(vectors[i])
+    template<std::floating_point F>
+    LAB_constexpr void RotateVectorBatch(std::type_identity_t<std::span<const Quaternion<F>>> const quats, std::type_identity_t<std::span<const Vector<F, 3>>> const vectors, std::type_identity_t<std::span<Vector<F, 3>>> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(quats.size() == vectors.size());
+        assert(out.size() >= vectors.size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                const SIMD::Float two = SIMD::Set1(2.f);
+                for (; i + SIMD::FloatWidth <= quats.size(); i += SIMD::FloatWidth) {
+                    SIMD::Float quat[4];
+                    SIMD::Float vec[3];
+                    SIMD::LoadTransposed(&quats[i].x, 4, quat);
+                    SIMD::LoadVec3s(&vectors[i].x, vec);
+
+                    SIMD::Float t[3];
+                    detail::CrossLanes(quat[0], quat[1], quat[2], vec, t);
+                    for (uint8_t c = 0; c < 3; c++) {
+                        t[c] = SIMD::Mul(t[c], two);
+                    }
+                    SIMD::Float axisCrossT[3];
+                    detail::CrossLanes(quat[0], quat[1], quat[2], t, axisCrossT);
+                    for (uint8_t c = 0; c < 3; c++) {
+                        vec[c] = SIMD::Add(SIMD::Add(vec[c], SIMD::Mul(t[c], quat[3])), axisCrossT[c]);
+                    }
+                    SIMD::StoreVec3s(&out[i].x, vec);
+                }
+            }
+        }
+#endif
+        for (; i < quats.size(); i++) {
+            out[i] = quats[i].RotateVector(vectors[i]);
+        }
+    }
+
+    //ToMat4 is already one register in and four out with SIMD, and the loop is bound by the 64 byte stores
+    //a transposed kernel measured no faster, so this is the member per element
+    template<std::floating_point F>
+    LAB_constexpr void ToMat4Batch(std::type_identity_t<std::span<const Quaternion<F>>> const quats, std::type_identity_t<std::span<Matrix<F, 4, 4>>> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(out.size() >= quats.size());
+#endif
+        for (std::size_t i = 0; i < quats.size(); i++) {
+            out[i] = quats[i].ToMat4();
+        }
+    }
+
+    //out[i] = Quaternion::Nlerp(lhs[i], rhs[i], weights[i]), see Nlerp for the error against Mix
+    template<std::floating_point F>
+    LAB_constexpr void NlerpBatch(std::type_identity_t<std::span<const Quaternion<F>>> const lhs, std::type_identity_t<std::span<const Quaternion<F>>> const rhs, std::type_identity_t<std::span<const F>> const weights, std::type_identity_t<std::span<Quaternion<F>>> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(weights.size() == lhs.size());
+#endif
+        detail::InterpolateBatch<false, F>(lhs, rhs, weights, out);
+    }
+    //one weight for every pair, blending two whole poses
+    template<std::floating_point F>
+    LAB_constexpr void NlerpBatch(std::type_identity_t<std::span<const Quaternion<F>>> const lhs, std::type_identity_t<std::span<const Quaternion<F>>> const rhs, F const weight, std::type_identity_t<std::span<Quaternion<F>>> const out) {
+        detail::InterpolateBatch<false, F>(lhs, rhs, std::span<const F>{&weight, 1}, out);
+    }
+
+    //out[i] = Quaternion::FastSlerp(lhs[i], rhs[i], weights[i]), see FastSlerp for the error against Mix
+    template<std::floating_point F>
+    LAB_constexpr void FastSlerpBatch(std::type_identity_t<std::span<const Quaternion<F>>> const lhs, std::type_identity_t<std::span<const Quaternion<F>>> const rhs, std::type_identity_t<std::span<const F>> const weights, std::type_identity_t<std::span<Quaternion<F>>> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(weights.size() == lhs.size());
+#endif
+        detail::InterpolateBatch<true, F>(lhs, rhs, weights, out);
+    }
+    template<std::floating_point F>
+    LAB_constexpr void FastSlerpBatch(std::type_identity_t<std::span<const Quaternion<F>>> const lhs, std::type_identity_t<std::span<const Quaternion<F>>> const rhs, F const weight, std::type_identity_t<std::span<Quaternion<F>>> const out) {
+        detail::InterpolateBatch<true, F>(lhs, rhs, std::span<const F>{&weight, 1}, out);
+    }
+}
@@ -0,0 +1,256 @@
+#pragma once
+#include "../Quaternion.h"
+#include "../Support/SIMD.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+//smallest three quaternion compression, for sending rotations over the network or storing animation tracks
+//q and -q are the same rotation, so the largest component is made positive and dropped, then rebuilt from the unit length on decompression
+//the other three are always within [-1/sqrt(2), 1/sqrt(2)], each one is quantized to ComponentBits over that range
+//  ComponentBits 10: 2 bit index + 3 x 10 bits in a uint32_t, a step of sqrt(2)/1023 = 0.00138
+//  ComponentBits 15: 2 bit index + 3 x 15 bits in the low 47 bits of a uint64_t, a step of sqrt(2)/32767 = 0.0000432
+//the input is normalized with SoftwareInverseSqrt, and the dropped component is rebuilt with SoftwareSqrt, neither the hardware versions,
+//so the round trip gives the same bits at compile time, at runtime, in the batch and on every compiler. the quantization rounds to nearest even
+//error of the round trip against the normalized input, in the rotation angle between them. from the LinearAlgebraAccuracy target, float:
+//  10 bits: max 0.00462 rad (0.26 degrees), mean 0.00150 rad
+//  15 bits: max 0.000146 rad (0.0083 degrees), mean 0.0000490 rad
+//the worst case is a rotation with all four components near +-0.5, where all three kept components are as large as they get
+//the input must not be zero or contain NaN
+
+namespace lab {
+    template<uint8_t ComponentBits>
+    requires((ComponentBits == 10) || (ComponentBits == 15))
+    using SmallestThree = std::conditional_t<ComponentBits == 10, uint32_t, uint64_t>;
+
+    namespace detail {
+        template<uint8_t ComponentBits, std::floating_point F>
+        struct SmallestThreeConstants {
+            static constexpr uint32_t MaxQuantized = (1u << ComponentBits) - 1;
+            static constexpr F MaxQuantizedF = F(MaxQuantized);
+            //[-1/sqrt(2), 1/sqrt(2)] onto [0, MaxQuantized], component * Scale + HalfMax
+            static constexpr F Scale = F(MaxQuantized * 0.70710678118654752440L);
+            static constexpr F HalfMax = F(MaxQuantized) * F(0.5);
+            //and back, quantized * Step - Offset
+            static constexpr F Step = F(1.41421356237309504880L / MaxQuantized);
+            static constexpr F Offset = F(0.70710678118654752440L);
+        };
+
+#ifdef USING_SIMD
+        //the same steps as CompressSmallestThree, one quaternion per lane
+        template<uint8_t ComponentBits>
+        inline void CompressSmallestThreeLanes(SIMD::Float (&quat)[4], SIMD::Int& largest, SIMD::Int (&quantized)[3]) {
+            using Constants = SmallestThreeConstants<ComponentBits, float>;
+            const SIMD::Float zero = SIMD::Set1(0.f);
+            const SIMD::Float negativeOne = SIMD::Set1(-1.f);
+
+            const SIMD::Float sqrdMag = SIMD::Add(SIMD::Add(SIMD::Add(SIMD::Mul(quat[0], quat[0]), SIMD::Mul(quat[1], quat[1])), SIMD::Mul(quat[2], quat[2])), SIMD::Mul(quat[3], quat[3]));
+            const SIMD::Float invMag = SIMD::SoftwareInverseSqrt<Precision::Precise>(sqrdMag);
+            for (uint8_t c = 0; c < 4; c++) {
+                quat[c] = SIMD::Mul(quat[c], invMag);
+            }
+
+            //strictly greater, so ties keep the lowest index like the scalar loop
+            SIMD::Float largestIndex = zero;
+            SIMD::Float largestComponent = quat[0];
+            SIMD::Float largestMagnitude = SIMD::Max(quat[0], SIMD::Mul(quat[0], negativeOne));
+            for (uint8_t c = 1; c < 4; c++) {
+                const SIMD::Float magnitude = SIMD::Max(quat[c], SIMD::Mul(quat[c], negativeOne));
+                const SIMD::Float larger = SIMD::Greater(magnitude, largestMagnitude);
+                largestIndex = SIMD::Select(larger, SIMD::Set1(float(c)), largestIndex);
+                largestComponent = SIMD::Select(larger, quat[c], largestComponent);
+                largestMagnitude = SIMD::Select(larger, magnitude, largestMagnitude);
+            }
+            const SIMD::Float sign = SIMD::Select(SIMD::Less(largestComponent, zero), negativeOne, SIMD::Set1(1.f));
+
+            //the components that are kept, in xyzw order with the largest skipped
+            const SIMD::Float kept[3] = {
+                SIMD::Select(SIMD::Equal(largestIndex, zero), quat[1], quat[0]),
+                SIMD::Select(SIMD::LessEqual(largestIndex, SIMD::Set1(1.f)), quat[2], quat[1]),
+                SIMD::Select(SIMD::LessEqual(largestIndex, SIMD::Set1(2.f)), quat[3], quat[2])
+            };
+            const SIMD::Float scale = SIMD::Set1(Constants::Scale);
+            const SIMD::Float halfMax = SIMD::Set1(Constants::HalfMax);
+            const SIMD::Float maxQuantized = SIMD::Set1(Constants::MaxQuantizedF);
+            for (uint8_t k = 0; k < 3; k++) {
+                const SIMD::Float scaled = SIMD::Mul(SIMD::Mul(kept[k], sign), scale);
+                const SIMD::Float shifted = SIMD::Add(scaled, halfMax);
+                quantized[k] = SIMD::RoundToInt(SIMD::Min(SIMD::Max(shifted, zero), maxQuantized));
+            }
+            largest = SIMD::RoundToInt(largestIndex);
+        }
+
+        //the same steps as DecompressSmallestThree, one quaternion per lane
+        template<uint8_t ComponentBits>
+        inline void DecompressSmallestThreeLanes(SIMD::Int const largest, SIMD::Int const (&quantized)[3], SIMD::Float (&quat)[4]) {
+            using Constants = SmallestThreeConstants<ComponentBits, float>;
+            const SIMD::Float step = SIMD::Set1(Constants::Step);
+            const SIMD::Float offset = SIMD::Set1(Constants::Offset);
+            SIMD::Float kept[3];
+            for (uint8_t k = 0; k < 3; k++) {
+                const SIMD::Float scaled = SIMD::Mul(SIMD::IntToFloat(quantized[k]), step);
+                kept[k] = SIMD::Sub(scaled, offset);
+            }
+            const SIMD::Float sqrdKept = SIMD::Add(SIMD::Add(SIMD::Mul(kept[0], kept[0]), SIMD::Mul(kept[1], kept[1])), SIMD::Mul(kept[2], kept[2]));
+            const SIMD::Float remaining = SIMD::Max(SIMD::Sub(SIMD::Set1(1.f), sqrdKept), SIMD::Set1(0.f));
+            const SIMD::Float dropped = SIMD::Mul(remaining, SIMD::SoftwareInverseSqrt<Precision::Precise>(remaining));
+
+            const SIMD::Float index = SIMD::IntToFloat(largest);
+            const SIMD::Float isX = SIMD::Equal(index, SIMD::Set1(0.f));
+            const SIMD::Float isY = SIMD::Equal(index, SIMD::Set1(1.f));
+            const SIMD::Float isZ = SIMD::Equal(index, SIMD::Set1(2.f));
+            const SIMD::Float isW = SIMD::Equal(index, SIMD::Set1(3.f));
+            quat[0] = SIMD::Select(isX, dropped, kept[0]);
+            quat[1] = SIMD::Select(isX, kept[0], SIMD::Select(isY, dropped, kept[1]));
+            quat[2] = SIMD::Select(isW, kept[2], SIMD::Select(isZ, dropped, kept[1]));
+            quat[3] = SIMD::Select(isW, dropped, kept[2]);
+        }
+#endif
+    }
+
+    template<uint8_t ComponentBits, std::floating_point F>
+    LAB_constexpr SmallestThree<ComponentBits> CompressSmallestThree(Quaternion<F> const& quat) {
+        using Constants = detail::SmallestThreeConstants<ComponentBits, F>;
+        const F invMag = SoftwareInverseSqrt<Precision::Precise>(quat.SquaredMagnitude());
+        const F components[4] = {quat.x * invMag, quat.y * invMag, quat.z * invMag, quat.w * invMag};
+
+        uint8_t largest = 0;
+        F largestMagnitude = Abs(components[0]);
+        for (uint8_t c = 1; c < 4; c++) {
+            const F magnitude = Abs(components[c]);
+            if (magnitude > largestMagnitude) {
+                largest = c;
+                largestMagnitude = magnitude;
+            }
+        }
+        const F sign = (components[largest] < F(0)) ? F(-1) : F(1);
+
+        SmallestThree<ComponentBits> packed = largest;
+        for (uint8_t c = 0; c < 4; c++) {
+            if (c != largest) {
+                //the multiply and add are separate statements so they can't be fused into an fma
+                const F scaled = components[c] * sign * Constants::Scale;
+                F shifted = scaled + Constants::HalfMax;
+                shifted = (shifted > F(0)) ? shifted : F(0);
+                shifted = (shifted < Constants::MaxQuantizedF) ? shifted : Constants::MaxQuantizedF;
+                packed = (packed << ComponentBits) | static_cast<SmallestThree<ComponentBits>>(detail::RoundToInt(shifted));
+            }
+        }
+        return packed;
+    }
+
+    template<uint8_t ComponentBits, std::floating_point F = float>
+    LAB_constexpr Quaternion<F> DecompressSmallestThree(SmallestThree<ComponentBits> const packed) {
+        using Constants = detail::SmallestThreeConstants<ComponentBits, F>;
+        const uint8_t largest = static_cast<uint8_t>(packed >> (ComponentBits * 3));
+        F kept[3];
+        for (uint8_t k = 0; k < 3; k++) {
+            const uint32_t quantized = static_cast<uint32_t>(packed >> (ComponentBits * (2 - k))) & Constants::MaxQuantized;
+            const F scaled = F(quantized) * Constants::Step;
+            kept[k] = scaled - Constants::Offset;
+        }
+        F remaining = F(1) - (kept[0] * kept[0] + kept[1] * kept[1] + kept[2] * kept[2]);
+        remaining = (remaining > F(0)) ? remaining : F(0);
+
+        F components[4];
+        uint8_t k = 0;
+        for (uint8_t c = 0; c < 4; c++) {
+            components[c] = (c == largest) ? SoftwareSqrt<Precision::Precise>(remaining) : kept[k++];
+        }
+        return Quaternion<F>{components[0], components[1], components[2], components[3]};
+    }
+
+    //out[i] = CompressSmallestThree<ComponentBits>(quats[i])
+    //F isnt deduced from spans, call it as CompressSmallestThreeBatch<10, float>(quats, out)
+    template<uint8_t ComponentBits, std::floating_point F>
+    LAB_constexpr void CompressSmallestThreeBatch(std::type_identity_t<std::span<const Quaternion<F>>> const quats, std::span<SmallestThree<ComponentBits>> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(out.size() >= quats.size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                for (; i + SIMD::FloatWidth <= quats.size(); i += SIMD::FloatWidth) {
+                    SIMD::Float lanes[4];
+                    SIMD::LoadTransposed(&quats[i].x, 4, lanes);
+                    SIMD::Int largest;
+                    SIMD::Int quantized[3];
+                    detail::CompressSmallestThreeLanes<ComponentBits>(lanes, largest, quantized);
+                    if constexpr (ComponentBits == 10) {
+                        SIMD::Int packed = SIMD::OrInt(SIMD::ShiftLeft(largest, 30), SIMD::ShiftLeft(quantized[0], 20));
+                        packed = SIMD::OrInt(packed, SIMD::OrInt(SIMD::ShiftLeft(quantized[1], 10), quantized[2]));
+                        SIMD::StoreU(reinterpret_cast<float*>(&out[i]), SIMD::AsFloat(packed));
+                    }
+                    else {
+                        //the 47 bits are built as a low and a high 32 bit half, then joined per element
+                        SIMD::Int low = SIMD::OrInt(SIMD::ShiftLeft(quantized[0], 30), SIMD::ShiftLeft(quantized[1], 15));
+                        low = SIMD::OrInt(low, quantized[2]);
+                        const SIMD::Int high = SIMD::OrInt(SIMD::ShiftLeft(largest, 13), SIMD::ShiftRight(quantized[0], 2));
+                        alignas(SIMD::Alignment) uint32_t lowBits[SIMD::FloatWidth];
+                        alignas(SIMD::Alignment) uint32_t highBits[SIMD::FloatWidth];
+                        SIMD::Store(reinterpret_cast<float*>(lowBits), SIMD::AsFloat(low));
+                        SIMD::Store(reinterpret_cast<float*>(highBits), SIMD::AsFloat(high));
+                        for (std::size_t lane = 0; lane < SIMD::FloatWidth; lane++) {
+                            out[i + lane] = (uint64_t(highBits[lane]) << 32) | lowBits[lane];
+                        }
+                    }
+                }
+            }
+        }
+#endif
+        for (; i < quats.size(); i++) {
+            out[i] = CompressSmallestThree<ComponentBits>(quats[i]);
+        }
+    }
+
+    //out[i] = DecompressSmallestThree<ComponentBits, F>(packed[i])
+    //F isnt deduced from spans, call it as DecompressSmallestThreeBatch<10, float>(packed, out)
+    template<uint8_t ComponentBits, std::floating_point F>
+    LAB_constexpr void DecompressSmallestThreeBatch(std::span<const SmallestThree<ComponentBits>> const packed, std::type_identity_t<std::span<Quaternion<F>>> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(out.size() >= packed.size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                const SIMD::Int mask = SIMD::Set1Int(static_cast<int32_t>(detail::SmallestThreeConstants<ComponentBits, float>::MaxQuantized));
+                for (; i + SIMD::FloatWidth <= packed.size(); i += SIMD::FloatWidth) {
+                    SIMD::Int largest;
+                    SIMD::Int quantized[3];
+                    if constexpr (ComponentBits == 10) {
+                        const SIMD::Int bits = SIMD::AsInt(SIMD::LoadU(reinterpret_cast<float const*>(&packed[i])));
+                        largest = SIMD::ShiftRight(bits, 30);
+                        quantized[0] = SIMD::AndInt(SIMD::ShiftRight(bits, 20), mask);
+                        quantized[1] = SIMD::AndInt(SIMD::ShiftRight(bits, 10), mask);
+                        quantized[2] = SIMD::AndInt(bits, mask);
+                    }
+                    else {
+                        alignas(SIMD::Alignment) uint32_t lowBits[SIMD::FloatWidth];
+                        alignas(SIMD::Alignment) uint32_t highBits[SIMD::FloatWidth];
+                        for (std::size_t lane = 0; lane < SIMD::FloatWidth; lane++) {
+                            lowBits[lane] = static_cast<uint32_t>(packed[i + lane]);
+                            highBits[lane] = static_cast<uint32_t>(packed[i + lane] >> 32);
+                        }
+                        const SIMD::Int low = SIMD::AsInt(SIMD::Load(reinterpret_cast<float const*>(lowBits)));
+                        const SIMD::Int high = SIMD::AsInt(SIMD::Load(reinterpret_cast<float const*>(highBits)));
+                        largest = SIMD::ShiftRight(high, 13);
+                        quantized[0] = SIMD::AndInt(SIMD::OrInt(SIMD::ShiftRight(low, 30), SIMD::ShiftLeft(high, 2)), mask);
+                        quantized[1] = SIMD::AndInt(SIMD::ShiftRight(low, 15), mask);
+                        quantized[2] = SIMD::AndInt(low, mask);
+                    }
+                    SIMD::Float lanes[4];
+                    detail::DecompressSmallestThreeLanes<ComponentBits>(largest, quantized, lanes);
+                    SIMD::StoreTransposed(&out[i].x, 4, lanes);
+                }
+            }
+        }
+#endif
+        for (; i < packed.size(); i++) {
+            out[i] = DecompressSmallestThree<ComponentBits, F>(packed[i]);
+        }
+    }
+}
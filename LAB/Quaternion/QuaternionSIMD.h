@@ -0,0 +1,68 @@
+#pragma once
+
+#include "../Support/SIMD.h"
+
+//__m128 kernels behind Quaternion<float>, the lanes are x y z w
+//every kernel adds in the same order as the scalar member it replaces, so constexpr and runtime results match
+
+namespace lab {
+    namespace detail {
+#ifdef USING_SIMD
+        //each lane of the hamilton product is rhs.w * lhs + rhs.x * (w z y x) + rhs.y * (z w x y) + rhs.z * (y x w z)
+        //the subtractions are folded into the swizzles as sign flips, a - b is a + -b so nothing is rounded differently
+        inline __m128 QuaternionMultiplySIMD(__m128 const lhs, __m128 const rhs) {
+            const __m128 signX = _mm_setr_ps(0.f, -0.f, 0.f, -0.f);
+            const __m128 signY = _mm_setr_ps(0.f, 0.f, -0.f, -0.f);
+            const __m128 signZ = _mm_setr_ps(-0.f, 0.f, 0.f, -0.f);
+
+            __m128 ret = _mm_mul_ps(_mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 3, 3, 3)), lhs);
+            ret = _mm_add_ps(ret, _mm_mul_ps(_mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(0, 0, 0, 0)), _mm_xor_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(0, 1, 2, 3)), signX)));
+            ret = _mm_add_ps(ret, _mm_mul_ps(_mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 1, 1, 1)), _mm_xor_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(1, 0, 3, 2)), signY)));
+            ret = _mm_add_ps(ret, _mm_mul_ps(_mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(2, 2, 2, 2)), _mm_xor_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 3, 0, 1)), signZ)));
+            return ret;
+        }
+
+        //((xx + yy) + zz) + ww, summed one lane at a time to keep the scalar order
+        inline float QuaternionSquaredMagnitudeSIMD(__m128 const quat) {
+            const __m128 squared = _mm_mul_ps(quat, quat);
+            __m128 sum = _mm_add_ss(squared, _mm_shuffle_ps(squared, squared, _MM_SHUFFLE(1, 1, 1, 1)));
+            sum = _mm_add_ss(sum, _mm_movehl_ps(squared, squared));
+            sum = _mm_add_ss(sum, _mm_shuffle_ps(squared, squared, _MM_SHUFFLE(3, 3, 3, 3)));
+            return _mm_cvtss_f32(sum);
+        }
+
+        //InverseSqrt is the same scalar call the member uses at runtime
+        inline __m128 QuaternionNormalizeSIMD(__m128 const quat) {
+            return _mm_mul_ps(quat, _mm_set1_ps(InverseSqrt(QuaternionSquaredMagnitudeSIMD(quat))));
+        }
+
+        //the scalar ToMat4 negates the quaternion first, every term is a product of two components so the sign cancels exactly
+        inline void QuaternionToMat4SIMD(__m128 const quat, __m128 (&out)[4]) {
+            const __m128 doubled = _mm_mul_ps(_mm_set1_ps(2.f), quat);
+            //2xx 2yy 2zz -
+            const __m128 squares = _mm_mul_ps(doubled, quat);
+            //2xy 2xz 2yz -
+            const __m128 cross = _mm_mul_ps(_mm_shuffle_ps(doubled, doubled, _MM_SHUFFLE(3, 1, 0, 0)), _mm_shuffle_ps(quat, quat, _MM_SHUFFLE(3, 2, 2, 1)));
+            //2wz 2wy 2wx -
+            const __m128 wTerms = _mm_mul_ps(_mm_shuffle_ps(doubled, doubled, _MM_SHUFFLE(3, 3, 3, 3)), _mm_shuffle_ps(quat, quat, _MM_SHUFFLE(3, 0, 1, 2)));
+
+            //1 - (yy + zz), 1 - (xx + zz), 1 - (xx + yy), 0
+            __m128 diagonal = _mm_add_ps(_mm_shuffle_ps(squares, squares, _MM_SHUFFLE(3, 0, 0, 1)), _mm_shuffle_ps(squares, squares, _MM_SHUFFLE(3, 1, 2, 2)));
+            diagonal = _mm_blend_ps(_mm_sub_ps(_mm_set1_ps(1.f), diagonal), _mm_setzero_ps(), 0b1000);
+            //xy + wz, xz + wy, yz + wx
+            const __m128 sums = _mm_add_ps(cross, wTerms);
+            //xy - wz, xz - wy, yz - wx
+            const __m128 differences = _mm_sub_ps(cross, wTerms);
+
+            //1 - (yy + zz), xy + wz, xz - wy, 0
+            out[0] = _mm_blend_ps(_mm_shuffle_ps(sums, differences, _MM_SHUFFLE(1, 1, 0, 0)), diagonal, 0b1001);
+            //xy - wz, 1 - (xx + zz), yz + wx, 0
+            out[1] = _mm_blend_ps(_mm_shuffle_ps(differences, sums, _MM_SHUFFLE(2, 2, 0, 0)), diagonal, 0b1010);
+            //xz + wy, yz - wx, 1 - (xx + yy), 0
+            const __m128 pair = _mm_shuffle_ps(sums, differences, _MM_SHUFFLE(2, 2, 1, 1));
+            out[2] = _mm_blend_ps(_mm_shuffle_ps(pair, pair, _MM_SHUFFLE(2, 2, 2, 0)), diagonal, 0b1100);
+            out[3] = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+        }
+#endif
+    }
+}
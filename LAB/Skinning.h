@@ -0,0 +1,327 @@
+#pragma once
+#include "Matrix.h"
+#include "Quaternion.h"
+#include "Quaternion/DualQuaternion.h"
+#include "Quaternion/QuaternionBatch.h"
+#include "Vector/VectorSoA.h"
+#include "Support/SIMD.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+//cpu skinning of VectorSoA positions and normals against a bone palette, linear blend (matrices) or dual quaternion
+//every vertex has SkinInfluences bones. boneIndices and weights are vertex major, vertex i reads [i * 4, i * 4 + 4), the same layout as glTF JOINTS_0 and WEIGHTS_0
+//weights are expected to sum to 1, an unused influence has a weight of 0 and an index that is still inside the palette
+//the SIMD path blends the palette entries per vertex, then transposes 4 (8 with AVX2) skinned vertices into the SoA streams
+//results are bit identical to the scalar path. normals and the dual quaternion blend normalize through InverseSqrt, see Support/Sqrt.h
+//the outputs are resized to the input size, and are allowed to be the same object as the input
+
+namespace lab {
+    inline constexpr uint8_t SkinInfluences = 4;
+
+    namespace detail {
+        template<std::floating_point F>
+        LAB_constexpr Matrix<F, 4, 4> BlendPalette(std::span<const Matrix<F, 4, 4>> const palette, uint16_t const* boneIndices, F const* weights) {
+            Matrix<F, 4, 4> ret = palette[boneIndices[0]] * weights[0];
+            for (uint8_t influence = 1; influence < SkinInfluences; influence++) {
+                Matrix<F, 4, 4> const& bone = palette[boneIndices[influence]];
+                for (uint8_t column = 0; column < 4; column++) {
+                    ret.columns[column] = ret.columns[column] + bone.columns[column] * weights[influence];
+                }
+            }
+            return ret;
+        }
+
+        //q and -q are the same rotation, every influence is moved to the first one's hemisphere so the blend takes the short way around
+        template<std::floating_point F>
+        LAB_constexpr F HemisphereWeight(DualQuaternion<F> const& first, DualQuaternion<F> const& bone, F const weight) {
+            return first.real.Dot(bone.real) < F(0) ? -weight : weight;
+        }
+
+        //not normalized
+        template<std::floating_point F>
+        LAB_constexpr DualQuaternion<F> BlendPalette(std::span<const DualQuaternion<F>> const palette, uint16_t const* boneIndices, F const* weights) {
+            DualQuaternion<F> const& first = palette[boneIndices[0]];
+            DualQuaternion<F> ret = first * weights[0];
+            for (uint8_t influence = 1; influence < SkinInfluences; influence++) {
+                DualQuaternion<F> const& bone = palette[boneIndices[influence]];
+                ret = ret + bone * HemisphereWeight(first, bone, weights[influence]);
+            }
+            return ret;
+        }
+
+        //((c0 * x + c1 * y) + c2 * z) + c3
+        template<std::floating_point F>
+        LAB_constexpr Vector<F, 3> SkinPoint(Matrix<F, 4, 4> const& blended, Vector<F, 3> const point) {
+            const auto transformed = blended.columns[0] * point.x + blended.columns[1] * point.y + blended.columns[2] * point.z + blended.columns[3];
+            return Vector<F, 3>{transformed[0], transformed[1], transformed[2]};
+        }
+        //a blended matrix isn't orthonormal, so the normal is renormalized
+        template<std::floating_point F>
+        LAB_constexpr Vector<F, 3> SkinNormal(Matrix<F, 4, 4> const& blended, Vector<F, 3> const normal) {
+            const auto transformed = blended.columns[0] * normal.x + blended.columns[1] * normal.y + blended.columns[2] * normal.z;
+            return Vector<F, 3>{transformed[0], transformed[1], transformed[2]}.Normalized();
+        }
+
+#ifdef USING_SIMD
+        //one __m128 per vertex in, x y z w registers out
+        inline void VerticesToLanes(__m128 const (&vertices)[SIMD::FloatWidth], SIMD::Float (&lanes)[4]) {
+            for (uint8_t k = 0; k < 4; k++) {
+#ifdef LAB_USING_AVX2
+                lanes[k] = _mm256_set_m128(vertices[k + 4], vertices[k]);
+#else
+                lanes[k] = vertices[k];
+#endif
+            }
+            SIMD::Transpose4(lanes);
+        }
+
+        //the same sum as the scalar BlendPalette, column by column. AVX2 does two columns per instruction, as aligned loads since a matrix is 32 byte aligned
+        inline void BlendPaletteSIMD(Matrix<float, 4, 4> const* palette, uint16_t const* boneIndices, float const* weights, __m128 (&out)[4]) {
+#ifdef LAB_USING_AVX2
+            float const* first = &palette[boneIndices[0]].columns[0].component.x;
+            const __m256 firstWeight = _mm256_set1_ps(weights[0]);
+            __m256 pairs[2] = {
+                _mm256_mul_ps(_mm256_load_ps(first), firstWeight),
+                _mm256_mul_ps(_mm256_load_ps(first + 8), firstWeight)
+            };
+            for (uint8_t influence = 1; influence < SkinInfluences; influence++) {
+                float const* bone = &palette[boneIndices[influence]].columns[0].component.x;
+                const __m256 weight = _mm256_set1_ps(weights[influence]);
+                pairs[0] = _mm256_add_ps(pairs[0], _mm256_mul_ps(_mm256_load_ps(bone), weight));
+                pairs[1] = _mm256_add_ps(pairs[1], _mm256_mul_ps(_mm256_load_ps(bone + 8), weight));
+            }
+            out[0] = _mm256_castps256_ps128(pairs[0]);
+            out[1] = _mm256_extractf128_ps(pairs[0], 1);
+            out[2] = _mm256_castps256_ps128(pairs[1]);
+            out[3] = _mm256_extractf128_ps(pairs[1], 1);
+#else
+            Matrix<float, 4, 4> const& first = palette[boneIndices[0]];
+            const __m128 firstWeight = _mm_set1_ps(weights[0]);
+            for (uint8_t column = 0; column < 4; column++) {
+                out[column] = _mm_mul_ps(first.columns[column].vec, firstWeight);
+            }
+            for (uint8_t influence = 1; influence < SkinInfluences; influence++) {
+                Matrix<float, 4, 4> const& bone = palette[boneIndices[influence]];
+                const __m128 weight = _mm_set1_ps(weights[influence]);
+                for (uint8_t column = 0; column < 4; column++) {
+                    out[column] = _mm_add_ps(out[column], _mm_mul_ps(bone.columns[column].vec, weight));
+                }
+            }
+#endif
+        }
+
+        //real in out[0], dual in out[1]
+        inline void BlendPaletteSIMD(DualQuaternion<float> const* palette, uint16_t const* boneIndices, float const* weights, __m128 (&out)[2]) {
+            DualQuaternion<float> const& first = palette[boneIndices[0]];
+#ifdef LAB_USING_AVX2
+            //real and dual are contiguous, one register holds the whole dual quaternion
+            __m256 blended = _mm256_mul_ps(_mm256_loadu_ps(&first.real.x), _mm256_set1_ps(weights[0]));
+            for (uint8_t influence = 1; influence < SkinInfluences; influence++) {
+                DualQuaternion<float> const& bone = palette[boneIndices[influence]];
+                const __m256 weight = _mm256_set1_ps(HemisphereWeight(first, bone, weights[influence]));
+                blended = _mm256_add_ps(blended, _mm256_mul_ps(_mm256_loadu_ps(&bone.real.x), weight));
+            }
+            out[0] = _mm256_castps256_ps128(blended);
+            out[1] = _mm256_extractf128_ps(blended, 1);
+#else
+            const __m128 firstWeight = _mm_set1_ps(weights[0]);
+            out[0] = _mm_mul_ps(_mm_loadu_ps(&first.real.x), firstWeight);
+            out[1] = _mm_mul_ps(_mm_loadu_ps(&first.dual.x), firstWeight);
+            for (uint8_t influence = 1; influence < SkinInfluences; influence++) {
+                DualQuaternion<float> const& bone = palette[boneIndices[influence]];
+                const __m128 weight = _mm_set1_ps(HemisphereWeight(first, bone, weights[influence]));
+                out[0] = _mm_add_ps(out[0], _mm_mul_ps(_mm_loadu_ps(&bone.real.x), weight));
+                out[1] = _mm_add_ps(out[1], _mm_mul_ps(_mm_loadu_ps(&bone.dual.x), weight));
+            }
+#endif
+        }
+
+        //the scalar Quaternion::RotateVector, lane for lane. vec is overwritten
+        inline void RotateLanes(SIMD::Float const (&quat)[4], SIMD::Float (&vec)[3]) {
+            const SIMD::Float two = SIMD::Set1(2.f);
+            SIMD::Float t[3];
+            CrossLanes(quat[0], quat[1], quat[2], vec, t);
+            for (uint8_t c = 0; c < 3; c++) {
+                t[c] = SIMD::Mul(t[c], two);
+            }
+            SIMD::Float axisCrossT[3];
+            CrossLanes(quat[0], quat[1], quat[2], t, axisCrossT);
+            for (uint8_t c = 0; c < 3; c++) {
+                vec[c] = SIMD::Add(SIMD::Add(vec[c], SIMD::Mul(t[c], quat[3])), axisCrossT[c]);
+            }
+        }
+
+        template<typename Bone>
+        inline void SkinBlockSIMD(Bone const* palette, uint16_t const* boneIndices, float const* weights, std::size_t const first,
+            VectorSoA<float, 3> const& positions, VectorSoA<float, 3> const* normals, VectorSoA<float, 3>& outPositions, VectorSoA<float, 3>* outNormals
+        ) {
+            SIMD::Float posLanes[4];
+            SIMD::Float normalLanes[4];
+            if constexpr (std::is_same_v<Bone, Matrix<float, 4, 4>>) {
+                __m128 skinnedPositions[SIMD::FloatWidth];
+                __m128 skinnedNormals[SIMD::FloatWidth];
+                for (uint8_t v = 0; v < SIMD::FloatWidth; v++) {
+                    const std::size_t vertex = first + v;
+                    __m128 cols[4];
+                    BlendPaletteSIMD(palette, boneIndices + vertex * SkinInfluences, weights + vertex * SkinInfluences, cols);
+                    const __m128 px = _mm_set1_ps(positions.X()[vertex]);
+                    const __m128 py = _mm_set1_ps(positions.Y()[vertex]);
+                    const __m128 pz = _mm_set1_ps(positions.Z()[vertex]);
+                    skinnedPositions[v] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cols[0], px), _mm_mul_ps(cols[1], py)), _mm_mul_ps(cols[2], pz)), cols[3]);
+                    if (normals != nullptr) {
+                        const __m128 nx = _mm_set1_ps(normals->X()[vertex]);
+                        const __m128 ny = _mm_set1_ps(normals->Y()[vertex]);
+                        const __m128 nz = _mm_set1_ps(normals->Z()[vertex]);
+                        skinnedNormals[v] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cols[0], nx), _mm_mul_ps(cols[1], ny)), _mm_mul_ps(cols[2], nz));
+                    }
+                }
+                VerticesToLanes(skinnedPositions, posLanes);
+                if (normals != nullptr) {
+                    VerticesToLanes(skinnedNormals, normalLanes);
+                    const SIMD::Float sqrdMag = SIMD::Add(SIMD::Add(SIMD::Mul(normalLanes[0], normalLanes[0]), SIMD::Mul(normalLanes[1], normalLanes[1])), SIMD::Mul(normalLanes[2], normalLanes[2]));
+                    const SIMD::Float invMag = SIMD::InverseSqrt(sqrdMag);
+                    for (uint8_t c = 0; c < 3; c++) {
+                        normalLanes[c] = SIMD::Mul(normalLanes[c], invMag);
+                    }
+                }
+            }
+            else {
+                __m128 reals[SIMD::FloatWidth];
+                __m128 duals[SIMD::FloatWidth];
+                for (uint8_t v = 0; v < SIMD::FloatWidth; v++) {
+                    const std::size_t vertex = first + v;
+                    __m128 blended[2];
+                    BlendPaletteSIMD(palette, boneIndices + vertex * SkinInfluences, weights + vertex * SkinInfluences, blended);
+                    reals[v] = blended[0];
+                    duals[v] = blended[1];
+                }
+                SIMD::Float real[4];
+                SIMD::Float dual[4];
+                VerticesToLanes(reals, real);
+                VerticesToLanes(duals, dual);
+
+                //DualQuaternion::Normalized
+                const SIMD::Float sqrdMag = SIMD::Add(SIMD::Add(SIMD::Add(SIMD::Mul(real[0], real[0]), SIMD::Mul(real[1], real[1])), SIMD::Mul(real[2], real[2])), SIMD::Mul(real[3], real[3]));
+                const SIMD::Float invMag = SIMD::InverseSqrt(sqrdMag);
+                for (uint8_t c = 0; c < 4; c++) {
+                    real[c] = SIMD::Mul(real[c], invMag);
+                    dual[c] = SIMD::Mul(dual[c], invMag);
+                }
+
+                //DualQuaternion::GetTranslation, ((dualAxis * rw - axis * dw) + axis.Cross(dualAxis)) * 2
+                const SIMD::Float two = SIMD::Set1(2.f);
+                SIMD::Float translation[3];
+                const SIMD::Float dualAxis[3] = {dual[0], dual[1], dual[2]};
+                CrossLanes(real[0], real[1], real[2], dualAxis, translation);
+                for (uint8_t c = 0; c < 3; c++) {
+                    translation[c] = SIMD::Mul(SIMD::Add(SIMD::Sub(SIMD::Mul(dual[c], real[3]), SIMD::Mul(real[c], dual[3])), translation[c]), two);
+                }
+
+                SIMD::Float point[3] = {SIMD::Load(positions.X() + first), SIMD::Load(positions.Y() + first), SIMD::Load(positions.Z() + first)};
+                RotateLanes(real, point);
+                for (uint8_t c = 0; c < 3; c++) {
+                    posLanes[c] = SIMD::Add(point[c], translation[c]);
+                }
+                if (normals != nullptr) {
+                    SIMD::Float normal[3] = {SIMD::Load(normals->X() + first), SIMD::Load(normals->Y() + first), SIMD::Load(normals->Z() + first)};
+                    RotateLanes(real, normal);
+                    for (uint8_t c = 0; c < 3; c++) {
+                        normalLanes[c] = normal[c];
+                    }
+                }
+            }
+            for (uint8_t c = 0; c < 3; c++) {
+                SIMD::Store(outPositions.Stream(c) + first, posLanes[c]);
+            }
+            if (normals != nullptr) {
+                for (uint8_t c = 0; c < 3; c++) {
+                    SIMD::Store(outNormals->Stream(c) + first, normalLanes[c]);
+                }
+            }
+        }
+#endif
+
+        //normals and outNormals are both null when there are no normals to skin
+        template<typename Bone, std::floating_point F>
+        LAB_constexpr void Skin(std::span<const Bone> const palette, std::span<const uint16_t> const boneIndices, std::span<const F> const weights,
+            VectorSoA<F, 3> const& positions, VectorSoA<F, 3> const* normals, VectorSoA<F, 3>& outPositions, VectorSoA<F, 3>* outNormals
+        ) {
+            const std::size_t count = positions.Size();
+#if LAB_DEBUGGING_ACCESS
+            assert(boneIndices.size() >= count * SkinInfluences);
+            assert(weights.size() >= count * SkinInfluences);
+            assert(normals == nullptr || normals->Size() == count);
+            for (std::size_t i = 0; i < count * SkinInfluences; i++) {
+                assert(boneIndices[i] < palette.size());
+            }
+#endif
+            outPositions.Resize(count);
+            if (outNormals != nullptr) {
+                outNormals->Resize(count);
+            }
+            std::size_t i = 0;
+#ifdef USING_SIMD
+            if !consteval {
+                if constexpr (std::is_same_v<F, float>) {
+                    //every vertex in a block is read before any of it is written, which keeps in place skinning safe
+                    for (; i + SIMD::FloatWidth <= count; i += SIMD::FloatWidth) {
+                        SkinBlockSIMD(palette.data(), boneIndices.data(), weights.data(), i, positions, normals, outPositions, outNormals);
+                    }
+                }
+            }
+#endif
+            for (; i < count; i++) {
+                const auto blended = BlendPalette(palette, &boneIndices[i * SkinInfluences], &weights[i * SkinInfluences]);
+                const Vector<F, 3> position = positions.Get(i);
+                if constexpr (std::is_same_v<Bone, Matrix<F, 4, 4>>) {
+                    if (normals != nullptr) {
+                        outNormals->Set(i, SkinNormal(blended, normals->Get(i)));
+                    }
+                    outPositions.Set(i, SkinPoint(blended, position));
+                }
+                else {
+                    const DualQuaternion<F> normalized = blended.Normalized();
+                    if (normals != nullptr) {
+                        outNormals->Set(i, normalized.TransformDirection(normals->Get(i)));
+                    }
+                    outPositions.Set(i, normalized.TransformPoint(position));
+                }
+            }
+        }
+    }
+
+    //linear blend skinning, each vertex is transformed by the weighted sum of its bone matrices
+    //palette holds the final skinning matrices, bone world transform * inverse bind matrix
+    template<std::floating_point F>
+    LAB_constexpr void SkinLinearBlend(std::type_identity_t<std::span<const Matrix<F, 4, 4>>> const palette, std::span<const uint16_t> const boneIndices, std::type_identity_t<std::span<const F>> const weights,
+        VectorSoA<F, 3> const& positions, VectorSoA<F, 3>& outPositions
+    ) {
+        detail::Skin<Matrix<F, 4, 4>, F>(palette, boneIndices, weights, positions, nullptr, outPositions, nullptr);
+    }
+    //the normals go through the blended matrix's upper 3x3 and are renormalized
+    template<std::floating_point F>
+    LAB_constexpr void SkinLinearBlend(std::type_identity_t<std::span<const Matrix<F, 4, 4>>> const palette, std::span<const uint16_t> const boneIndices, std::type_identity_t<std::span<const F>> const weights,
+        VectorSoA<F, 3> const& positions, VectorSoA<F, 3> const& normals, VectorSoA<F, 3>& outPositions, VectorSoA<F, 3>& outNormals
+    ) {
+        detail::Skin<Matrix<F, 4, 4>, F>(palette, boneIndices, weights, positions, &normals, outPositions, &outNormals);
+    }
+
+    //dual quaternion skinning, the weighted sum of the bone dual quaternions is normalized and applied as a rigid transform
+    //keeps volume around twisting joints where linear blend collapses, but can't carry scale. palette entries are expected to be normalized
+    template<std::floating_point F>
+    LAB_constexpr void SkinDualQuaternion(std::type_identity_t<std::span<const DualQuaternion<F>>> const palette, std::span<const uint16_t> const boneIndices, std::type_identity_t<std::span<const F>> const weights,
+        VectorSoA<F, 3> const& positions, VectorSoA<F, 3>& outPositions
+    ) {
+        detail::Skin<DualQuaternion<F>, F>(palette, boneIndices, weights, positions, nullptr, outPositions, nullptr);
+    }
+    //normals are rotated by the blended rotation only
+    template<std::floating_point F>
+    LAB_constexpr void SkinDualQuaternion(std::type_identity_t<std::span<const DualQuaternion<F>>> const palette, std::span<const uint16_t> const boneIndices, std::type_identity_t<std::span<const F>> const weights,
+        VectorSoA<F, 3> const& positions, VectorSoA<F, 3> const& normals, VectorSoA<F, 3>& outPositions, VectorSoA<F, 3>& outNormals
+    ) {
+        detail::Skin<DualQuaternion<F>, F>(palette, boneIndices, weights, positions, &normals, outPositions, &outNormals);
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../Debugging.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+//result format of the batched culling and intersection tests, one bit per object
+//object i is bit i % 64 of word i / 64
+
+namespace lab {
+    //words needed for count objects
+    LAB_constexpr std::size_t BitmaskWordCount(std::size_t const count) {
+        return (count + 63) / 64;
+    }
+
+    namespace detail {
+        LAB_constexpr void ClearBitmask(std::span<uint64_t> const bits, std::size_t const count) {
+#if LAB_DEBUGGING_ACCESS
+            assert(bits.size() >= BitmaskWordCount(count));
+#endif
+            for (std::size_t word = 0; word < BitmaskWordCount(count); word++) {
+                bits[word] = 0;
+            }
+        }
+
+        //the padded tail of a VectorSoA goes through the SIMD loops too, its bits are dropped here
+        LAB_constexpr void MaskBitmaskTail(std::span<uint64_t> const bits, std::size_t const count) {
+            if (count % 64 != 0) {
+                bits[count / 64] &= (uint64_t(1) << (count % 64)) - 1;
+            }
+        }
+    }
+}
@@ -22,6 +22,17 @@ namespace lab {
 		return input * (F(1) - F(2) * (input < F(0)));
 	}
 
+	namespace detail {
+		//round to nearest even for |value| < 2^22 (2^51 for double), the same as SIMD::RoundToInt
+		//adding 1.5 * 2^23 (2^52) pushes the fraction out of the mantissa, it's a statement of its own so it can't be fused with a multiply
+		template<std::floating_point F>
+		LAB_constexpr int64_t RoundToInt(F const value) {
+			constexpr F magic = std::is_same_v<F, float> ? F(12582912.0) : F(6755399441055744.0);
+			const F shifted = value + magic;
+			return static_cast<int64_t>(shifted - magic);
+		}
+	}
+
 
 	template<std::floating_point F>
 	LAB_constexpr F Trunc(F const input) {
@@ -54,7 +65,7 @@ namespace lab {
 		}
 		else if constexpr (std::is_same_v<F, double>) {
 			const uint64_t bits = std::bit_cast<uint64_t>(input);
-			const int64_t exponent = ((bits >> 52) & 0b11111111111); //11 bits
+			const int64_t exponent = static_cast<int64_t>((bits >> 52) & 0b11111111111) - 1023; //11 bits
 			if(exponent >= 52){
 				return input;
 			}
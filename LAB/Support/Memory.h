@@ -0,0 +1,203 @@
+#pragma once
+
+#include "../Debugging.h"
+#include "SIMD.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+//aligned storage for the batch kernels
+//AlignedAllocator puts std::vector storage on a SIMD boundary, so a loop over it can use SIMD::Load instead of SIMD::LoadU
+//FrameArena hands out temporary batch buffers from one block and frees them all at once, so a per frame loop doesn't touch the heap
+
+namespace lab {
+    //the storage is aligned to Alignment or alignof(T), whichever is larger
+    //constexpr evaluation goes through std::allocator, like VectorSoA, so an AlignedVector still works in a constant expression
+    template<typename T, std::size_t Alignment = BatchAlignment>
+    requires((Alignment & (Alignment - 1)) == 0)
+    struct AlignedAllocator {
+        using value_type = T;
+        static constexpr std::size_t alignment = (Alignment > alignof(T)) ? Alignment : alignof(T);
+
+        //the non type parameter stops std::allocator_traits from deducing this
+        template<typename U>
+        struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        constexpr AlignedAllocator() noexcept = default;
+        template<typename U>
+        constexpr AlignedAllocator(AlignedAllocator<U, Alignment> const&) noexcept {}
+
+        [[nodiscard]] LAB_constexpr T* allocate(std::size_t const count) {
+            if consteval {
+                return std::allocator<T>{}.allocate(count);
+            }
+            else {
+                return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{alignment}));
+            }
+        }
+        LAB_constexpr void deallocate(T* const ptr, std::size_t const count) noexcept {
+            if consteval {
+                std::allocator<T>{}.deallocate(ptr, count);
+            }
+            else {
+                ::operator delete(ptr, count * sizeof(T), std::align_val_t{alignment});
+            }
+        }
+
+        template<typename U>
+        constexpr bool operator==(AlignedAllocator<U, Alignment> const&) const noexcept {
+            return true;
+        }
+    };
+
+    template<typename T, std::size_t Alignment = BatchAlignment>
+    using AlignedVector = std::vector<T, AlignedAllocator<T, Alignment>>;
+
+    //bump allocator for buffers that only live for a frame. Allocate moves a pointer forward, Reset moves it back to the start
+    //a frame that asks for more than the block holds gets the rest from the heap, and the next Reset grows the block to that frame's peak,
+    //so after the first few frames a steady workload never allocates
+    //runtime only, and nothing is destroyed, so it only hands out trivially destructible types
+    struct FrameArena {
+        //the block itself is on a cache line
+        static constexpr std::size_t BlockAlignment = 64;
+
+        FrameArena() {}
+        explicit FrameArena(std::size_t const bytes) {
+            Reserve(bytes);
+        }
+        FrameArena(FrameArena const&) = delete;
+        FrameArena& operator=(FrameArena const&) = delete;
+        FrameArena(FrameArena&& other) noexcept
+            : block{other.block}, capacity{other.capacity}, offset{other.offset}, overflow{std::move(other.overflow)}, overflowBytes{other.overflowBytes} {
+            other.block = nullptr;
+            other.capacity = 0;
+            other.offset = 0;
+            other.overflowBytes = 0;
+        }
+        FrameArena& operator=(FrameArena&& other) noexcept {
+            if (this != &other) {
+                Release();
+                block = other.block;
+                capacity = other.capacity;
+                offset = other.offset;
+                overflow = std::move(other.overflow);
+                overflowBytes = other.overflowBytes;
+                other.block = nullptr;
+                other.capacity = 0;
+                other.offset = 0;
+                other.overflowBytes = 0;
+            }
+            return *this;
+        }
+        ~FrameArena() {
+            Release();
+        }
+
+        //count default constructed Ts (floats and the other arithmetic types are left uninitialized), valid until the next Reset
+        //aligned to alignment or alignof(T), whichever is larger
+        template<typename T>
+        requires(std::is_trivially_destructible_v<T>)
+        std::span<T> Allocate(std::size_t const count, std::size_t const alignment = BatchAlignment) {
+            const std::size_t align = (alignment > alignof(T)) ? alignment : alignof(T);
+#if LAB_DEBUGGING_ACCESS
+            assert((align & (align - 1)) == 0);
+#endif
+            const std::size_t bytes = count * sizeof(T);
+            void* ptr = nullptr;
+            if (block != nullptr) {
+                const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block);
+                const std::size_t start = static_cast<std::size_t>(((base + offset + align - 1) & ~static_cast<std::uintptr_t>(align - 1)) - base);
+                if (start + bytes <= capacity) {
+                    ptr = block + start;
+                    offset = start + bytes;
+                }
+            }
+            if (ptr == nullptr) {
+                ptr = Spill(bytes, align);
+            }
+            T* const typed = static_cast<T*>(ptr);
+            std::uninitialized_default_construct_n(typed, count);
+            return std::span<T>{typed, count};
+        }
+
+        //everything handed out since the last Reset is invalid after this
+        void Reset() {
+            if (!overflow.empty()) {
+                const std::size_t peak = offset + overflowBytes;
+                for (Overflow const& spill : overflow) {
+                    ::operator delete(spill.ptr, spill.bytes, std::align_val_t{spill.alignment});
+                }
+                overflow.clear();
+                overflowBytes = 0;
+                Reserve(peak);
+            }
+            offset = 0;
+        }
+
+        //grows the block to at least bytes. only call it between frames, anything handed out from the old block is invalid after a grow
+        void Reserve(std::size_t const bytes) {
+            if (bytes <= capacity) {
+                return;
+            }
+            std::byte* const grown = static_cast<std::byte*>(::operator new(bytes, std::align_val_t{BlockAlignment}));
+            if (block != nullptr) {
+                ::operator delete(block, capacity, std::align_val_t{BlockAlignment});
+            }
+            block = grown;
+            capacity = bytes;
+            offset = 0;
+        }
+
+        std::size_t Capacity() const {
+            return capacity;
+        }
+        //bytes handed out this frame, alignment padding included
+        std::size_t Used() const {
+            return offset + overflowBytes;
+        }
+
+    private:
+        struct Overflow {
+            void* ptr;
+            std::size_t bytes;
+            std::size_t alignment;
+        };
+
+        std::byte* block = nullptr;
+        std::size_t capacity = 0;
+        std::size_t offset = 0;
+        //allocations that didn't fit in the block this frame
+        std::vector<Overflow> overflow;
+        //their size plus worst case padding, so the grown block is sure to fit them
+        std::size_t overflowBytes = 0;
+
+        //the slow path of Allocate, kept out of line so the bump stays small enough to inline
+        LAB_NOINLINE void* Spill(std::size_t const bytes, std::size_t const alignment) {
+            void* const ptr = ::operator new(bytes, std::align_val_t{alignment});
+            overflow.push_back(Overflow{ptr, bytes, alignment});
+            overflowBytes += bytes + alignment;
+            return ptr;
+        }
+
+        void Release() {
+            for (Overflow const& spill : overflow) {
+                ::operator delete(spill.ptr, spill.bytes, std::align_val_t{spill.alignment});
+            }
+            overflow.clear();
+            overflowBytes = 0;
+            offset = 0;
+            if (block != nullptr) {
+                ::operator delete(block, capacity, std::align_val_t{BlockAlignment});
+            }
+            block = nullptr;
+            capacity = 0;
+        }
+    };
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+//accuracy vs speed tiers for the Support math (Sqrt, InverseSqrt, Sin, Cos, Tan and the Arc functions)
+//every function takes the tier as its first template parameter, Sin<Precision::Fast>(x)
+//the default comes from LAB_PRECISION, 0 fast, 1 balanced, 2 precise. -DLAB_PRECISION=0 to change it project wide
+//the tiers are ordered for every function, Fast is never more accurate than Balanced and Balanced never costs more than Precise
+//changing the default changes every Normalize/Magnitude/rotation in the library
+
+#ifndef LAB_PRECISION
+#define LAB_PRECISION 1
+#endif
+
+namespace lab {
+	enum class Precision : uint8_t {
+		//float, measured by the accuracy target. ulp error blows up next to the zeros of Sin/Cos, the absolute error is the one to read there
+		//Sin/Cos absolute error <= 3.7e-5, Tan ~950 ulp (5.6e-5 absolute). ArcSin/ArcCos ~800 ulp (7e-5 absolute), same as Balanced
+		//ArcTan/ArcTan2 ~2250 ulp (1.2e-5 absolute). SoftwareSqrt/SoftwareInverseSqrt ~28400 ulp (1.7e-3 relative), InverseSqrt is the bit hack at runtime too
+		Fast = 0,
+		//Sin/Cos absolute error <= 4e-7 at any input, but up to ~1800 ulp on [-2pi, 2pi] and ~57000 ulp on [-1000, 1000] near the zeros
+		//Tan ~11 ulp. ArcSin/ArcCos ~800 ulp (7e-5 absolute), ArcTan ~75 ulp. SoftwareSqrt/SoftwareInverseSqrt ~77 ulp
+		//double Fast and Balanced trig carry the same absolute error as float, the polynomials are the same
+		Balanced = 1,
+		//float: about 2-4 ulp for Sin/Cos/Tan/ArcTan/ArcCos on the common range (Sin/Cos ~33 ulp out at +-1000), Software roots ~2.5 ulp
+		//with the hardware sqrt (Support/Sqrt.h) Sqrt is correctly rounded and InverseSqrt is within ~1.5 ulp
+		//double: Sin/Cos/Tan/ArcTan within ~7 ulp, but ArcSin/ArcCos are abramowitz and stegun 4.4.46 with |error| <= 2e-8, float level
+		Precise = 2,
+	};
+
+	static_assert((LAB_PRECISION >= 0) && (LAB_PRECISION <= 2), "LAB_PRECISION needs to be 0 (fast), 1 (balanced) or 2 (precise)");
+	inline constexpr Precision DefaultPrecision = static_cast<Precision>(LAB_PRECISION);
+}
@@ -0,0 +1,301 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "../Debugging.h"
+#include "Sqrt.h"
+
+#if defined(LAB_USING_SSE) || defined(LAB_USING_AVX2)
+#define USING_SIMD
+#include <immintrin.h>
+#endif
+//every AVX2 cpu has F16C, but gcc and clang only allow the intrinsics with -mf16c
+#if defined(LAB_USING_AVX2) && (defined(__F16C__) || defined(_MSC_VER))
+#define LAB_USING_F16C
+#endif
+
+//thin wrappers so the batch kernels can be written once for both SSE and AVX2
+//these are runtime only, the callers are expected to keep an if consteval scalar branch
+
+#ifdef USING_SIMD
+namespace lab {
+	namespace SIMD {
+#ifdef LAB_USING_AVX2
+		using Float = __m256;
+		using Int = __m256i;
+		inline constexpr std::size_t FloatWidth = 8;
+		inline constexpr std::size_t Alignment = 32;
+
+		inline Float Load(float const* ptr) { return _mm256_load_ps(ptr); }
+		inline Float LoadU(float const* ptr) { return _mm256_loadu_ps(ptr); }
+		inline void Store(float* ptr, Float const val) { _mm256_store_ps(ptr, val); }
+		inline void StoreU(float* ptr, Float const val) { _mm256_storeu_ps(ptr, val); }
+		inline Float Set1(float const val) { return _mm256_set1_ps(val); }
+
+		inline Float Add(Float const lhs, Float const rhs) { return _mm256_add_ps(lhs, rhs); }
+		inline Float Sub(Float const lhs, Float const rhs) { return _mm256_sub_ps(lhs, rhs); }
+		inline Float Mul(Float const lhs, Float const rhs) { return _mm256_mul_ps(lhs, rhs); }
+		inline Float Div(Float const lhs, Float const rhs) { return _mm256_div_ps(lhs, rhs); }
+
+		inline Int AsInt(Float const val) { return _mm256_castps_si256(val); }
+		inline Float AsFloat(Int const val) { return _mm256_castsi256_ps(val); }
+		inline Int SubInt(Int const lhs, Int const rhs) { return _mm256_sub_epi32(lhs, rhs); }
+		inline Int ShiftRight(Int const val, int const count) { return _mm256_srli_epi32(val, count); }
+		inline Int Set1Int(int32_t const val) { return _mm256_set1_epi32(val); }
+		inline Int AddInt(Int const lhs, Int const rhs) { return _mm256_add_epi32(lhs, rhs); }
+		//low 32 bits of the product, the same as a wrapping uint32_t multiply
+		inline Int MulInt(Int const lhs, Int const rhs) { return _mm256_mullo_epi32(lhs, rhs); }
+		inline Int XorInt(Int const lhs, Int const rhs) { return _mm256_xor_si256(lhs, rhs); }
+		inline Int OrInt(Int const lhs, Int const rhs) { return _mm256_or_si256(lhs, rhs); }
+		inline Int AndInt(Int const lhs, Int const rhs) { return _mm256_and_si256(lhs, rhs); }
+		inline Int MaxInt(Int const lhs, Int const rhs) { return _mm256_max_epi32(lhs, rhs); }
+		inline Int ShiftLeft(Int const val, int const count) { return _mm256_slli_epi32(val, count); }
+		//round to nearest even, the default rounding mode
+		inline Int RoundToInt(Float const val) { return _mm256_cvtps_epi32(val); }
+		inline Float IntToFloat(Int const val) { return _mm256_cvtepi32_ps(val); }
+		//FloatWidth narrow integers widened to the int lanes
+		inline Int LoadInt16s(int16_t const* ptr) { return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ptr))); }
+		inline Int LoadUint8s(uint8_t const* ptr) { return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(ptr))); }
+		//the int lanes saturated into FloatWidth narrow integers
+		inline void StoreInt16s(int16_t* ptr, Int const val) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), _mm_packs_epi32(_mm256_castsi256_si128(val), _mm256_extracti128_si256(val, 1)));
+		}
+		inline void StoreUint8s(uint8_t* ptr, Int const val) {
+			const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(val), _mm256_extracti128_si256(val, 1));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(ptr), _mm_packus_epi16(words, words));
+		}
+#ifdef LAB_USING_F16C
+		//FloatWidth IEEE halfs, rounded to nearest even
+		inline Float LoadFloat16s(uint16_t const* ptr) { return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ptr))); }
+		inline void StoreFloat16s(uint16_t* ptr, Float const val) { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), _mm256_cvtps_ph(val, _MM_FROUND_TO_NEAREST_INT)); }
+#endif
+
+		inline Float Trunc(Float const val) { return _mm256_round_ps(val, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+		//comparisons return a lane mask, all bits set where true
+		inline Float Greater(Float const lhs, Float const rhs) { return _mm256_cmp_ps(lhs, rhs, _CMP_GT_OQ); }
+		inline Float Less(Float const lhs, Float const rhs) { return _mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ); }
+		inline Float LessEqual(Float const lhs, Float const rhs) { return _mm256_cmp_ps(lhs, rhs, _CMP_LE_OQ); }
+		inline Float Equal(Float const lhs, Float const rhs) { return _mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ); }
+		//true where either side is NaN
+		inline Float Unordered(Float const lhs, Float const rhs) { return _mm256_cmp_ps(lhs, rhs, _CMP_UNORD_Q); }
+		inline Float Or(Float const lhs, Float const rhs) { return _mm256_or_ps(lhs, rhs); }
+		inline Float And(Float const lhs, Float const rhs) { return _mm256_and_ps(lhs, rhs); }
+		//bit i is the sign bit of lane i
+		inline int MoveMask(Float const val) { return _mm256_movemask_ps(val); }
+		//per lane mask ? ifTrue : ifFalse
+		inline Float Select(Float const mask, Float const ifTrue, Float const ifFalse) { return _mm256_blendv_ps(ifFalse, ifTrue, mask); }
+		inline Float Max(Float const lhs, Float const rhs) { return _mm256_max_ps(lhs, rhs); }
+		inline Float Min(Float const lhs, Float const rhs) { return _mm256_min_ps(lhs, rhs); }
+
+		//correctly rounded, the same result as std::sqrt
+		inline Float HardwareSqrt(Float const val) { return _mm256_sqrt_ps(val); }
+
+		//shuffle_ps within each 128 bit half
+		template<int Imm>
+		inline Float Shuffle(Float const lhs, Float const rhs) { return _mm256_shuffle_ps(lhs, rhs, Imm); }
+		inline Float LoadHalves(float const* low, float const* high) { return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1); }
+		inline void StoreHalves(float* low, float* high, Float const val) {
+			_mm_storeu_ps(low, _mm256_castps256_ps128(val));
+			_mm_storeu_ps(high, _mm256_extractf128_ps(val, 1));
+		}
+#else
+		using Float = __m128;
+		using Int = __m128i;
+		inline constexpr std::size_t FloatWidth = 4;
+		inline constexpr std::size_t Alignment = 16;
+
+		inline Float Load(float const* ptr) { return _mm_load_ps(ptr); }
+		inline Float LoadU(float const* ptr) { return _mm_loadu_ps(ptr); }
+		inline void Store(float* ptr, Float const val) { _mm_store_ps(ptr, val); }
+		inline void StoreU(float* ptr, Float const val) { _mm_storeu_ps(ptr, val); }
+		inline Float Set1(float const val) { return _mm_set1_ps(val); }
+
+		inline Float Add(Float const lhs, Float const rhs) { return _mm_add_ps(lhs, rhs); }
+		inline Float Sub(Float const lhs, Float const rhs) { return _mm_sub_ps(lhs, rhs); }
+		inline Float Mul(Float const lhs, Float const rhs) { return _mm_mul_ps(lhs, rhs); }
+		inline Float Div(Float const lhs, Float const rhs) { return _mm_div_ps(lhs, rhs); }
+
+		inline Int AsInt(Float const val) { return _mm_castps_si128(val); }
+		inline Float AsFloat(Int const val) { return _mm_castsi128_ps(val); }
+		inline Int SubInt(Int const lhs, Int const rhs) { return _mm_sub_epi32(lhs, rhs); }
+		inline Int ShiftRight(Int const val, int const count) { return _mm_srli_epi32(val, count); }
+		inline Int Set1Int(int32_t const val) { return _mm_set1_epi32(val); }
+		inline Int AddInt(Int const lhs, Int const rhs) { return _mm_add_epi32(lhs, rhs); }
+		//low 32 bits of the product, the same as a wrapping uint32_t multiply
+		inline Int MulInt(Int const lhs, Int const rhs) { return _mm_mullo_epi32(lhs, rhs); }
+		inline Int XorInt(Int const lhs, Int const rhs) { return _mm_xor_si128(lhs, rhs); }
+		inline Int OrInt(Int const lhs, Int const rhs) { return _mm_or_si128(lhs, rhs); }
+		inline Int AndInt(Int const lhs, Int const rhs) { return _mm_and_si128(lhs, rhs); }
+		inline Int MaxInt(Int const lhs, Int const rhs) { return _mm_max_epi32(lhs, rhs); }
+		inline Int ShiftLeft(Int const val, int const count) { return _mm_slli_epi32(val, count); }
+		//round to nearest even, the default rounding mode
+		inline Int RoundToInt(Float const val) { return _mm_cvtps_epi32(val); }
+		inline Float IntToFloat(Int const val) { return _mm_cvtepi32_ps(val); }
+		//FloatWidth narrow integers widened to the int lanes
+		inline Int LoadInt16s(int16_t const* ptr) { return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(ptr))); }
+		inline Int LoadUint8s(uint8_t const* ptr) { return _mm_cvtepu8_epi32(_mm_loadu_si32(ptr)); }
+		//the int lanes saturated into FloatWidth narrow integers
+		inline void StoreInt16s(int16_t* ptr, Int const val) { _mm_storel_epi64(reinterpret_cast<__m128i*>(ptr), _mm_packs_epi32(val, val)); }
+		inline void StoreUint8s(uint8_t* ptr, Int const val) {
+			const __m128i words = _mm_packs_epi32(val, val);
+			_mm_storeu_si32(ptr, _mm_packus_epi16(words, words));
+		}
+
+		inline Float Trunc(Float const val) { return _mm_round_ps(val, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+		//comparisons return a lane mask, all bits set where true
+		inline Float Greater(Float const lhs, Float const rhs) { return _mm_cmpgt_ps(lhs, rhs); }
+		inline Float Less(Float const lhs, Float const rhs) { return _mm_cmplt_ps(lhs, rhs); }
+		inline Float LessEqual(Float const lhs, Float const rhs) { return _mm_cmple_ps(lhs, rhs); }
+		inline Float Equal(Float const lhs, Float const rhs) { return _mm_cmpeq_ps(lhs, rhs); }
+		//true where either side is NaN
+		inline Float Unordered(Float const lhs, Float const rhs) { return _mm_cmpunord_ps(lhs, rhs); }
+		inline Float Or(Float const lhs, Float const rhs) { return _mm_or_ps(lhs, rhs); }
+		inline Float And(Float const lhs, Float const rhs) { return _mm_and_ps(lhs, rhs); }
+		//bit i is the sign bit of lane i
+		inline int MoveMask(Float const val) { return _mm_movemask_ps(val); }
+		//per lane mask ? ifTrue : ifFalse
+		inline Float Select(Float const mask, Float const ifTrue, Float const ifFalse) { return _mm_blendv_ps(ifFalse, ifTrue, mask); }
+		inline Float Max(Float const lhs, Float const rhs) { return _mm_max_ps(lhs, rhs); }
+		inline Float Min(Float const lhs, Float const rhs) { return _mm_min_ps(lhs, rhs); }
+
+		//correctly rounded, the same result as std::sqrt
+		inline Float HardwareSqrt(Float const val) { return _mm_sqrt_ps(val); }
+
+		template<int Imm>
+		inline Float Shuffle(Float const lhs, Float const rhs) { return _mm_shuffle_ps(lhs, rhs, Imm); }
+#endif
+
+		//the same as _MM_TRANSPOSE4_PS, with AVX2 each 128 bit half is transposed on its own
+		inline void Transpose4(Float (&rows)[4]) {
+			const Float t0 = Shuffle<0x44>(rows[0], rows[1]);
+			const Float t1 = Shuffle<0x44>(rows[2], rows[3]);
+			const Float t2 = Shuffle<0xEE>(rows[0], rows[1]);
+			const Float t3 = Shuffle<0xEE>(rows[2], rows[3]);
+			rows[0] = Shuffle<0x88>(t0, t1);
+			rows[1] = Shuffle<0xDD>(t0, t1);
+			rows[2] = Shuffle<0x88>(t2, t3);
+			rows[3] = Shuffle<0xDD>(t2, t3);
+		}
+
+		//FloatWidth records of 4 floats, record j starts at ptr + j * stride
+		//lanes[c] holds component c of every record, lane j is record j
+		inline void LoadTransposed(float const* ptr, std::size_t const stride, Float (&lanes)[4]) {
+			for (uint8_t k = 0; k < 4; k++) {
+#ifdef LAB_USING_AVX2
+				lanes[k] = LoadHalves(ptr + k * stride, ptr + (k + 4) * stride);
+#else
+				lanes[k] = LoadU(ptr + k * stride);
+#endif
+			}
+			Transpose4(lanes);
+		}
+		inline void StoreTransposed(float* ptr, std::size_t const stride, Float const (&lanes)[4]) {
+			Float rows[4] = { lanes[0], lanes[1], lanes[2], lanes[3] };
+			Transpose4(rows);
+			for (uint8_t k = 0; k < 4; k++) {
+#ifdef LAB_USING_AVX2
+				StoreHalves(ptr + k * stride, ptr + (k + 4) * stride, rows[k]);
+#else
+				StoreU(ptr + k * stride, rows[k]);
+#endif
+			}
+		}
+
+		//4 packed vec3s are 3 registers, x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+		inline void Deinterleave3(__m128 const a, __m128 const b, __m128 const c, __m128 (&out)[3]) {
+			out[0] = _mm_blend_ps(_mm_blend_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 0)), b, 0b0100), _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1)), 0b1000);
+			out[1] = _mm_blend_ps(_mm_blend_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 0, 0)), 0b0110), _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2)), 0b1000);
+			out[2] = _mm_blend_ps(_mm_blend_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), b, 0b0010), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 0, 0)), 0b1100);
+		}
+		inline void Interleave3(__m128 const x, __m128 const y, __m128 const z, __m128 (&out)[3]) {
+			out[0] = _mm_blend_ps(_mm_blend_ps(_mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(y, y, _MM_SHUFFLE(0, 0, 0, 0)), 0b0010), _mm_shuffle_ps(z, z, _MM_SHUFFLE(0, 0, 0, 0)), 0b0100);
+			out[1] = _mm_blend_ps(_mm_blend_ps(_mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 2, 1, 1)), z, 0b0010), x, 0b0100);
+			out[2] = _mm_blend_ps(_mm_blend_ps(_mm_shuffle_ps(z, z, _MM_SHUFFLE(3, 3, 3, 2)), _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)), 0b0010), _mm_shuffle_ps(y, y, _MM_SHUFFLE(3, 3, 3, 3)), 0b0100);
+		}
+
+#ifdef LAB_USING_AVX2
+		//the same shuffles on both 128 bit halves at once, the low half holds vectors 0-3 and the high half vectors 4-7
+		inline void Deinterleave3(__m256 const a, __m256 const b, __m256 const c, __m256 (&out)[3]) {
+			out[0] = _mm256_blend_ps(_mm256_blend_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 0)), b, 0b01000100), _mm256_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1)), 0b10001000);
+			out[1] = _mm256_blend_ps(_mm256_blend_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), _mm256_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 0, 0)), 0b01100110), _mm256_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2)), 0b10001000);
+			out[2] = _mm256_blend_ps(_mm256_blend_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), b, 0b00100010), _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 0, 0)), 0b11001100);
+		}
+		inline void Interleave3(__m256 const x, __m256 const y, __m256 const z, __m256 (&out)[3]) {
+			out[0] = _mm256_blend_ps(_mm256_blend_ps(_mm256_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 0, 0)), _mm256_shuffle_ps(y, y, _MM_SHUFFLE(0, 0, 0, 0)), 0b00100010), _mm256_shuffle_ps(z, z, _MM_SHUFFLE(0, 0, 0, 0)), 0b01000100);
+			out[1] = _mm256_blend_ps(_mm256_blend_ps(_mm256_shuffle_ps(y, y, _MM_SHUFFLE(2, 2, 1, 1)), z, 0b00100010), x, 0b01000100);
+			out[2] = _mm256_blend_ps(_mm256_blend_ps(_mm256_shuffle_ps(z, z, _MM_SHUFFLE(3, 3, 3, 2)), _mm256_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)), 0b00100010), _mm256_shuffle_ps(y, y, _MM_SHUFFLE(3, 3, 3, 3)), 0b01000100);
+		}
+#endif
+
+		//FloatWidth packed vec3s, lanes[c] holds component c of every vector
+		//only 3 * FloatWidth floats are touched, so this is safe on the last vectors of an array
+		inline void LoadVec3s(float const* ptr, Float (&lanes)[3]) {
+#ifdef LAB_USING_AVX2
+			Deinterleave3(LoadHalves(ptr, ptr + 12), LoadHalves(ptr + 4, ptr + 16), LoadHalves(ptr + 8, ptr + 20), lanes);
+#else
+			Deinterleave3(_mm_loadu_ps(ptr), _mm_loadu_ps(ptr + 4), _mm_loadu_ps(ptr + 8), lanes);
+#endif
+		}
+		inline void StoreVec3s(float* ptr, Float const (&lanes)[3]) {
+			Float packed[3];
+			Interleave3(lanes[0], lanes[1], lanes[2], packed);
+#ifdef LAB_USING_AVX2
+			for (uint8_t k = 0; k < 3; k++) {
+				StoreHalves(ptr + k * 4, ptr + 12 + k * 4, packed[k]);
+			}
+#else
+			_mm_storeu_ps(ptr, packed[0]);
+			_mm_storeu_ps(ptr + 4, packed[1]);
+			_mm_storeu_ps(ptr + 8, packed[2]);
+#endif
+		}
+
+		//same bit hack and newton steps as the scalar SoftwareInverseSqrt, so the results are bit identical
+		template<Precision P = DefaultPrecision>
+		inline Float SoftwareInverseSqrt(Float const input) {
+			Float refined = AsFloat(SubInt(Set1Int(0x5f3759df), ShiftRight(AsInt(input), 1)));
+			const Float half = Mul(input, Set1(0.5f));
+			const Float threeHalves = Set1(1.5f);
+			for (uint8_t i = 0; i < detail::InverseSqrtSteps<P, float>; i++) {
+				refined = Mul(refined, Sub(threeHalves, Mul(Mul(half, refined), refined)));
+			}
+			return refined;
+		}
+
+		//matches the scalar InverseSqrt and Sqrt lane for lane, see Sqrt.h for which tiers use the hardware sqrt
+		template<Precision P = DefaultPrecision>
+		inline Float InverseSqrt(Float const input) {
+#ifdef LAB_USING_HARDWARE_SQRT
+			if constexpr (P == Precision::Precise) {
+				const Float clamped = AsFloat(MaxInt(AsInt(input), Set1Int(0x00800000)));
+				return Div(Set1(1.f), HardwareSqrt(clamped));
+			}
+#endif
+			return SoftwareInverseSqrt<P>(input);
+		}
+		template<Precision P = DefaultPrecision>
+		inline Float Sqrt(Float const input) {
+#ifdef LAB_USING_HARDWARE_SQRT
+			return HardwareSqrt(input);
+#else
+			if constexpr (P == Precision::Precise) {
+				return Mul(input, SoftwareInverseSqrt<P>(input));
+			}
+			else {
+				return Div(Set1(1.f), SoftwareInverseSqrt<P>(input));
+			}
+#endif
+		}
+	}
+}
+#endif
+
+namespace lab {
+	//alignment of the batch buffers and the SIMD sized types, SIMD::Alignment in SIMD builds
+#ifdef USING_SIMD
+	inline constexpr std::size_t BatchAlignment = SIMD::Alignment;
+#else
+	inline constexpr std::size_t BatchAlignment = 16;
+#endif
+}
@@ -7,7 +7,7 @@
 
 namespace lab{
     template<std::floating_point F>
-	inline constexpr F PI = F(3.1415926535);
+	inline constexpr F PI = F(3.14159265358979323846);
 
 	template<std::floating_point F, bool Inverse = false>
 	static LAB_constexpr F GetPI(F multiplier) {
@@ -3,33 +3,104 @@
 #include <concepts>
 #include <bit>
 #include <cstdint>
+#include <type_traits>
 
 #include "../Debugging.h"
+#include "Precision.h"
+
+#if defined(LAB_USING_SSE) || defined(LAB_USING_AVX2)
+#define USING_SIMD
+#include <immintrin.h>
+#endif
+
+//at runtime with SSE/AVX2 enabled, Sqrt and the Precise InverseSqrt use the hardware sqrt (and divide)
+//the Fast and Balanced InverseSqrt stay on the bit hack, in a loop it vectorizes and beats sqrt + divide
+//the hardware path is written as std::sqrt so loops over it vectorize. std::sqrt sets errno on a negative input,
+//so gcc and clang only vectorize it with -fno-math-errno (which defines __NO_MATH_ERRNO__), without it everything stays on the bit hack
+//constexpr evaluation always uses the bit hack, so compile time and runtime results differ unless LAB_DETERMINISTIC is defined
+//LAB_DETERMINISTIC keeps the runtime on the bit hack too
+#if defined(USING_SIMD) && !defined(LAB_DETERMINISTIC) && defined(__NO_MATH_ERRNO__)
+#define LAB_USING_HARDWARE_SQRT
+#include <algorithm>
+#include <cmath>
+#endif
 
 namespace lab{
-	template<std::floating_point F>
-	LAB_constexpr F InverseSqrt(F const input) {
+	namespace detail{
+		//newton steps after the bit hack. each step roughly doubles the correct bits
+		template<Precision P, std::floating_point F>
+		inline constexpr uint8_t InverseSqrtSteps = (P == Precision::Fast) ? 1 : (P == Precision::Balanced) ? 2 : (std::is_same_v<F, float> ? 3 : 4);
+
+#ifdef LAB_USING_HARDWARE_SQRT
+		//the input is clamped to the smallest normal, so InverseSqrt(0) stays finite like the bit hack and normalizing a zero vector stays zero
+		//the clamp is an integer max on the bits, a float max or a branch keeps gcc from vectorizing the loop. negative inputs clamp too
+		inline float HardwareInverseSqrt(float const input) {
+			const float clamped = std::bit_cast<float>(std::max(std::bit_cast<std::int32_t>(input), std::int32_t{0x00800000}));
+			return 1.f / std::sqrt(clamped);
+		}
+		inline double HardwareInverseSqrt(double const input) {
+			const double clamped = std::bit_cast<double>(std::max(std::bit_cast<std::int64_t>(input), std::int64_t{0x0010000000000000}));
+			return 1.0 / std::sqrt(clamped);
+		}
+#endif
+	}
+
+	//the bit hack, used for constexpr evaluation and for LAB_DETERMINISTIC
+	template<Precision P = DefaultPrecision, std::floating_point F>
+	LAB_constexpr F SoftwareInverseSqrt(F const input) {
 		//copied from wikipedia
 #ifdef LAB_MATH_DEBUG
 		Debug_Min_Check<F, F(0)>(input);
 #endif
 		if constexpr(std::is_same_v<F, float>){
-			const auto y = std::bit_cast<float>(0x5f3759df - (std::bit_cast<std::uint32_t>(input) >> 1));
-			const float refined = y * (1.5f - (input * 0.5f * y * y));
-			return refined * (1.5f - (input * 0.5f * refined * refined));
+			auto refined = std::bit_cast<float>(0x5f3759df - (std::bit_cast<std::uint32_t>(input) >> 1));
+			for(uint8_t i = 0; i < detail::InverseSqrtSteps<P, F>; i++){
+				refined = refined * (1.5f - (input * 0.5f * refined * refined));
+			}
+			return refined;
 		}
 		else if constexpr(std::is_same_v<F, double>){
-			const auto y = std::bit_cast<double>(0x5fe6eb50c7b537a9 - (std::bit_cast<std::uint64_t>(input) >> 1));
-			const double refined = y * (1.5 - (input * 0.5 * y * y));
-			return refined * (1.5 - (input * 0.5 * refined * refined));
+			auto refined = std::bit_cast<double>(0x5fe6eb50c7b537a9 - (std::bit_cast<std::uint64_t>(input) >> 1));
+			for(uint8_t i = 0; i < detail::InverseSqrtSteps<P, F>; i++){
+				refined = refined * (1.5 - (input * 0.5 * refined * refined));
+			}
+			return refined;
 		}
 		else{
 			static_assert(false);
 		}
 	}
 
-	template<std::floating_point F>
+	template<Precision P = DefaultPrecision, std::floating_point F>
+	LAB_constexpr F SoftwareSqrt(F const input) {
+		if constexpr(P == Precision::Precise){
+			//one rounding less than the reciprocal, and Sqrt(0) is exactly 0
+			return input * SoftwareInverseSqrt<P>(input);
+		}
+		else{
+			return F(1) / SoftwareInverseSqrt<P>(input);
+		}
+	}
+
+	template<Precision P = DefaultPrecision, std::floating_point F>
+	LAB_constexpr F InverseSqrt(F const input) {
+#ifdef LAB_USING_HARDWARE_SQRT
+		if constexpr (P == Precision::Precise) {
+			if !consteval {
+				return detail::HardwareInverseSqrt(input);
+			}
+		}
+#endif
+		return SoftwareInverseSqrt<P>(input);
+	}
+
+	template<Precision P = DefaultPrecision, std::floating_point F>
 	LAB_constexpr F Sqrt(F const input) {
-		return F(1) / InverseSqrt(input);
+#ifdef LAB_USING_HARDWARE_SQRT
+		if !consteval {
+			return std::sqrt(input);
+		}
+#endif
+		return SoftwareSqrt<P>(input);
 	}
-}
\ No newline at end of file
+}
@@ -1,11 +1,18 @@
 #pragma once
 
 #include <concepts>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 //#define USING_CMATH
 
 #include "../Debugging.h"
 #include "Simple.h"
+#include "Generic.h"
+#include "Sqrt.h"
+#include "Precision.h"
 
 
 #if defined(LAB_USING_SSE) || defined(LAB_USING_AVX2)
@@ -30,72 +37,192 @@ namespace lab {
 		if (moddedInput > higher) {
 			return moddedInput - fullRange;
 		}
+		//Mod keeps the sign of the dividend, so inputs below lower come back one range too low
+		if (moddedInput < lower) {
+			return moddedInput + fullRange;
+		}
 		return moddedInput;
 	}
 
-
-	//chebyshev implementation
 	template<std::floating_point F>
-	LAB_constexpr F Sin(F const input) {
-		F phased = lab::PhaseTo(input, -GetPI_DividedBy(F(2)), GetPI(F(1.5)));
+	struct SinCosPair {
+		F sin;
+		F cos;
+	};
+
+	namespace detail {
+		//every tier reduces to r in [-PI/4, PI/4] plus a quadrant, input = quadrant * PI/2 + r
+		//the quadrant rounding is the 1.5 * 2^mantissa trick, which is constexpr and branchless
+		//Fast and Balanced split PI/2 into 2 parts, Precise into 3 (Cody-Waite, same constants as cephes) so r stays accurate for large inputs
+		//float Precise is accurate up to |input| ~ 1e5, past that the reduction error grows linearly
+		//the tiers only differ in the split and in how many taylor terms they take
+		template<std::floating_point F>
+		struct QuadrantReduced {
+			F sin; //of r
+			F cos; //of r
+			uint8_t quadrant;
+		};
+
+		//taylor coefficients, (-1)^n / (2n + 1)! and (-1)^n / (2n)!
+		inline constexpr double sinCoefficients[] = {
+			1.0, -0.16666666666666666, 0.008333333333333333, -0.0001984126984126984, 2.7557319223985893e-06,
+			-2.505210838544172e-08, 1.6059043836821613e-10, -7.647163731819816e-13, 2.8114572543455206e-15
+		};
+		inline constexpr double cosCoefficients[] = {
+			1.0, -0.5, 0.041666666666666664, -0.001388888888888889, 2.48015873015873e-05,
+			-2.755731922398589e-07, 2.08767569878681e-09, -1.1470745597729725e-11, 4.779477332387385e-14, -1.5619206968586225e-16
+		};
+		//(-1)^n / (2n + 1)
+		inline constexpr double arcTanCoefficients[] = {
+			1.0, -0.3333333333333333, 0.2, -0.14285714285714285, 0.1111111111111111, -0.09090909090909091,
+			0.07692307692307693, -0.06666666666666667, 0.058823529411764705, -0.05263157894736842, 0.047619047619047616,
+			-0.043478260869565216, 0.04, -0.037037037037037035, 0.034482758620689655, -0.03225806451612903,
+			0.030303030303030304, -0.02857142857142857, 0.02702702702702703, -0.02564102564102564, 0.024390243902439025,
+			-0.023255813953488372
+		};
+
+		//coefficients[0] + z * (coefficients[1] + z * (...))
+		template<std::floating_point F, std::size_t Count>
+		LAB_constexpr F Horner(F const z, double const (&coefficients)[Count], std::size_t const used) {
+			F ret = F(coefficients[used - 1]);
+			for (std::size_t i = used - 1; i > 0; i--) {
+				ret = ret * z + F(coefficients[i - 1]);
+			}
+			return ret;
+		}
 
-		if(phased > GetPI_DividedBy(F(2))){
-			phased = PI<F> - phased;
+		//sin(r) / r and cos(r) terms. the truncation error at r = PI/4 is about 4e-5 for Fast, 3e-7 for Balanced
+		template<Precision P, std::floating_point F>
+		inline constexpr std::size_t QuadrantSinTerms = (P == Precision::Fast) ? 3 : (P == Precision::Balanced) ? 4 : (std::is_same_v<F, float> ? 5 : 9);
+		template<Precision P, std::floating_point F>
+		inline constexpr std::size_t QuadrantCosTerms = QuadrantSinTerms<P, F> + 1;
+
+		template<Precision P, std::floating_point F>
+		LAB_constexpr QuadrantReduced<F> ReduceQuadrant(F const input) {
+			F const scaled = input * F(0.63661977236758134308); //2 / PI
+
+			F k;
+			uint8_t quadrant;
+			if constexpr (std::is_same_v<F, float>) {
+				//valid while |scaled| < 2^22, the integer lands in the low mantissa bits
+				float const shifted = scaled + 12582912.f;
+				quadrant = static_cast<uint8_t>(std::bit_cast<uint32_t>(shifted) & 3);
+				k = shifted - 12582912.f;
+			}
+			else {
+				double const shifted = scaled + 6755399441055744.0;
+				quadrant = static_cast<uint8_t>(std::bit_cast<uint64_t>(shifted) & 3);
+				k = shifted - 6755399441055744.0;
+			}
+
+			F r;
+			if constexpr (P != Precision::Precise) {
+				r = (input - k * F(1.5703125)) - k * F(4.8382679489661923e-4);
+			}
+			else if constexpr (std::is_same_v<F, float>) {
+				r = ((input - k * 1.5703125f) - k * 4.837512969970703125e-4f) - k * 7.54978995489188216e-8f;
+			}
+			else {
+				r = ((input - k * 1.570796251296997070312) - k * 7.54978941586159635336e-8) - k * 5.3903028581581190529e-15;
+			}
+			const F z = r * r;
+			QuadrantReduced<F> ret;
+			ret.quadrant = quadrant;
+			ret.sin = r * Horner(z, sinCoefficients, QuadrantSinTerms<P, F>);
+			ret.cos = Horner(z, cosCoefficients, QuadrantCosTerms<P, F>);
+			return ret;
 		}
 
-		const F pow_val = phased * phased;
-		return phased * (F(1.0) 
-			+ pow_val * (F(-0.16666666666666666) + 
-				pow_val * (F(0.00833333333333333) + 
-					pow_val * (F(-0.00019841269841269) + 
-						pow_val * (F(0.00000275573192239))
-					)
-				)
-			)
-		);
-	}
+		//the quadrant picks and sign flips are done on the bits. with a ternary the compiler moves each polynomial into its own branch,
+		//and a loop over Sin or Tan stops vectorizing. the results are the same as the ternary and the negation
+		template<std::floating_point F>
+		using QuadrantBits = std::conditional_t<std::is_same_v<F, float>, uint32_t, uint64_t>;
 
-	template<std::floating_point F>
-	LAB_constexpr F Cos(F const input) {
-		return Sin(input + GetPI_DividedBy(2.f));
-	}
+		template<std::floating_point F>
+		LAB_constexpr F QuadrantPick(uint8_t const pickSecond, F const first, F const second) {
+			QuadrantBits<F> const mask = QuadrantBits<F>(0) - QuadrantBits<F>(pickSecond & 1);
+			return std::bit_cast<F>((std::bit_cast<QuadrantBits<F>>(first) & ~mask) | (std::bit_cast<QuadrantBits<F>>(second) & mask));
+		}
+		template<std::floating_point F>
+		LAB_constexpr F QuadrantNegate(uint8_t const negate, F const value) {
+			return std::bit_cast<F>(std::bit_cast<QuadrantBits<F>>(value) ^ (QuadrantBits<F>(negate & 1) << (sizeof(F) * 8 - 1)));
+		}
 
-	template<std::floating_point F>
-	LAB_constexpr F Tan(F const input) {
-		//return Sin(input) / Cos(input);
+		//sin(quadrant * PI/2 + r)
+		template<std::floating_point F>
+		LAB_constexpr F QuadrantSin(QuadrantReduced<F> const reduced) {
+			return QuadrantNegate(static_cast<uint8_t>(reduced.quadrant >> 1), QuadrantPick(reduced.quadrant, reduced.sin, reduced.cos));
+		}
+		//cos(quadrant * PI/2 + r)
+		template<std::floating_point F>
+		LAB_constexpr F QuadrantCos(QuadrantReduced<F> const reduced) {
+			return QuadrantNegate(static_cast<uint8_t>((reduced.quadrant + 1) >> 1), QuadrantPick(reduced.quadrant, reduced.cos, reduced.sin));
+		}
 
-		constexpr F half_pi = GetPI_DividedBy(F(2));
-		constexpr F quarter_pi = GetPI_DividedBy(F(4));
+		//atan of an input in [0, 1]
+		template<Precision P, std::floating_point F>
+		LAB_constexpr F ArcTanUnit(F const minOverMax) {
+			if constexpr (P == Precision::Fast) {
+				//abramowitz and stegun 4.4.49, |error| <= 1e-5
+				F const t2 = minOverMax * minOverMax;
+				return minOverMax * (F(0.9998660) + t2 * (F(-0.3302995) + t2 * (F(0.1801410) + t2 * (F(-0.0851330) + t2 * F(0.0208351)))));
+			}
+			else if constexpr (P == Precision::Balanced) {
+				//https://developer.download.nvidia.com/cg/atan.html
+				const F t4 = minOverMax * minOverMax;
+				F t0 = 		  -F(0.013480470);
+				t0 = t0 * t4 + F(0.057477314);
+				t0 = t0 * t4 - F(0.121239071);
+				t0 = t0 * t4 + F(0.195635925);
+				t0 = t0 * t4 - F(0.332994597);
+				t0 = t0 * t4 + F(0.999995630);
+				return t0 * minOverMax;
+			}
+			else {
+				//atan(t) = PI/4 + atan((t - 1) / (t + 1)), which keeps the series argument under tan(PI/8)
+				F reduced = minOverMax;
+				F offset = F(0);
+				if (minOverMax > F(0.41421356237309504880)) {
+					reduced = (minOverMax - F(1)) / (minOverMax + F(1));
+					offset = GetPI_DividedBy(F(4));
+				}
+				constexpr std::size_t terms = std::is_same_v<F, float> ? 11 : 22;
+				return offset + reduced * Horner(reduced * reduced, arcTanCoefficients, terms);
+			}
+		}
+	}
 
-		F phased = PhaseTo(input, -half_pi, half_pi);
 
-		bool reflected = false;
-		if(phased > quarter_pi){
-			reflected = true;
-			phased = half_pi - phased;
-		}
-		else if (phased < -quarter_pi){
-			reflected = true;
-			phased = -half_pi - phased;
-		}
+	template<Precision P = DefaultPrecision, std::floating_point F>
+	LAB_constexpr F Sin(F const input) {
+		return detail::QuadrantSin(detail::ReduceQuadrant<P>(input));
+	}
 
-		const F p2 = phased * phased;
-		F result = phased * (F(1.0) + p2 * (F(0.33333333333) + 
-                    p2 * (F(0.13333333337) + 
-                    p2 * (F(0.0539682539) + 
-                    p2 * (F(0.0218694885) + 
-                    p2 * (F(0.0088632355) + 
-                    p2 * (F(0.0035920791))))))));
+	template<Precision P = DefaultPrecision, std::floating_point F>
+	LAB_constexpr F Cos(F const input) {
+		return detail::QuadrantCos(detail::ReduceQuadrant<P>(input));
+	}
 
-		if (reflected) {
-			return F(1.0) / result;
-		}
+	//one range reduction for both, the results match Sin and Cos exactly
+	//auto [sine, cosine] = SinCos(angle);
+	template<Precision P = DefaultPrecision, std::floating_point F>
+	LAB_constexpr SinCosPair<F> SinCos(F const input) {
+		const auto reduced = detail::ReduceQuadrant<P>(input);
+		return SinCosPair<F>{detail::QuadrantSin(reduced), detail::QuadrantCos(reduced)};
+	}
 
-		return result;
+	template<Precision P = DefaultPrecision, std::floating_point F>
+	LAB_constexpr F Tan(F const input) {
+		//tan(r + PI/2) == -cos(r) / sin(r)
+		const auto reduced = detail::ReduceQuadrant<P>(input);
+		const F numerator = detail::QuadrantNegate(reduced.quadrant, detail::QuadrantPick(reduced.quadrant, reduced.sin, reduced.cos));
+		return numerator / detail::QuadrantPick(reduced.quadrant, reduced.cos, reduced.sin);
 	}
 
 
-	template<std::floating_point F>
+	//Fast is the same as Balanced, the 4 term polynomial is already the cheap one and the single newton step Sqrt would dominate the error
+	//Precise is abramowitz and stegun 4.4.46, |error| <= 2e-8 for float and double alike, so double Precise is only float accurate here
+	template<Precision P = DefaultPrecision, std::floating_point F>
 	LAB_constexpr F ArcCos(F const input) {
 		//https://developer.download.nvidia.com/cg/acos.html
 
@@ -106,18 +233,25 @@ namespace lab {
 
 		const F negate = F(input < 0);
 		const F absInput = Abs(input);
-		F ret = F(-0.0187293);
-		ret *= absInput;
-		ret += F(0.0742610);
-		ret *= absInput;
-		ret -= F(0.2121144);
-		ret *= absInput;
-		ret += F(1.5707288);
-		ret *= Sqrt(F(1.0) - absInput);
+		F ret;
+		if constexpr (P == Precision::Precise) {
+			ret = F(1.5707963050) + absInput * (F(-0.2145988016) + absInput * (F(0.0889789874) + absInput * (F(-0.0501743046)
+				+ absInput * (F(0.0308918810) + absInput * (F(-0.0170881256) + absInput * (F(0.0066700901) + absInput * F(-0.0012624911)))))));
+		}
+		else {
+			ret = F(-0.0187293);
+			ret *= absInput;
+			ret += F(0.0742610);
+			ret *= absInput;
+			ret -= F(0.2121144);
+			ret *= absInput;
+			ret += F(1.5707288);
+		}
+		ret *= Sqrt<(P == Precision::Fast) ? Precision::Balanced : P>(F(1.0) - absInput);
 		ret -= F(2) * negate * ret;
 		return negate * PI<F> + ret;
 	}
-	template<std::floating_point F>
+	template<Precision P = DefaultPrecision, std::floating_point F>
 	LAB_constexpr F ArcSin(F const input) {
 		//https://developer.download.nvidia.com/cg/index_stdlib.html
 #ifdef LAB_MATH_DEBUG
@@ -126,18 +260,27 @@ namespace lab {
 #endif
 		const F negate = F(input < 0);
 		const F absInput = Abs(input);
-		F ret = F(-0.0187293);
-		ret *= absInput;
-		ret += F(0.0742610);
-		ret *= absInput;
-		ret -= F(0.2121144);
-		ret *= absInput;
-
-		ret += F(1.5707288);
-		ret = GetPI(F(0.5)) - Sqrt(F(1.0) - absInput) * ret;
+		F ret;
+		if constexpr (P == Precision::Precise) {
+			ret = F(1.5707963050) + absInput * (F(-0.2145988016) + absInput * (F(0.0889789874) + absInput * (F(-0.0501743046)
+				+ absInput * (F(0.0308918810) + absInput * (F(-0.0170881256) + absInput * (F(0.0066700901) + absInput * F(-0.0012624911)))))));
+		}
+		else {
+			ret = F(-0.0187293);
+			ret *= absInput;
+			ret += F(0.0742610);
+			ret *= absInput;
+			ret -= F(0.2121144);
+			ret *= absInput;
+
+			ret += F(1.5707288);
+		}
+		ret = GetPI(F(0.5)) - Sqrt<(P == Precision::Fast) ? Precision::Balanced : P>(F(1.0) - absInput) * ret;
 		return ret - F(2) * negate * ret;
 	}
-	template<std::floating_point F>
+
+	//Fast is abramowitz and stegun 4.4.49, Balanced is the nvidia polynomial, Precise is a series after reducing below tan(PI/8)
+	template<Precision P = DefaultPrecision, std::floating_point F>
 	LAB_constexpr F ArcTan(F const y) {
 #ifdef LAB_MATH_DEBUG
 		Debug_Anomaly_Check<F, true>(y);
@@ -146,21 +289,15 @@ namespace lab {
 		const F absX = F(1);
 		const F absY = Abs(y);
 		const bool yBigger = absY > absX;
-		const F minOverMax = absX / absY * F(yBigger) + absY / absX * F(!yBigger);
-		const F t4 = minOverMax * minOverMax;
-		F t0 = -F(0.013480470);
-		t0 = t0 * t4 + F(0.057477314);
-		t0 = t0 * t4 - F(0.121239071);
-		t0 = t0 * t4 + F(0.195635925);
-		t0 = t0 * t4 - F(0.332994597);
-		t0 = t0 * t4 + F(0.999995630);
-		F t3 = t0 * minOverMax;
+		//a select rather than multiplying both quotients by 0 and 1, 0 * inf made atan(0) NaN
+		const F minOverMax = yBigger ? absX / absY : absY / absX;
+		F t3 = detail::ArcTanUnit<P>(minOverMax);
 
 
 		t3 = (yBigger) ? GetPI(F(0.5)) - t3 : t3;
 		return (y < F(0)) ? -t3 : t3;
 	}
-	template<std::floating_point F>
+	template<Precision P = DefaultPrecision, std::floating_point F>
 	LAB_constexpr F ArcTan2(F const y, F const x){
 		//https://developer.download.nvidia.com/cg/atan2.html
 		//heavily paraphrased, they had to be trolling
@@ -176,18 +313,11 @@ namespace lab {
 
 		const bool yBigger = absY > absX;
 		//const F minOverMax = Min(absX, absY) / Max(absX, absY);
-		const F minOverMax = absX / absY * F(yBigger) + absY / absX * F(!yBigger);
+		const F minOverMax = yBigger ? absX / absY : absY / absX;
+
+		F t3 = detail::ArcTanUnit<P>(minOverMax);
 
-		const F t4 = minOverMax * minOverMax;
-		F t0 = 		  -F(0.013480470);
-		t0 = t0 * t4 + F(0.057477314);
-		t0 = t0 * t4 - F(0.121239071);
-		t0 = t0 * t4 + F(0.195635925);
-		t0 = t0 * t4 - F(0.332994597);
-		t0 = t0 * t4 + F(0.999995630);
-		F t3 = t0 * minOverMax;
 
-		
 		t3 = (yBigger) ? GetPI(F(0.5)) - t3 : t3;
 		t3 = (x < F(0)) ?  PI<F> - t3 : t3;
 		return (y < F(0)) ? -t3 : t3;
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Trig.h"
+#include "SIMD.h"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+//span versions of Sin, Cos and Tan
+//the SIMD kernels run the same quadrant reduction and polynomials as the scalar functions in Trig.h, with the branches replaced by blends
+//so the batch results are bit identical to calling Sin/Cos/Tan per element, and carry the same error
+//the SIMD path is float only, double and the leftover tail go through the scalar functions
+//the tier is a template parameter like the scalar functions, after F since F can't be deduced through the spans. SinBatch<float, Precision::Fast>
+//input and output are allowed to be the same span
+
+namespace lab {
+	namespace detail {
+#ifdef USING_SIMD
+		struct QuadrantReducedSIMD {
+			SIMD::Float sin; //of r
+			SIMD::Float cos; //of r
+			SIMD::Int quadrant; //only the low 2 bits are meaningful
+		};
+
+		template<std::size_t Count>
+		inline SIMD::Float HornerSIMD(SIMD::Float const z, double const (&coefficients)[Count], std::size_t const used) {
+			SIMD::Float ret = SIMD::Set1(float(coefficients[used - 1]));
+			for (std::size_t i = used - 1; i > 0; i--) {
+				ret = SIMD::Add(SIMD::Mul(ret, z), SIMD::Set1(float(coefficients[i - 1])));
+			}
+			return ret;
+		}
+
+		//ReduceQuadrant, float
+		template<Precision P>
+		inline QuadrantReducedSIMD ReduceQuadrantSIMD(SIMD::Float const input) {
+			const SIMD::Float shifted = SIMD::Add(SIMD::Mul(input, SIMD::Set1(float(0.63661977236758134308))), SIMD::Set1(12582912.f));
+			const SIMD::Float k = SIMD::Sub(shifted, SIMD::Set1(12582912.f));
+
+			SIMD::Float r;
+			if constexpr (P != Precision::Precise) {
+				r = SIMD::Sub(SIMD::Sub(input, SIMD::Mul(k, SIMD::Set1(1.5703125f))), SIMD::Mul(k, SIMD::Set1(float(4.8382679489661923e-4))));
+			}
+			else {
+				r = SIMD::Sub(SIMD::Sub(input, SIMD::Mul(k, SIMD::Set1(1.5703125f))), SIMD::Mul(k, SIMD::Set1(4.837512969970703125e-4f)));
+				r = SIMD::Sub(r, SIMD::Mul(k, SIMD::Set1(7.54978995489188216e-8f)));
+			}
+			const SIMD::Float z = SIMD::Mul(r, r);
+			QuadrantReducedSIMD ret;
+			ret.quadrant = SIMD::AsInt(shifted);
+			ret.sin = SIMD::Mul(r, HornerSIMD(z, sinCoefficients, QuadrantSinTerms<P, float>));
+			ret.cos = HornerSIMD(z, cosCoefficients, QuadrantCosTerms<P, float>);
+			return ret;
+		}
+
+		//the scalar negation flips the sign bit, so does this. bit 31 of signBits picks the lanes
+		inline SIMD::Float FlipSign(SIMD::Float const value, SIMD::Int const signBits) {
+			return SIMD::AsFloat(SIMD::XorInt(SIMD::AsInt(value), SIMD::AndInt(signBits, SIMD::Set1Int(INT32_MIN))));
+		}
+
+		//Select (blendv) only reads the sign bit of the mask, so quadrant bit 0 shifted up to bit 31 is the odd quadrant mask
+		template<Precision P>
+		inline SIMD::Float SinSIMD(SIMD::Float const input) {
+			const QuadrantReducedSIMD reduced = ReduceQuadrantSIMD<P>(input);
+			const SIMD::Float value = SIMD::Select(SIMD::AsFloat(SIMD::ShiftLeft(reduced.quadrant, 31)), reduced.cos, reduced.sin);
+			return FlipSign(value, SIMD::ShiftLeft(reduced.quadrant, 30));
+		}
+
+		template<Precision P>
+		inline SIMD::Float CosSIMD(SIMD::Float const input) {
+			const QuadrantReducedSIMD reduced = ReduceQuadrantSIMD<P>(input);
+			const SIMD::Float value = SIMD::Select(SIMD::AsFloat(SIMD::ShiftLeft(reduced.quadrant, 31)), reduced.sin, reduced.cos);
+			return FlipSign(value, SIMD::ShiftLeft(SIMD::AddInt(reduced.quadrant, SIMD::Set1Int(1)), 30));
+		}
+
+		template<Precision P>
+		inline SIMD::Float TanSIMD(SIMD::Float const input) {
+			const QuadrantReducedSIMD reduced = ReduceQuadrantSIMD<P>(input);
+			const SIMD::Int oddBits = SIMD::ShiftLeft(reduced.quadrant, 31);
+			const SIMD::Float odd = SIMD::AsFloat(oddBits);
+			//odd quadrants are -cos / sin, the cos is only negated in those lanes
+			const SIMD::Float numerator = SIMD::Select(odd, FlipSign(reduced.cos, oddBits), reduced.sin);
+			const SIMD::Float denominator = SIMD::Select(odd, reduced.sin, reduced.cos);
+			return SIMD::Div(numerator, denominator);
+		}
+#endif
+
+		enum class TrigFunction : uint8_t {
+			Sin,
+			Cos,
+			Tan,
+		};
+
+		template<TrigFunction Func, Precision P, std::floating_point F>
+		LAB_constexpr void TrigBatch(std::span<const F> const input, std::span<F> const output) {
+#if LAB_DEBUGGING_ACCESS
+			assert(output.size() >= input.size());
+#endif
+			std::size_t i = 0;
+#ifdef USING_SIMD
+			if !consteval {
+				if constexpr (std::is_same_v<F, float>) {
+					for (; i + SIMD::FloatWidth <= input.size(); i += SIMD::FloatWidth) {
+						const SIMD::Float lanes = SIMD::LoadU(&input[i]);
+						if constexpr (Func == TrigFunction::Sin) {
+							SIMD::StoreU(&output[i], SinSIMD<P>(lanes));
+						}
+						else if constexpr (Func == TrigFunction::Cos) {
+							SIMD::StoreU(&output[i], CosSIMD<P>(lanes));
+						}
+						else {
+							SIMD::StoreU(&output[i], TanSIMD<P>(lanes));
+						}
+					}
+				}
+			}
+#endif
+			for (; i < input.size(); i++) {
+				if constexpr (Func == TrigFunction::Sin) {
+					output[i] = Sin<P>(input[i]);
+				}
+				else if constexpr (Func == TrigFunction::Cos) {
+					output[i] = Cos<P>(input[i]);
+				}
+				else {
+					output[i] = Tan<P>(input[i]);
+				}
+			}
+		}
+	}
+
+	template<std::floating_point F, Precision P = DefaultPrecision>
+	LAB_constexpr void SinBatch(std::type_identity_t<std::span<const F>> const input, std::type_identity_t<std::span<F>> const output) {
+		detail::TrigBatch<detail::TrigFunction::Sin, P, F>(input, output);
+	}
+	template<std::floating_point F, Precision P = DefaultPrecision>
+	LAB_constexpr void CosBatch(std::type_identity_t<std::span<const F>> const input, std::type_identity_t<std::span<F>> const output) {
+		detail::TrigBatch<detail::TrigFunction::Cos, P, F>(input, output);
+	}
+	template<std::floating_point F, Precision P = DefaultPrecision>
+	LAB_constexpr void TanBatch(std::type_identity_t<std::span<const F>> const input, std::type_identity_t<std::span<F>> const output) {
+		detail::TrigBatch<detail::TrigFunction::Tan, P, F>(input, output);
+	}
+}
@@ -2,6 +2,7 @@
 
 #include "Transform/Transform2.h"
 #include "Transform/Transform3.h"
+#include "Transform/TransformHierarchy.h"
 
 namespace lab{
     using Transform2 = Transform<float, 2>;
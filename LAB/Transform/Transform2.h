@@ -0,0 +1,35 @@
+#pragma once
+#include "../Matrix.h"
+#include "../Vector.h"
+#include "../Support/Trig.h"
+
+namespace lab {
+    template<std::floating_point F, uint8_t Dimensions>
+    struct Transform;
+
+    //translation, per axis scale, and a rotation in radians, turning the same way as RotateAroundZ
+    //the matrix is the homogeneous T * R * S, a 3x3 with the translation in the last column
+    template<std::floating_point F>
+    struct Transform<F, 2> {
+        Vector<F, 2> translation{F(0)};
+        Vector<F, 2> scale{F(1)};
+        F rotation = F(0);
+
+        LAB_constexpr Transform() {}
+        LAB_constexpr Transform(Vector<F, 2> const translation, Vector<F, 2> const scale, F const rotation) : translation{translation}, scale{scale}, rotation{rotation} {}
+
+        LAB_constexpr Matrix<F, 3, 3> GetMatrix() const {
+            const auto [sinAngle, cosine] = SinCos(rotation);
+#ifdef LAB_LEFT_HANDED
+            const F sine = -sinAngle;
+#else
+            const F sine = sinAngle;
+#endif
+            return Matrix<F, 3, 3>{
+                Vector<F, 3>{cosine * scale.x, -sine * scale.x, F(0)},
+                Vector<F, 3>{sine * scale.y, cosine * scale.y, F(0)},
+                Vector<F, 3>{translation.x, translation.y, F(1)}
+            };
+        }
+    };
+}
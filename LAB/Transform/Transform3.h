@@ -0,0 +1,63 @@
+#pragma once
+#include "../Matrix.h"
+#include "../Vector.h"
+#include "../Support/Trig.h"
+
+namespace lab {
+    template<std::floating_point F, uint8_t Dimensions>
+    struct Transform;
+
+    //translation, per axis scale, and euler rotation in radians
+    //the matrix is T * Ry * Rx * Rz * S. scale first, then z, x, y rotation, then translation
+    template<std::floating_point F>
+    struct Transform<F, 3> {
+        Vector<F, 3> translation{F(0)};
+        Vector<F, 3> scale{F(1)};
+        Vector<F, 3> rotation{F(0)};
+
+        LAB_constexpr Transform() {}
+        LAB_constexpr Transform(Vector<F, 3> const translation, Vector<F, 3> const scale, Vector<F, 3> const rotation) : translation{translation}, scale{scale}, rotation{rotation} {}
+
+        LAB_constexpr Matrix<F, 4, 4> GetRotationXMatrix() const {
+            return RotateAroundX(rotation.x);
+        }
+        LAB_constexpr Matrix<F, 4, 4> GetRotationYMatrix() const {
+            return RotateAroundY(rotation.y);
+        }
+        LAB_constexpr Matrix<F, 4, 4> GetRotationZMatrix() const {
+            return RotateAroundZ(rotation.z);
+        }
+        LAB_constexpr Matrix<F, 4, 4> GetRotationMatrix() const {
+            return GetRotationYMatrix() * GetRotationXMatrix() * GetRotationZMatrix();
+        }
+        LAB_constexpr Matrix<F, 4, 4> GetScaleMatrix() const {
+            return IdentityScale(scale);
+        }
+        LAB_constexpr Matrix<F, 4, 4> GetTranslationMatrix() const {
+            return IdentityTranslation(translation);
+        }
+
+        //T * R * S without the two extra multiplies, scale only touches the rotation's columns
+        LAB_constexpr Matrix<F, 4, 4> GetMatrix() const {
+            Matrix<F, 4, 4> ret = GetRotationMatrix();
+            for (uint8_t column = 0; column < 3; column++) {
+                ret.columns[column] = ret.columns[column] * scale[column];
+            }
+            ret.columns[3] = typename Matrix<F, 4, 4>::ColType(translation.x, translation.y, translation.z, F(1));
+            return ret;
+        }
+
+        //inverse transpose of the upper 3x3, R * S^-1, for transforming normals under non uniform scale
+        LAB_constexpr Matrix<F, 3, 3> GetNormalMatrix() const {
+            const Matrix<F, 4, 4> rot = GetRotationMatrix();
+            Matrix<F, 3, 3> ret{};
+            for (uint8_t column = 0; column < 3; column++) {
+                const F invScale = F(1) / scale[column];
+                for (uint8_t row = 0; row < 3; row++) {
+                    ret.columns[column][row] = rot.columns[column][row] * invScale;
+                }
+            }
+            return ret;
+        }
+    };
+}
@@ -5,7 +5,10 @@
 #include "Vector/Vector3.h"
 #include "Vector/Vector4.h"
 #include "Vector/Vector4SIMD.h"
+#include "Vector/Vector8SIMD.h"
 #include "Vector/IntVector.h"
+#include "Vector/VectorSoA.h"
+#include "Vector/PackedVector.h"
 
 namespace lab{
 
@@ -1,22 +1,21 @@
 #pragma once
 
 #include "VectorTemplate.h"
+#include "VectorSoA.h"
+#include "../Support/SIMD.h"
 
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <cstring>
-#include <cmath> //just for isnan
-//straight ripped from glm
+#include <limits>
+#include <span>
+#include <type_traits>
 
 namespace lab{
     namespace detail{
-        inline void hash_combine(std::size_t &seed, std::size_t hash)
-        {
-            hash += 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= hash;
-        }
-
         //https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
-        inline uint32_t fmix32 ( uint32_t h ) {
+        inline LAB_constexpr uint32_t fmix32 ( uint32_t h ) {
             h ^= h >> 16;
             h *= 0x85ebca6b;
             h ^= h >> 13;
@@ -27,75 +26,166 @@ namespace lab{
         }
 
 
-        inline uint32_t rotl32 ( uint32_t x, int8_t r ) {
+        inline LAB_constexpr uint32_t rotl32 ( uint32_t x, int8_t r ) {
             return (x << r) | (x >> (32 - r));
         }
 
-        inline uint32_t getblock32 ( const uint32_t * p, int i ) {
-            return p[i];
-        }
-
-        uint32_t MurmurHash3_x86_32 ( const void * key, int len, uint32_t seed) {
-            const uint8_t * data = (const uint8_t*)key;
-            const int nblocks = len / 4;
-
-            uint32_t h1 = seed;
-
-            const uint32_t c1 = 0xcc9e2d51;
-            const uint32_t c2 = 0x1b873593;
+        //one 4 byte block of the MurmurHash3_x86_32 body
+        inline LAB_constexpr uint32_t MurmurBlock(uint32_t h1, uint32_t k1) {
+            k1 *= 0xcc9e2d51;
+            k1 = rotl32(k1, 15);
+            k1 *= 0x1b873593;
 
-            //----------
-            // body
-
-            const uint32_t * blocks = (const uint32_t *)(data + nblocks*4);
-
-            for(int i = -nblocks; i; i++) {
-                uint32_t k1 = getblock32(blocks,i);
+            h1 ^= k1;
+            h1 = rotl32(h1, 13);
+            return h1 * 5 + 0xe6546b64;
+        }
+        //length is in bytes
+        inline LAB_constexpr uint32_t MurmurFinish(uint32_t const h1, uint32_t const length) {
+            return fmix32(h1 ^ length);
+        }
 
-                k1 *= c1;
-                k1 = rotl32(k1,15);
-                k1 *= c2;
-                
-                h1 ^= k1;
-                h1 = rotl32(h1,13); 
-                h1 = h1*5+0xe6546b64;
+        //the bits of value with -0 folded into 0 and every NaN folded into the one quiet NaN
+        //so values that compare equal, or are both NaN, hash the same
+        template<std::floating_point F>
+        LAB_constexpr auto CanonicalBits(F const value) {
+            using Bits = std::conditional_t<sizeof(F) == 4, uint32_t, uint64_t>;
+            if (value != value) {
+                return std::bit_cast<Bits>(std::numeric_limits<F>::quiet_NaN());
             }
+            if (value == F(0)) {
+                return Bits(0);
+            }
+            return std::bit_cast<Bits>(value);
+        }
 
-            //----------
-            // tail
-
-            const uint8_t * tail = (const uint8_t*)(data + nblocks*4);
-
-            uint32_t k1 = 0;
-
-            switch(len & 3) {
-                case 3: k1 ^= tail[2] << 16;
-                case 2: k1 ^= tail[1] << 8;
-                case 1: k1 ^= tail[0];
-                        k1 *= c1; k1 = rotl32(k1,15); k1 *= c2; h1 ^= k1;
-            };
-
-            //----------
-            // finalization
-
-            h1 ^= len;
-
-            h1 = fmix32(h1);
-
-            return h1;
-        } 
-
+        //the same value MurmurHash3_x86_32 gives for the float's bytes, after CanonicalBits
+        inline LAB_constexpr uint32_t HashFloat(float f, uint32_t seed = 0) {
+            return MurmurFinish(MurmurBlock(seed, CanonicalBits(f)), sizeof(float));
+        }
 
-        uint32_t HashFloat(float f, uint32_t seed = 0) {
-            if (f == 0.0f) {
-                f = 0.0f; //this removes the sign from -0.0f
+#ifdef USING_SIMD
+        //CanonicalBits, MurmurBlock and MurmurFinish across the lanes, same results per lane
+        inline SIMD::Int CanonicalBitsLanes(SIMD::Float value) {
+            const SIMD::Float zero = SIMD::Set1(0.f);
+            value = SIMD::Select(SIMD::Equal(value, zero), zero, value);
+            value = SIMD::Select(SIMD::Unordered(value, value), SIMD::Set1(std::numeric_limits<float>::quiet_NaN()), value);
+            return SIMD::AsInt(value);
+        }
+        inline SIMD::Int RotateLeftLanes(SIMD::Int const val, int const count) {
+            return SIMD::OrInt(SIMD::ShiftLeft(val, count), SIMD::ShiftRight(val, 32 - count));
+        }
+        inline SIMD::Int MurmurBlockLanes(SIMD::Int h1, SIMD::Int k1) {
+            k1 = SIMD::MulInt(k1, SIMD::Set1Int(static_cast<int32_t>(0xcc9e2d51)));
+            k1 = RotateLeftLanes(k1, 15);
+            k1 = SIMD::MulInt(k1, SIMD::Set1Int(static_cast<int32_t>(0x1b873593)));
+
+            h1 = SIMD::XorInt(h1, k1);
+            h1 = RotateLeftLanes(h1, 13);
+            return SIMD::AddInt(SIMD::MulInt(h1, SIMD::Set1Int(5)), SIMD::Set1Int(static_cast<int32_t>(0xe6546b64)));
+        }
+        inline SIMD::Int MurmurFinishLanes(SIMD::Int h, uint32_t const length) {
+            h = SIMD::XorInt(h, SIMD::Set1Int(static_cast<int32_t>(length)));
+            h = SIMD::XorInt(h, SIMD::ShiftRight(h, 16));
+            h = SIMD::MulInt(h, SIMD::Set1Int(static_cast<int32_t>(0x85ebca6b)));
+            h = SIMD::XorInt(h, SIMD::ShiftRight(h, 13));
+            h = SIMD::MulInt(h, SIMD::Set1Int(static_cast<int32_t>(0xc2b2ae35)));
+            return SIMD::XorInt(h, SIMD::ShiftRight(h, 16));
+        }
+        template<uint8_t Dimensions>
+        inline SIMD::Int HashLanes(SIMD::Float const (&components)[Dimensions], uint32_t const seed) {
+            SIMD::Int h = SIMD::Set1Int(static_cast<int32_t>(seed));
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                h = MurmurBlockLanes(h, CanonicalBitsLanes(components[dim]));
             }
+            return MurmurFinishLanes(h, Dimensions * sizeof(float));
+        }
+#endif
+    }
 
-            if (std::isnan(f)) {
-                f = std::numeric_limits<float>::quiet_NaN();
+    //MurmurHash3_x86_32 over the canonical bits (see detail::CanonicalBits) of the whole vector in one pass, x first
+    //constexpr, so compile time tables built with it match what the runtime computes. HashBatch gives the same values
+    template<std::floating_point F, uint8_t Dimensions>
+    LAB_constexpr uint32_t Hash(Vector<F, Dimensions> const& vec, uint32_t const seed = 0) {
+        uint32_t h1 = seed;
+        for (uint8_t dim = 0; dim < Dimensions; dim++) {
+            const auto bits = detail::CanonicalBits(vec[dim]);
+            if constexpr (sizeof(F) == 4) {
+                h1 = detail::MurmurBlock(h1, bits);
             }
+            else {
+                h1 = detail::MurmurBlock(h1, static_cast<uint32_t>(bits));
+                h1 = detail::MurmurBlock(h1, static_cast<uint32_t>(bits >> 32));
+            }
+        }
+        return detail::MurmurFinish(h1, Dimensions * sizeof(F));
+    }
 
-            return MurmurHash3_x86_32(&f, sizeof(float), seed);
+    //out[i] = Hash(vectors[i], seed)
+    //F isnt deduced from spans, call it as HashBatch<float, 3>(vectors, out)
+    template<std::floating_point F, uint8_t Dimensions>
+    LAB_constexpr void HashBatch(std::type_identity_t<std::span<const Vector<F, Dimensions>>> const vectors, std::span<uint32_t> const out, uint32_t const seed = 0) {
+#if LAB_DEBUGGING_ACCESS
+        assert(out.size() >= vectors.size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                for (; i + SIMD::FloatWidth <= vectors.size(); i += SIMD::FloatWidth) {
+                    SIMD::Float components[Dimensions];
+                    if constexpr (Dimensions == 3) {
+                        SIMD::LoadVec3s(&vectors[i].x, components);
+                    }
+                    else if constexpr (Dimensions == 4) {
+                        SIMD::Float lanes[4];
+                        SIMD::LoadTransposed(&vectors[i].x, 4, lanes);
+                        for (uint8_t dim = 0; dim < 4; dim++) {
+                            components[dim] = lanes[dim];
+                        }
+                    }
+                    else {
+                        alignas(SIMD::Alignment) float lanes[Dimensions][SIMD::FloatWidth];
+                        for (std::size_t lane = 0; lane < SIMD::FloatWidth; lane++) {
+                            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                                lanes[dim][lane] = vectors[i + lane][dim];
+                            }
+                        }
+                        for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                            components[dim] = SIMD::Load(lanes[dim]);
+                        }
+                    }
+                    SIMD::StoreU(reinterpret_cast<float*>(&out[i]), SIMD::AsFloat(detail::HashLanes<Dimensions>(components, seed)));
+                }
+            }
+        }
+#endif
+        for (; i < vectors.size(); i++) {
+            out[i] = Hash(vectors[i], seed);
+        }
+    }
+    //out[i] = Hash(vectors.Get(i), seed)
+    template<std::floating_point F, uint8_t Dimensions>
+    LAB_constexpr void HashBatch(VectorSoA<F, Dimensions> const& vectors, std::span<uint32_t> const out, uint32_t const seed = 0) {
+#if LAB_DEBUGGING_ACCESS
+        assert(out.size() >= vectors.Size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                for (; i + SIMD::FloatWidth <= vectors.Size(); i += SIMD::FloatWidth) {
+                    SIMD::Float components[Dimensions];
+                    for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                        components[dim] = SIMD::Load(vectors.Stream(dim) + i);
+                    }
+                    SIMD::StoreU(reinterpret_cast<float*>(&out[i]), SIMD::AsFloat(detail::HashLanes<Dimensions>(components, seed)));
+                }
+            }
+        }
+#endif
+        for (; i < vectors.Size(); i++) {
+            out[i] = Hash(vectors.Get(i), seed);
         }
     }
 }
@@ -104,18 +194,7 @@ namespace std {
     template<std::floating_point F, uint8_t Dimensions>
     struct hash<lab::Vector<F, Dimensions>> {
         std::size_t operator()(lab::Vector<F, Dimensions> const& v) const {
-            std::size_t seed = 0;
-
-            lab::detail::hash_combine(seed, lab::detail::HashFloat(v.x));
-            lab::detail::hash_combine(seed, lab::detail::HashFloat(v.y));
-            if constexpr (Dimensions >= 3) {
-                lab::detail::hash_combine(seed, lab::detail::HashFloat(v.z));
-            }
-            if constexpr (Dimensions == 4) {
-                lab::detail::hash_combine(seed, lab::detail::HashFloat(v.w));
-            }
-
-            return seed;
+            return lab::Hash(v);
         }
     };
-}
\ No newline at end of file
+}
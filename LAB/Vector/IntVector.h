@@ -18,7 +18,9 @@ namespace lab {
 		LAB_constexpr IntVector(I const _x, I const _y) : x{ _x }, y{ _y } {}
 		LAB_constexpr IntVector(I const all) : x{ all }, y{ all } {}
 
-		I& operator[](uint8_t index){
+		LAB_constexpr bool operator==(IntVector const& other) const = default;
+
+		LAB_constexpr I& operator[](uint8_t index){
 			switch(index){
 				case 0: return x;
 				case 1: return y;
@@ -26,7 +28,7 @@ namespace lab {
 			}
 			std::unreachable();
 		}
-		I operator[](uint8_t index) const {
+		LAB_constexpr I operator[](uint8_t index) const {
 			switch(index){
 				case 0: return x;
 				case 1: return y;
@@ -43,8 +45,10 @@ namespace lab {
 		LAB_constexpr IntVector() {}
 		LAB_constexpr IntVector(I const _x, I const _y, I const _z) : x{ _x }, y{ _y }, z{_z} {}
 		LAB_constexpr IntVector(I const all) : x{ all }, y{ all }, z{all} {}
+
+		LAB_constexpr bool operator==(IntVector const& other) const = default;
     
-		I& operator[](uint8_t index){
+		LAB_constexpr I& operator[](uint8_t index){
 			switch(index){
 				case 0: return x;
 				case 1: return y;
@@ -53,7 +57,7 @@ namespace lab {
 			}
 			std::unreachable();
 		}
-		I operator[](uint8_t index) const{
+		LAB_constexpr I operator[](uint8_t index) const{
 			switch(index){
 				case 0: return x;
 				case 1: return y;
@@ -73,7 +77,9 @@ namespace lab {
 		LAB_constexpr IntVector(I const _x, I const _y, I const _z, I const _w) : x{ _x }, y{ _y }, z{_z}, w{_w} {}
 		LAB_constexpr IntVector(I const all) : x{ all }, y{ all }, z{all}, w{all} {}
 
-		I& operator[](uint8_t index){
+		LAB_constexpr bool operator==(IntVector const& other) const = default;
+
+		LAB_constexpr I& operator[](uint8_t index){
 			switch(index){
 				case 0: return x;
 				case 1: return y;
@@ -83,7 +89,7 @@ namespace lab {
 			}
 			std::unreachable();
 		}
-		I operator[](uint8_t index) const {
+		LAB_constexpr I operator[](uint8_t index) const {
 			switch(index){
 				case 0: return x;
 				case 1: return y;
@@ -0,0 +1,282 @@
+#pragma once
+#include "VectorTemplate.h"
+#include "../Support/SIMD.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+//compact storage for float vectors, for network state and gpu upload buffers. there's no math on these, unpack to a Vector first
+//Half is IEEE 754 binary16, Snorm16 maps [-1, 1] onto [-32767, 32767], Unorm8 maps [0, 1] onto [0, 255], the same as the matching gpu formats
+//the scalar conversions are constexpr and bit exact with the batch ones, including F16C
+
+namespace lab {
+    enum class PackedFormat : uint8_t {
+        Half,
+        Snorm16,
+        Unorm8,
+    };
+
+    //IEEE 754 binary16 from a float, rounded to nearest even like F16C. too big goes to infinity, NaNs stay NaN (quieted, top payload bits kept)
+    inline LAB_constexpr uint16_t FloatToHalf(float const value) {
+        const uint32_t bits = std::bit_cast<uint32_t>(value);
+        const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+        const uint32_t magnitude = bits & 0x7FFFFFFF;
+        if (magnitude >= 0x7F800000) {
+            if (magnitude == 0x7F800000) {
+                return sign | 0x7C00;
+            }
+            return sign | 0x7E00 | static_cast<uint16_t>((magnitude >> 13) & 0x3FF);
+        }
+        //65520, halfway between the largest half (65504) and 65536, rounds to even, which is infinity
+        if (magnitude >= 0x477FF000) {
+            return sign | 0x7C00;
+        }
+        //below 2^-14, the smallest normal half
+        if (magnitude < 0x38800000) {
+            const uint32_t exponent = magnitude >> 23;
+            //under 2^-25 rounds to 0, that includes the float denormals
+            if (exponent < 102) {
+                return sign;
+            }
+            //the half denormal is the value in units of 2^-24
+            const uint32_t mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+            const uint32_t shift = 126 - exponent;
+            uint32_t rounded = mantissa >> shift;
+            const uint32_t remainder = mantissa & ((1u << shift) - 1);
+            const uint32_t halfway = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (rounded & 1))) {
+                rounded++;
+            }
+            return sign | static_cast<uint16_t>(rounded);
+        }
+        //rebias the exponent from 127 to 15, then round off the low 13 mantissa bits. a carry out of the mantissa bumps the exponent, which is still right
+        const uint32_t rebiased = magnitude - 0x38000000;
+        return sign | static_cast<uint16_t>((rebiased + 0xFFF + ((rebiased >> 13) & 1)) >> 13);
+    }
+
+    //exact, every half is a float
+    inline LAB_constexpr float HalfToFloat(uint16_t const half) {
+        const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+        const uint32_t exponent = (half >> 10) & 0x1F;
+        const uint32_t mantissa = half & 0x3FF;
+        if (exponent == 0x1F) {
+            //F16C quiets NaNs on the way up too
+            return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13) | (mantissa != 0 ? 0x400000u : 0u));
+        }
+        if (exponent == 0) {
+            if (mantissa == 0) {
+                return std::bit_cast<float>(sign);
+            }
+            //denormal half, shift the leading 1 up to the implicit bit
+            const int leading = std::countl_zero(mantissa) - 21;
+            return std::bit_cast<float>(sign | static_cast<uint32_t>(113 - leading) << 23 | ((mantissa << leading) & 0x3FF) << 13);
+        }
+        return std::bit_cast<float>(sign | (exponent + 112) << 23 | mantissa << 13);
+    }
+
+    //clamped to [-1, 1], NaN packs as -1
+    //the comparisons are ordered like SIMD::Max and SIMD::Min, so the batch clamps NaN the same way
+    inline LAB_constexpr int16_t FloatToSnorm16(float const value) {
+        float clamped = (value > -1.f) ? value : -1.f;
+        clamped = (clamped < 1.f) ? clamped : 1.f;
+        const float scaled = clamped * 32767.f;
+        return static_cast<int16_t>(detail::RoundToInt(scaled));
+    }
+    //-32768 and -32767 are both -1
+    inline LAB_constexpr float Snorm16ToFloat(int16_t const value) {
+        const float ret = static_cast<float>(value) / 32767.f;
+        return (ret > -1.f) ? ret : -1.f;
+    }
+
+    //clamped to [0, 1], NaN packs as 0
+    inline LAB_constexpr uint8_t FloatToUnorm8(float const value) {
+        float clamped = (value > 0.f) ? value : 0.f;
+        clamped = (clamped < 1.f) ? clamped : 1.f;
+        const float scaled = clamped * 255.f;
+        return static_cast<uint8_t>(detail::RoundToInt(scaled));
+    }
+    inline LAB_constexpr float Unorm8ToFloat(uint8_t const value) {
+        return static_cast<float>(value) / 255.f;
+    }
+
+    namespace detail {
+        template<PackedFormat Format>
+        struct PackedComponent {};
+        template<>
+        struct PackedComponent<PackedFormat::Half> {
+            using Type = uint16_t;
+            static LAB_constexpr Type Pack(float const value) { return FloatToHalf(value); }
+            static LAB_constexpr float Unpack(Type const value) { return HalfToFloat(value); }
+        };
+        template<>
+        struct PackedComponent<PackedFormat::Snorm16> {
+            using Type = int16_t;
+            static LAB_constexpr Type Pack(float const value) { return FloatToSnorm16(value); }
+            static LAB_constexpr float Unpack(Type const value) { return Snorm16ToFloat(value); }
+        };
+        template<>
+        struct PackedComponent<PackedFormat::Unorm8> {
+            using Type = uint8_t;
+            static LAB_constexpr Type Pack(float const value) { return FloatToUnorm8(value); }
+            static LAB_constexpr float Unpack(Type const value) { return Unorm8ToFloat(value); }
+        };
+    }
+
+    //a Vector<float, Dimensions> stored as Dimensions packed components, no padding, so a span of them can go straight into a buffer
+    template<PackedFormat Format, uint8_t Dimensions>
+    requires((Dimensions > 1) && (Dimensions <= 4))
+    struct PackedVector {
+        using Component = typename detail::PackedComponent<Format>::Type;
+        Component data[Dimensions];
+
+        LAB_constexpr PackedVector() : data{} {}
+        explicit LAB_constexpr PackedVector(Vector<float, Dimensions> const& vec) {
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                data[dim] = detail::PackedComponent<Format>::Pack(vec[dim]);
+            }
+        }
+
+        LAB_constexpr Vector<float, Dimensions> Unpack() const {
+            Vector<float, Dimensions> ret;
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                ret[dim] = detail::PackedComponent<Format>::Unpack(data[dim]);
+            }
+            return ret;
+        }
+
+        LAB_constexpr bool operator==(PackedVector const& other) const = default;
+    };
+
+    using half2 = PackedVector<PackedFormat::Half, 2>;
+    using half3 = PackedVector<PackedFormat::Half, 3>;
+    using half4 = PackedVector<PackedFormat::Half, 4>;
+    using snorm16x2 = PackedVector<PackedFormat::Snorm16, 2>;
+    using snorm16x3 = PackedVector<PackedFormat::Snorm16, 3>;
+    using snorm16x4 = PackedVector<PackedFormat::Snorm16, 4>;
+    using unorm8x4 = PackedVector<PackedFormat::Unorm8, 4>;
+
+    namespace detail {
+#ifdef USING_SIMD
+        //Half needs F16C, the SSE build packs halfs one at a time
+        template<PackedFormat Format>
+#ifdef LAB_USING_F16C
+        inline constexpr bool HasPackLanes = true;
+#else
+        inline constexpr bool HasPackLanes = (Format != PackedFormat::Half);
+#endif
+
+        //SIMD::FloatWidth components at a time
+        template<PackedFormat Format>
+        inline void PackLanes(float const* input, typename PackedComponent<Format>::Type* output) {
+            if constexpr (Format == PackedFormat::Half) {
+#ifdef LAB_USING_F16C
+                SIMD::StoreFloat16s(output, SIMD::LoadU(input));
+#endif
+            }
+            else if constexpr (Format == PackedFormat::Snorm16) {
+                const SIMD::Float clamped = SIMD::Min(SIMD::Max(SIMD::LoadU(input), SIMD::Set1(-1.f)), SIMD::Set1(1.f));
+                SIMD::StoreInt16s(output, SIMD::RoundToInt(SIMD::Mul(clamped, SIMD::Set1(32767.f))));
+            }
+            else {
+                const SIMD::Float clamped = SIMD::Min(SIMD::Max(SIMD::LoadU(input), SIMD::Set1(0.f)), SIMD::Set1(1.f));
+                SIMD::StoreUint8s(output, SIMD::RoundToInt(SIMD::Mul(clamped, SIMD::Set1(255.f))));
+            }
+        }
+        template<PackedFormat Format>
+        inline void UnpackLanes(typename PackedComponent<Format>::Type const* input, float* output) {
+            if constexpr (Format == PackedFormat::Half) {
+#ifdef LAB_USING_F16C
+                SIMD::StoreU(output, SIMD::LoadFloat16s(input));
+#endif
+            }
+            else if constexpr (Format == PackedFormat::Snorm16) {
+                const SIMD::Float unpacked = SIMD::Div(SIMD::IntToFloat(SIMD::LoadInt16s(input)), SIMD::Set1(32767.f));
+                SIMD::StoreU(output, SIMD::Max(unpacked, SIMD::Set1(-1.f)));
+            }
+            else {
+                SIMD::StoreU(output, SIMD::Div(SIMD::IntToFloat(SIMD::LoadUint8s(input)), SIMD::Set1(255.f)));
+            }
+        }
+#endif
+    }
+
+    //output[i] = PackedVector(vectors[i])
+    //the vectors and the packed vectors are both tightly packed, so the SIMD path converts the components as one flat array whatever Dimensions is
+    //F isnt deduced from spans, call it as PackBatch<PackedFormat::Half, 3>(vectors, output)
+    template<PackedFormat Format, uint8_t Dimensions>
+    LAB_constexpr void PackBatch(std::type_identity_t<std::span<const Vector<float, Dimensions>>> const vectors, std::type_identity_t<std::span<PackedVector<Format, Dimensions>>> const output) {
+#if LAB_DEBUGGING_ACCESS
+        assert(output.size() >= vectors.size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (detail::HasPackLanes<Format>) {
+                static_assert(sizeof(Vector<float, Dimensions>) == sizeof(float) * Dimensions);
+                static_assert(sizeof(PackedVector<Format, Dimensions>) == sizeof(typename PackedVector<Format, Dimensions>::Component) * Dimensions);
+                const std::size_t componentCount = vectors.size() * Dimensions;
+                if (componentCount >= SIMD::FloatWidth) {
+                    float const* input = &vectors[0].x;
+                    auto* packed = output[0].data;
+                    std::size_t component = 0;
+                    for (; component + SIMD::FloatWidth <= componentCount; component += SIMD::FloatWidth) {
+                        detail::PackLanes<Format>(input + component, packed + component);
+                    }
+                    //finish the vector the last step stopped in, the scalar loop does the rest
+                    i = component / Dimensions;
+                    if (component % Dimensions != 0) {
+                        for (std::size_t dim = component; dim < (i + 1) * Dimensions; dim++) {
+                            packed[dim] = detail::PackedComponent<Format>::Pack(input[dim]);
+                        }
+                        i++;
+                    }
+                }
+            }
+        }
+#endif
+        for (; i < vectors.size(); i++) {
+            output[i] = PackedVector<Format, Dimensions>{vectors[i]};
+        }
+    }
+
+    //output[i] = packed[i].Unpack()
+    //F isnt deduced from spans, call it as UnpackBatch<PackedFormat::Half, 3>(packed, output)
+    template<PackedFormat Format, uint8_t Dimensions>
+    LAB_constexpr void UnpackBatch(std::type_identity_t<std::span<const PackedVector<Format, Dimensions>>> const packed, std::type_identity_t<std::span<Vector<float, Dimensions>>> const output) {
+#if LAB_DEBUGGING_ACCESS
+        assert(output.size() >= packed.size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (detail::HasPackLanes<Format>) {
+                static_assert(sizeof(Vector<float, Dimensions>) == sizeof(float) * Dimensions);
+                static_assert(sizeof(PackedVector<Format, Dimensions>) == sizeof(typename PackedVector<Format, Dimensions>::Component) * Dimensions);
+                const std::size_t componentCount = packed.size() * Dimensions;
+                if (componentCount >= SIMD::FloatWidth) {
+                    auto const* input = packed[0].data;
+                    float* unpacked = &output[0].x;
+                    std::size_t component = 0;
+                    for (; component + SIMD::FloatWidth <= componentCount; component += SIMD::FloatWidth) {
+                        detail::UnpackLanes<Format>(input + component, unpacked + component);
+                    }
+                    //finish the vector the last step stopped in, the scalar loop does the rest
+                    i = component / Dimensions;
+                    if (component % Dimensions != 0) {
+                        for (std::size_t dim = component; dim < (i + 1) * Dimensions; dim++) {
+                            unpacked[dim] = detail::PackedComponent<Format>::Unpack(input[dim]);
+                        }
+                        i++;
+                    }
+                }
+            }
+        }
+#endif
+        for (; i < packed.size(); i++) {
+            output[i] = packed[i].Unpack();
+        }
+    }
+}
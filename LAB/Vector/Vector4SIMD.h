@@ -9,7 +9,8 @@
 //need to come back and put constexpr branches into everything
 
 namespace lab{
-    struct VectorSIMD {
+    //the __m128 already needs 16, spelled out so the layout doesn't hide in the union
+    struct alignas(16) VectorSIMD {
         union {
             Vector<float, 4> component;
             __m128 vec;
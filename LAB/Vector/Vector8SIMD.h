@@ -0,0 +1,264 @@
+#pragma once
+
+#include "Vector4SIMD.h"
+
+#include <memory>
+
+#ifdef LAB_USING_AVX2
+
+namespace lab{
+    //8 float lanes, laid out as two vec4 halves. the low half is lanes 0-3, the high half is lanes 4-7
+    //the Dot/Magnitude/Normalize family works per half, treating this as two vec4s processed side by side
+    //aligned for the __m256, so both halves together are one aligned load
+    struct alignas(32) VectorSIMD8 {
+        union {
+            Vector<float, 4> components[2];
+            __m256 vec;
+        };
+        //simd cant be constexpr (currently)
+        [[nodiscard]] constexpr VectorSIMD8() : components{} {}
+        [[nodiscard]] VectorSIMD8(__m256 const& vec) : vec{vec} {}
+        [[nodiscard]] explicit LAB_constexpr VectorSIMD8(const float all) : components{Vector<float, 4>{all}, Vector<float, 4>{all}} {}
+        [[nodiscard]] LAB_constexpr VectorSIMD8(const float x0, const float y0, const float z0, const float w0, const float x1, const float y1, const float z1, const float w1)
+            : components{Vector<float, 4>{x0, y0, z0, w0}, Vector<float, 4>{x1, y1, z1, w1}} {}
+        [[nodiscard]] LAB_constexpr VectorSIMD8(Vector<float, 4> const& low, Vector<float, 4> const& high) : components{low, high} {}
+        [[nodiscard]] LAB_constexpr VectorSIMD8(VectorSIMD const& low, VectorSIMD const& high) {
+            if consteval{
+                std::construct_at(&components[0], low.component);
+                components[1] = high.component;
+            }
+            else{
+                vec = _mm256_set_m128(high.vec, low.vec);
+            }
+        }
+
+        LAB_constexpr VectorSIMD8(VectorSIMD8 const& other) noexcept {
+            if consteval{
+                std::construct_at(&components[0], other.components[0]);
+                components[1] = other.components[1];
+            }
+            else{
+                vec = other.vec;
+            }
+        }
+        LAB_constexpr VectorSIMD8(VectorSIMD8&& other) noexcept {
+            if consteval{
+                std::construct_at(&components[0], other.components[0]);
+                components[1] = other.components[1];
+            }
+            else{
+                vec = other.vec;
+            }
+        }
+        LAB_constexpr VectorSIMD8& operator=(VectorSIMD8 const& other){ //copy assignment
+            if consteval {
+                components[0] = other.components[0];
+                components[1] = other.components[1];
+            }
+            else {
+                vec = other.vec;
+            }
+            return *this;
+        }
+        LAB_constexpr VectorSIMD8& operator=(VectorSIMD8&& other) { //move assignment
+            if consteval {
+                components[0] = other.components[0];
+                components[1] = other.components[1];
+            }
+            else {
+                vec = other.vec;
+            }
+            return *this;
+        }
+
+        LAB_constexpr float& operator[](uint8_t const lane) {
+#if LAB_DEBUGGING_ACCESS
+            assert(lane < 8);
+#endif
+            return components[lane / 4][lane % 4];
+        }
+        LAB_constexpr float operator[](uint8_t const lane) const {
+#if LAB_DEBUGGING_ACCESS
+            assert(lane < 8);
+#endif
+            return components[lane / 4][lane % 4];
+        }
+
+        LAB_constexpr operator __m256() const {
+            return vec;
+        }
+
+        LAB_constexpr VectorSIMD Low() const {
+            if consteval{
+                return VectorSIMD{components[0]};
+            }
+            else{
+                return VectorSIMD{_mm256_castps256_ps128(vec)};
+            }
+        }
+        LAB_constexpr VectorSIMD High() const {
+            if consteval{
+                return VectorSIMD{components[1]};
+            }
+            else{
+                return VectorSIMD{_mm256_extractf128_ps(vec, 1)};
+            }
+        }
+
+        //copies lane Index of each half across that half, (x0, y0, z0, w0, x1, y1, z1, w1) with Index 1 becomes (y0, y0, y0, y0, y1, y1, y1, y1)
+        template<uint8_t Index>
+        requires(Index < 4)
+        LAB_constexpr VectorSIMD8 BroadcastLane() const {
+            if consteval{
+                return VectorSIMD8{Vector<float, 4>{components[0][Index]}, Vector<float, 4>{components[1][Index]}};
+            }
+            else{
+                return VectorSIMD8{_mm256_shuffle_ps(vec, vec, _MM_SHUFFLE(Index, Index, Index, Index))};
+            }
+        }
+
+        LAB_constexpr VectorSIMD8 operator-() const{
+            if consteval{
+                return VectorSIMD8{-components[0], -components[1]};
+            }
+            else{
+                return VectorSIMD8{_mm256_xor_ps(vec, _mm256_set1_ps(-0.f))};
+            }
+        }
+        LAB_constexpr bool operator==(VectorSIMD8 const other) const {
+            if consteval{
+                return (components[0] == other.components[0]) && (components[1] == other.components[1]);
+            }
+            else{
+                return _mm256_movemask_ps(_mm256_cmp_ps(vec, other.vec, _CMP_EQ_OQ)) == 0xFF;
+            }
+        }
+        LAB_constexpr VectorSIMD8 operator+(VectorSIMD8 const other) const {
+            if consteval{
+                return VectorSIMD8{components[0] + other.components[0], components[1] + other.components[1]};
+            }
+            else{
+                return VectorSIMD8{_mm256_add_ps(vec, other.vec)};
+            }
+        }
+        LAB_constexpr VectorSIMD8& operator+=(VectorSIMD8 const other) {
+            if consteval{
+                components[0] += other.components[0];
+                components[1] += other.components[1];
+            }
+            else{
+                vec = _mm256_add_ps(vec, other.vec);
+            }
+            return *this;
+        }
+        LAB_constexpr VectorSIMD8 operator-(VectorSIMD8 const other) const {
+            if consteval{
+                return VectorSIMD8{components[0] - other.components[0], components[1] - other.components[1]};
+            }
+            else{
+                return VectorSIMD8{_mm256_sub_ps(vec, other.vec)};
+            }
+        }
+        LAB_constexpr VectorSIMD8& operator-=(VectorSIMD8 const other) {
+            if consteval{
+                components[0] -= other.components[0];
+                components[1] -= other.components[1];
+            }
+            else{
+                vec = _mm256_sub_ps(vec, other.vec);
+            }
+            return *this;
+        }
+
+        LAB_constexpr VectorSIMD8 operator*(VectorSIMD8 const other) const {
+            if consteval{
+                return VectorSIMD8{components[0] * other.components[0], components[1] * other.components[1]};
+            }
+            else{
+                return VectorSIMD8{_mm256_mul_ps(vec, other.vec)};
+            }
+        }
+        LAB_constexpr VectorSIMD8& operator*=(VectorSIMD8 const other) {
+            if consteval{
+                components[0] *= other.components[0];
+                components[1] *= other.components[1];
+            }
+            else{
+                vec = _mm256_mul_ps(vec, other.vec);
+            }
+            return *this;
+        }
+        LAB_constexpr VectorSIMD8 operator*(float const multiplier) const {
+            if consteval{
+                return VectorSIMD8{components[0] * multiplier, components[1] * multiplier};
+            }
+            else{
+                return VectorSIMD8{_mm256_mul_ps(vec, _mm256_set1_ps(multiplier))};
+            }
+        }
+        LAB_constexpr VectorSIMD8& operator*=(float const multiplier) {
+            if consteval{
+                components[0] *= multiplier;
+                components[1] *= multiplier;
+            }
+            else{
+                vec = _mm256_mul_ps(vec, _mm256_set1_ps(multiplier));
+            }
+            return *this;
+        }
+
+        LAB_constexpr VectorSIMD8 operator/(float const divisor) const {
+#if LAB_DEBUGGING_FLOAT_ANOMALIES
+            //handle divider == 0
+#endif
+            if consteval{
+                return VectorSIMD8{components[0] / divisor, components[1] / divisor};
+            }
+            else{
+                return VectorSIMD8{_mm256_div_ps(vec, _mm256_set1_ps(divisor))};
+            }
+        }
+        LAB_constexpr VectorSIMD8& operator/=(float const divisor) {
+#if LAB_DEBUGGING_FLOAT_ANOMALIES
+            //handle divider == 0
+#endif
+            if consteval{
+                components[0] /= divisor;
+                components[1] /= divisor;
+            }
+            else{
+                vec = _mm256_div_ps(vec, _mm256_set1_ps(divisor));
+            }
+            return *this;
+        }
+
+        //per half, x is the low vec4 and y is the high vec4
+        LAB_constexpr Vector<float, 2> Dot(VectorSIMD8 const other) const {
+            return Vector<float, 2>{
+                components[0].x * other.components[0].x + components[0].y * other.components[0].y + components[0].z * other.components[0].z + components[0].w * other.components[0].w,
+                components[1].x * other.components[1].x + components[1].y * other.components[1].y + components[1].z * other.components[1].z + components[1].w * other.components[1].w
+            };
+        }
+        LAB_constexpr Vector<float, 2> SquaredMagnitude() const {
+            return Dot(*this);
+        }
+        LAB_constexpr Vector<float, 2> Magnitude() const {
+            const Vector<float, 2> sqrdMag = SquaredMagnitude();
+            return Vector<float, 2>{Sqrt(sqrdMag.x), Sqrt(sqrdMag.y)};
+        }
+        LAB_constexpr VectorSIMD8& Normalize() {
+            const Vector<float, 2> sqrdMag = SquaredMagnitude();
+            const float invLow = InverseSqrt(sqrdMag.x);
+            const float invHigh = InverseSqrt(sqrdMag.y);
+            operator*=(VectorSIMD8{Vector<float, 4>{invLow}, Vector<float, 4>{invHigh}});
+            return *this;
+        }
+        LAB_constexpr VectorSIMD8 Normalized() const {
+            const Vector<float, 2> sqrdMag = SquaredMagnitude();
+            const float invLow = InverseSqrt(sqrdMag.x);
+            const float invHigh = InverseSqrt(sqrdMag.y);
+            return operator*(VectorSIMD8{Vector<float, 4>{invLow}, Vector<float, 4>{invHigh}});
+        }
+    };
+}
+#endif
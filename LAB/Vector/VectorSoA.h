@@ -0,0 +1,399 @@
+#pragma once
+#include "VectorTemplate.h"
+#include "../Support/SIMD.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+
+namespace lab{
+    //structure of arrays storage for Vector<F, Dimensions>
+    //every component gets its own stream (x, y, z, w), each stream starts on a SIMD aligned boundary and is padded up to the SIMD width
+    //so the bulk kernels below never need a masked load or a scalar tail on stream to stream operations
+    template<std::floating_point F, uint8_t Dimensions>
+    requires((Dimensions > 1) && (Dimensions <= 4))
+    struct VectorSoA {
+        static constexpr std::size_t Alignment = BatchAlignment;
+        //elements per padding step, equal to the float lane count in SIMD builds
+        static constexpr std::size_t Padding = Alignment / sizeof(F);
+
+        F* data = nullptr;
+        std::size_t count = 0;
+        //per stream, always a multiple of Padding
+        std::size_t capacity = 0;
+
+        LAB_constexpr VectorSoA() {}
+        explicit LAB_constexpr VectorSoA(std::size_t const size) {
+            Resize(size);
+        }
+        explicit LAB_constexpr VectorSoA(std::span<const Vector<F, Dimensions>> const vectors) {
+            Resize(vectors.size());
+            for (std::size_t i = 0; i < vectors.size(); i++) {
+                Set(i, vectors[i]);
+            }
+        }
+        LAB_constexpr VectorSoA(VectorSoA const& other) {
+            Reserve(other.count);
+            count = other.count;
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                CopyStream(Stream(dim), other.Stream(dim), count);
+            }
+        }
+        LAB_constexpr VectorSoA(VectorSoA&& other) noexcept : data{other.data}, count{other.count}, capacity{other.capacity} {
+            other.data = nullptr;
+            other.count = 0;
+            other.capacity = 0;
+        }
+        LAB_constexpr VectorSoA& operator=(VectorSoA const& other) {
+            if (this != &other) {
+                Resize(other.count);
+                for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                    CopyStream(Stream(dim), other.Stream(dim), count);
+                }
+            }
+            return *this;
+        }
+        LAB_constexpr VectorSoA& operator=(VectorSoA&& other) noexcept {
+            if (this != &other) {
+                Deallocate(data, capacity * Dimensions);
+                data = other.data;
+                count = other.count;
+                capacity = other.capacity;
+                other.data = nullptr;
+                other.count = 0;
+                other.capacity = 0;
+            }
+            return *this;
+        }
+        LAB_constexpr ~VectorSoA() {
+            Deallocate(data, capacity * Dimensions);
+        }
+
+        LAB_constexpr std::size_t Size() const {
+            return count;
+        }
+        LAB_constexpr std::size_t Capacity() const {
+            return capacity;
+        }
+        //the count rounded up to the padding, the SIMD kernels run over this many elements per stream
+        LAB_constexpr std::size_t PaddedSize() const {
+            return RoundUpToPadding(count);
+        }
+
+        LAB_constexpr F* Stream(uint8_t const dimension) {
+#if LAB_DEBUGGING_ACCESS
+            assert(dimension < Dimensions);
+#endif
+            return data + capacity * dimension;
+        }
+        LAB_constexpr F const* Stream(uint8_t const dimension) const {
+#if LAB_DEBUGGING_ACCESS
+            assert(dimension < Dimensions);
+#endif
+            return data + capacity * dimension;
+        }
+        LAB_constexpr F* X() { return Stream(0); }
+        LAB_constexpr F* Y() { return Stream(1); }
+        LAB_constexpr F* Z() requires(Dimensions >= 3) { return Stream(2); }
+        LAB_constexpr F* W() requires(Dimensions == 4) { return Stream(3); }
+        LAB_constexpr F const* X() const { return Stream(0); }
+        LAB_constexpr F const* Y() const { return Stream(1); }
+        LAB_constexpr F const* Z() const requires(Dimensions >= 3) { return Stream(2); }
+        LAB_constexpr F const* W() const requires(Dimensions == 4) { return Stream(3); }
+
+        LAB_constexpr Vector<F, Dimensions> Get(std::size_t const index) const {
+#if LAB_DEBUGGING_ACCESS
+            assert(index < count);
+#endif
+            Vector<F, Dimensions> ret;
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                ret[dim] = Stream(dim)[index];
+            }
+            return ret;
+        }
+        LAB_constexpr void Set(std::size_t const index, Vector<F, Dimensions> const vec) {
+#if LAB_DEBUGGING_ACCESS
+            assert(index < count);
+#endif
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                Stream(dim)[index] = vec[dim];
+            }
+        }
+        LAB_constexpr void PushBack(Vector<F, Dimensions> const vec) {
+            if (count == capacity) {
+                Reserve(capacity == 0 ? Padding : capacity * 2);
+            }
+            count++;
+            Set(count - 1, vec);
+        }
+
+        LAB_constexpr void Reserve(std::size_t const newCapacity) {
+            const std::size_t padded = RoundUpToPadding(newCapacity);
+            if (padded <= capacity) {
+                return;
+            }
+            F* newData = Allocate(padded * Dimensions);
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                CopyStream(newData + padded * dim, Stream(dim), count);
+            }
+            Deallocate(data, capacity * Dimensions);
+            data = newData;
+            capacity = padded;
+        }
+        //new elements are zeroed
+        LAB_constexpr void Resize(std::size_t const newCount) {
+            Reserve(newCount);
+            for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                F* stream = Stream(dim);
+                for (std::size_t i = count; i < newCount; i++) {
+                    stream[i] = F(0);
+                }
+            }
+            count = newCount;
+        }
+        LAB_constexpr void Clear() {
+            count = 0;
+        }
+
+    private:
+        static LAB_constexpr std::size_t RoundUpToPadding(std::size_t const size) {
+            return (size + Padding - 1) / Padding * Padding;
+        }
+        static LAB_constexpr F* Allocate(std::size_t const elements) {
+            if consteval {
+                F* ptr = std::allocator<F>{}.allocate(elements);
+                for (std::size_t i = 0; i < elements; i++) {
+                    std::construct_at(ptr + i, F(0));
+                }
+                return ptr;
+            }
+            else {
+                F* ptr = static_cast<F*>(::operator new(elements * sizeof(F), std::align_val_t{Alignment}));
+                //zeroing keeps the padding lanes well defined for the SIMD kernels
+                std::memset(ptr, 0, elements * sizeof(F));
+                return ptr;
+            }
+        }
+        static LAB_constexpr void Deallocate(F* ptr, std::size_t const elements) {
+            if (ptr == nullptr) {
+                return;
+            }
+            if consteval {
+                std::allocator<F>{}.deallocate(ptr, elements);
+            }
+            else {
+                ::operator delete(ptr, elements * sizeof(F), std::align_val_t{Alignment});
+            }
+        }
+        static LAB_constexpr void CopyStream(F* dst, F const* src, std::size_t const size) {
+            if consteval {
+                for (std::size_t i = 0; i < size; i++) {
+                    dst[i] = src[i];
+                }
+            }
+            else {
+                if (size > 0) {
+                    std::memcpy(dst, src, size * sizeof(F));
+                }
+            }
+        }
+    };
+
+    //bulk kernels
+    //the SIMD paths perform the same operations in the same order as the scalar Vector functions, so results are bit identical
+    //Normalize and Magnitude only match constexpr evaluation with LAB_DETERMINISTIC, otherwise the runtime may use the hardware sqrt (Support/Sqrt.h)
+    //out is resized to match the input, and is allowed to be the same object as an input
+
+    template<std::floating_point F, uint8_t Dimensions>
+    LAB_constexpr void Add(VectorSoA<F, Dimensions> const& lhs, VectorSoA<F, Dimensions> const& rhs, VectorSoA<F, Dimensions>& out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(lhs.Size() == rhs.Size());
+#endif
+        out.Resize(lhs.Size());
+        for (uint8_t dim = 0; dim < Dimensions; dim++) {
+            F const* lhsStream = lhs.Stream(dim);
+            F const* rhsStream = rhs.Stream(dim);
+            F* outStream = out.Stream(dim);
+#ifdef USING_SIMD
+            if !consteval {
+                if constexpr (std::is_same_v<F, float>) {
+                    for (std::size_t i = 0; i < lhs.PaddedSize(); i += SIMD::FloatWidth) {
+                        SIMD::Store(outStream + i, SIMD::Add(SIMD::Load(lhsStream + i), SIMD::Load(rhsStream + i)));
+                    }
+                    continue;
+                }
+            }
+#endif
+            for (std::size_t i = 0; i < lhs.Size(); i++) {
+                outStream[i] = lhsStream[i] + rhsStream[i];
+            }
+        }
+    }
+
+    template<std::floating_point F, uint8_t Dimensions>
+    LAB_constexpr void Sub(VectorSoA<F, Dimensions> const& lhs, VectorSoA<F, Dimensions> const& rhs, VectorSoA<F, Dimensions>& out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(lhs.Size() == rhs.Size());
+#endif
+        out.Resize(lhs.Size());
+        for (uint8_t dim = 0; dim < Dimensions; dim++) {
+            F const* lhsStream = lhs.Stream(dim);
+            F const* rhsStream = rhs.Stream(dim);
+            F* outStream = out.Stream(dim);
+#ifdef USING_SIMD
+            if !consteval {
+                if constexpr (std::is_same_v<F, float>) {
+                    for (std::size_t i = 0; i < lhs.PaddedSize(); i += SIMD::FloatWidth) {
+                        SIMD::Store(outStream + i, SIMD::Sub(SIMD::Load(lhsStream + i), SIMD::Load(rhsStream + i)));
+                    }
+                    continue;
+                }
+            }
+#endif
+            for (std::size_t i = 0; i < lhs.Size(); i++) {
+                outStream[i] = lhsStream[i] - rhsStream[i];
+            }
+        }
+    }
+
+    template<std::floating_point F, uint8_t Dimensions>
+    LAB_constexpr void Scale(VectorSoA<F, Dimensions> const& vectors, F const multiplier, VectorSoA<F, Dimensions>& out) {
+        out.Resize(vectors.Size());
+        for (uint8_t dim = 0; dim < Dimensions; dim++) {
+            F const* inStream = vectors.Stream(dim);
+            F* outStream = out.Stream(dim);
+#ifdef USING_SIMD
+            if !consteval {
+                if constexpr (std::is_same_v<F, float>) {
+                    const SIMD::Float mult = SIMD::Set1(multiplier);
+                    for (std::size_t i = 0; i < vectors.PaddedSize(); i += SIMD::FloatWidth) {
+                        SIMD::Store(outStream + i, SIMD::Mul(SIMD::Load(inStream + i), mult));
+                    }
+                    continue;
+                }
+            }
+#endif
+            for (std::size_t i = 0; i < vectors.Size(); i++) {
+                outStream[i] = inStream[i] * multiplier;
+            }
+        }
+    }
+
+    //out needs room for lhs.Size() elements
+    template<std::floating_point F, uint8_t Dimensions>
+    LAB_constexpr void Dot(VectorSoA<F, Dimensions> const& lhs, VectorSoA<F, Dimensions> const& rhs, std::span<F> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(lhs.Size() == rhs.Size());
+        assert(out.size() >= lhs.Size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                for (; i + SIMD::FloatWidth <= lhs.Size(); i += SIMD::FloatWidth) {
+                    SIMD::Float acc = SIMD::Mul(SIMD::Load(lhs.Stream(0) + i), SIMD::Load(rhs.Stream(0) + i));
+                    for (uint8_t dim = 1; dim < Dimensions; dim++) {
+                        acc = SIMD::Add(acc, SIMD::Mul(SIMD::Load(lhs.Stream(dim) + i), SIMD::Load(rhs.Stream(dim) + i)));
+                    }
+                    SIMD::StoreU(out.data() + i, acc);
+                }
+            }
+        }
+#endif
+        for (; i < lhs.Size(); i++) {
+            F acc = lhs.Stream(0)[i] * rhs.Stream(0)[i];
+            for (uint8_t dim = 1; dim < Dimensions; dim++) {
+                acc += lhs.Stream(dim)[i] * rhs.Stream(dim)[i];
+            }
+            out[i] = acc;
+        }
+    }
+
+    template<std::floating_point F>
+    LAB_constexpr void Cross(VectorSoA<F, 3> const& lhs, VectorSoA<F, 3> const& rhs, VectorSoA<F, 3>& out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(lhs.Size() == rhs.Size());
+#endif
+        //out can alias an input, so the cross product is computed per element before anything is written
+        out.Resize(lhs.Size());
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                for (std::size_t i = 0; i < lhs.PaddedSize(); i += SIMD::FloatWidth) {
+                    const SIMD::Float lx = SIMD::Load(lhs.X() + i);
+                    const SIMD::Float ly = SIMD::Load(lhs.Y() + i);
+                    const SIMD::Float lz = SIMD::Load(lhs.Z() + i);
+                    const SIMD::Float rx = SIMD::Load(rhs.X() + i);
+                    const SIMD::Float ry = SIMD::Load(rhs.Y() + i);
+                    const SIMD::Float rz = SIMD::Load(rhs.Z() + i);
+                    SIMD::Store(out.X() + i, SIMD::Sub(SIMD::Mul(ly, rz), SIMD::Mul(lz, ry)));
+                    SIMD::Store(out.Y() + i, SIMD::Sub(SIMD::Mul(lz, rx), SIMD::Mul(lx, rz)));
+                    SIMD::Store(out.Z() + i, SIMD::Sub(SIMD::Mul(lx, ry), SIMD::Mul(ly, rx)));
+                }
+                return;
+            }
+        }
+#endif
+        for (std::size_t i = 0; i < lhs.Size(); i++) {
+            out.Set(i, lhs.Get(i).Cross(rhs.Get(i)));
+        }
+    }
+
+    template<std::floating_point F, uint8_t Dimensions>
+    LAB_constexpr void Normalize(VectorSoA<F, Dimensions> const& vectors, VectorSoA<F, Dimensions>& out) {
+        out.Resize(vectors.Size());
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                for (std::size_t i = 0; i < vectors.PaddedSize(); i += SIMD::FloatWidth) {
+                    SIMD::Float components[Dimensions];
+                    SIMD::Float sqrdMag = SIMD::Set1(0.f);
+                    for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                        components[dim] = SIMD::Load(vectors.Stream(dim) + i);
+                        const SIMD::Float sqrd = SIMD::Mul(components[dim], components[dim]);
+                        sqrdMag = (dim == 0) ? sqrd : SIMD::Add(sqrdMag, sqrd);
+                    }
+                    const SIMD::Float invMag = SIMD::InverseSqrt(sqrdMag);
+                    for (uint8_t dim = 0; dim < Dimensions; dim++) {
+                        SIMD::Store(out.Stream(dim) + i, SIMD::Mul(components[dim], invMag));
+                    }
+                }
+                return;
+            }
+        }
+#endif
+        for (std::size_t i = 0; i < vectors.Size(); i++) {
+            out.Set(i, vectors.Get(i).Normalized());
+        }
+    }
+
+    //out needs room for vectors.Size() elements
+    template<std::floating_point F, uint8_t Dimensions>
+    LAB_constexpr void Magnitude(VectorSoA<F, Dimensions> const& vectors, std::span<F> const out) {
+#if LAB_DEBUGGING_ACCESS
+        assert(out.size() >= vectors.Size());
+#endif
+        std::size_t i = 0;
+#ifdef USING_SIMD
+        if !consteval {
+            if constexpr (std::is_same_v<F, float>) {
+                for (; i + SIMD::FloatWidth <= vectors.Size(); i += SIMD::FloatWidth) {
+                    SIMD::Float component = SIMD::Load(vectors.Stream(0) + i);
+                    SIMD::Float sqrdMag = SIMD::Mul(component, component);
+                    for (uint8_t dim = 1; dim < Dimensions; dim++) {
+                        component = SIMD::Load(vectors.Stream(dim) + i);
+                        sqrdMag = SIMD::Add(sqrdMag, SIMD::Mul(component, component));
+                    }
+                    SIMD::StoreU(out.data() + i, SIMD::Sqrt(sqrdMag));
+                }
+            }
+        }
+#endif
+        for (; i < vectors.Size(); i++) {
+            out[i] = vectors.Get(i).Magnitude();
+        }
+    }
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//accuracy sweep harness. every result is compared against the <cmath> function evaluated in long double
+//error is reported in ulps of the reference rounded to F, plus absolute error
+
+namespace lab {
+    namespace Accuracy {
+        struct Stats {
+            std::string function;
+            std::string type;
+            std::string precision;
+            std::string range;
+            //"exhaustive" is every representable value in the range, "uniform" is evenly spaced samples, "grid" is a 2d uniform grid
+            std::string mode;
+            std::size_t samples = 0;
+            long double maxUlp = 0;
+            long double sumUlp = 0;
+            long double maxAbs = 0;
+            long double sumAbs = 0;
+            //inputs for the worst ulp error, the second one is only used by 2 argument functions
+            long double worstInput = 0;
+            long double worstInput2 = 0;
+            //the result was inf/nan where the reference was finite
+            std::size_t nonFinite = 0;
+
+            long double MeanUlp() const { return samples == 0 ? 0 : sumUlp / static_cast<long double>(samples); }
+            long double MeanAbs() const { return samples == 0 ? 0 : sumAbs / static_cast<long double>(samples); }
+        };
+
+        //spacing between F values at the magnitude of reference, subnormals share the smallest spacing
+        template<std::floating_point F>
+        long double UlpSize(long double const reference) {
+            constexpr int mantissaBits = std::numeric_limits<F>::digits - 1;
+            constexpr int minExponent = std::numeric_limits<F>::min_exponent - 1;
+            int exponent = minExponent;
+            if (reference != 0) {
+                exponent = std::max(std::ilogb(reference), minExponent);
+            }
+            return std::ldexp(1.0L, exponent - mantissaBits);
+        }
+
+        template<std::floating_point F>
+        void Accumulate(Stats& stats, F const result, long double const reference, long double const input, long double const input2 = 0) {
+            if (!std::isfinite(reference)) {
+                return;
+            }
+            stats.samples++;
+            if (!std::isfinite(result)) {
+                stats.nonFinite++;
+                return;
+            }
+            const long double absError = std::fabs(static_cast<long double>(result) - reference);
+            const long double ulpError = absError / UlpSize<F>(reference);
+            stats.sumAbs += absError;
+            stats.sumUlp += ulpError;
+            if (absError > stats.maxAbs) {
+                stats.maxAbs = absError;
+            }
+            if (ulpError > stats.maxUlp) {
+                stats.maxUlp = ulpError;
+                stats.worstInput = input;
+                stats.worstInput2 = input2;
+            }
+        }
+
+        template<std::floating_point F>
+        Stats MakeStats(char const* function, char const* precision, char const* mode, F const lower, F const upper) {
+            Stats ret{};
+            ret.function = function;
+            ret.type = std::is_same_v<F, float> ? "float" : "double";
+            ret.precision = precision;
+            ret.mode = mode;
+            char range[64];
+            snprintf(range, sizeof(range), "[%.6g, %.6g]", static_cast<double>(lower), static_cast<double>(upper));
+            ret.range = range;
+            return ret;
+        }
+
+        //every representable F in [lower, upper]
+        template<std::floating_point F, typename Func, typename Reference>
+        Stats Exhaustive(char const* function, char const* precision, F const lower, F const upper, Func&& func, Reference&& reference) {
+            Stats ret = MakeStats<F>(function, precision, "exhaustive", lower, upper);
+            for (F input = lower; input <= upper; input = std::nextafter(input, std::numeric_limits<F>::infinity())) {
+                Accumulate(ret, func(input), reference(static_cast<long double>(input)), input);
+            }
+            return ret;
+        }
+
+        //count evenly spaced samples over [lower, upper], both ends included
+        template<std::floating_point F, typename Func, typename Reference>
+        Stats Uniform(char const* function, char const* precision, F const lower, F const upper, std::size_t const count, Func&& func, Reference&& reference) {
+            Stats ret = MakeStats<F>(function, precision, "uniform", lower, upper);
+            const long double step = (static_cast<long double>(upper) - static_cast<long double>(lower)) / static_cast<long double>(count - 1);
+            for (std::size_t i = 0; i < count; i++) {
+                const F input = static_cast<F>(static_cast<long double>(lower) + step * static_cast<long double>(i));
+                Accumulate(ret, func(input), reference(static_cast<long double>(input)), input);
+            }
+            return ret;
+        }
+
+        //countPerAxis * countPerAxis samples over [lower, upper] on both arguments
+        template<std::floating_point F, typename Func, typename Reference>
+        Stats Grid(char const* function, char const* precision, F const lower, F const upper, std::size_t const countPerAxis, Func&& func, Reference&& reference) {
+            Stats ret = MakeStats<F>(function, precision, "grid", lower, upper);
+            const long double step = (static_cast<long double>(upper) - static_cast<long double>(lower)) / static_cast<long double>(countPerAxis - 1);
+            for (std::size_t i = 0; i < countPerAxis; i++) {
+                const F first = static_cast<F>(static_cast<long double>(lower) + step * static_cast<long double>(i));
+                for (std::size_t j = 0; j < countPerAxis; j++) {
+                    const F second = static_cast<F>(static_cast<long double>(lower) + step * static_cast<long double>(j));
+                    Accumulate(ret, func(first, second), reference(static_cast<long double>(first), static_cast<long double>(second)), first, second);
+                }
+            }
+            return ret;
+        }
+
+        //angle between two rotations in radians, for the quaternion interpolation sweeps
+        struct AngularStats {
+            std::string function;
+            std::string reference;
+            std::size_t samples = 0;
+            long double maxAngle = 0;
+            long double sumAngle = 0;
+            //the angle between the two inputs where the max happened
+            long double worstSpan = 0;
+
+            long double MeanAngle() const { return samples == 0 ? 0 : sumAngle / static_cast<long double>(samples); }
+        };
+
+        //q and -q are the same rotation, so the angle uses |dot|
+        inline long double RotationAngle(std::array<long double, 4> const& lhs, std::array<long double, 4> const& rhs) {
+            long double dot = 0;
+            long double lhsSqrd = 0;
+            long double rhsSqrd = 0;
+            for (uint8_t i = 0; i < 4; i++) {
+                dot += lhs[i] * rhs[i];
+                lhsSqrd += lhs[i] * lhs[i];
+                rhsSqrd += rhs[i] * rhs[i];
+            }
+            const long double cosHalf = std::min(std::fabs(dot) / std::sqrt(lhsSqrd * rhsSqrd), 1.0L);
+            return 2.0L * std::acos(cosHalf);
+        }
+
+        inline void AccumulateAngle(AngularStats& stats, long double const angle, long double const inputSpan) {
+            stats.samples++;
+            stats.sumAngle += angle;
+            if (angle > stats.maxAngle) {
+                stats.maxAngle = angle;
+                stats.worstSpan = inputSpan;
+            }
+        }
+
+        inline void WriteAngularMarkdown(FILE* file, std::vector<AngularStats> const& table) {
+            fprintf(file, "| function | reference | samples | max angle (rad) | mean angle (rad) | input span at max (rad) |\n");
+            fprintf(file, "|---|---|---:|---:|---:|---:|\n");
+            for (auto const& row : table) {
+                fprintf(file, "| %s | %s | %zu | %.3Le | %.3Le | %.4Lf |\n",
+                    row.function.c_str(), row.reference.c_str(), row.samples, row.maxAngle, row.MeanAngle(), row.worstSpan
+                );
+            }
+        }
+
+        inline void WriteCSV(FILE* file, std::vector<Stats> const& table) {
+            fprintf(file, "function,type,precision,range,mode,samples,max_ulp,mean_ulp,max_abs,mean_abs,worst_input,worst_input2,non_finite\n");
+            for (auto const& row : table) {
+                fprintf(file, "%s,%s,%s,\"%s\",%s,%zu,%.3Lf,%.5Lf,%.6Le,%.6Le,%.9Lg,%.9Lg,%zu\n",
+                    row.function.c_str(), row.type.c_str(), row.precision.c_str(), row.range.c_str(), row.mode.c_str(), row.samples,
+                    row.maxUlp, row.MeanUlp(), row.maxAbs, row.MeanAbs(), row.worstInput, row.worstInput2, row.nonFinite
+                );
+            }
+        }
+
+        inline void WriteMarkdown(FILE* file, std::vector<Stats> const& table) {
+            fprintf(file, "| function | type | precision | range | mode | samples | max ulp | mean ulp | max abs | mean abs | worst input | non finite |\n");
+            fprintf(file, "|---|---|---|---|---|---:|---:|---:|---:|---:|---:|---:|\n");
+            for (auto const& row : table) {
+                char worst[64];
+                if (row.mode == "grid") {
+                    snprintf(worst, sizeof(worst), "%.7Lg, %.7Lg", row.worstInput, row.worstInput2);
+                }
+                else {
+                    snprintf(worst, sizeof(worst), "%.9Lg", row.worstInput);
+                }
+                fprintf(file, "| %s | %s | %s | %s | %s | %zu | %.2Lf | %.4Lf | %.3Le | %.3Le | %s | %zu |\n",
+                    row.function.c_str(), row.type.c_str(), row.precision.c_str(), row.range.c_str(), row.mode.c_str(), row.samples,
+                    row.maxUlp, row.MeanUlp(), row.maxAbs, row.MeanAbs(), worst, row.nonFinite
+                );
+            }
+        }
+    }
+}
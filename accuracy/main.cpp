@@ -0,0 +1,272 @@
+#include "Accuracy.h"
+
+#include "Support/Trig.h"
+#include "Support/Sqrt.h"
+#include "Support/Simple.h"
+#include "Quaternion.h"
+#include "Quaternion/QuaternionCompression.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#if LAB_USING_AVX2
+    char const* SIMD_TYPE = "avx2";
+#elif LAB_USING_SSE
+    char const* SIMD_TYPE = "sse";
+#else
+    char const* SIMD_TYPE = "scalar";
+#endif
+
+namespace {
+    using lab::Accuracy::Stats;
+    using lab::Precision;
+
+    constexpr long double piLong = 3.141592653589793238462643383279502884L;
+
+    //float gets exhaustive sweeps over one or two binades and dense uniform sweeps over the wider ranges
+    //one binade of float is 2^23 values, so the exhaustive rows are every mantissa at that exponent
+    constexpr std::size_t floatSamples = std::size_t(1) << 22;
+    constexpr std::size_t floatGrid = 2048;
+    //double only gets uniform sweeps
+    constexpr std::size_t doubleSamples = std::size_t(1) << 20;
+    constexpr std::size_t doubleGrid = 1024;
+
+    auto referenceSin = [](long double x) { return std::sin(x); };
+    auto referenceCos = [](long double x) { return std::cos(x); };
+    auto referenceTan = [](long double x) { return std::tan(x); };
+    auto referenceArcSin = [](long double x) { return std::asin(x); };
+    auto referenceArcCos = [](long double x) { return std::acos(x); };
+    auto referenceArcTan = [](long double x) { return std::atan(x); };
+    auto referenceArcTan2 = [](long double y, long double x) { return std::atan2(y, x); };
+    auto referenceSqrt = [](long double x) { return std::sqrt(x); };
+    auto referenceInverseSqrt = [](long double x) { return 1.0L / std::sqrt(x); };
+
+    template<Precision P, std::floating_point F>
+    void SweepTier(std::vector<Stats>& table, char const* tier) {
+        constexpr bool isFloat = std::is_same_v<F, float>;
+        constexpr std::size_t samples = isFloat ? floatSamples : doubleSamples;
+        constexpr std::size_t grid = isFloat ? floatGrid : doubleGrid;
+        const F twoPI = static_cast<F>(2.0L * piLong);
+        //Tan is swept short of the poles, the ulp error next to a pole says nothing useful
+        const F tanLimit = F(1.5);
+
+        auto sin = [](F x) { return lab::Sin<P>(x); };
+        auto cos = [](F x) { return lab::Cos<P>(x); };
+        auto sinCosSin = [](F x) { return lab::SinCos<P>(x).sin; };
+        auto sinCosCos = [](F x) { return lab::SinCos<P>(x).cos; };
+        auto tan = [](F x) { return lab::Tan<P>(x); };
+        auto arcSin = [](F x) { return lab::ArcSin<P>(x); };
+        auto arcCos = [](F x) { return lab::ArcCos<P>(x); };
+        auto arcTan = [](F x) { return lab::ArcTan<P>(x); };
+        auto arcTan2 = [](F y, F x) { return lab::ArcTan2<P>(y, x); };
+        auto sqrt = [](F x) { return lab::Sqrt<P>(x); };
+        auto inverseSqrt = [](F x) { return lab::InverseSqrt<P>(x); };
+        auto softwareSqrt = [](F x) { return lab::SoftwareSqrt<P>(x); };
+        auto softwareInverseSqrt = [](F x) { return lab::SoftwareInverseSqrt<P>(x); };
+
+        using namespace lab::Accuracy;
+        if constexpr (isFloat) {
+            table.push_back(Exhaustive("Sin", tier, F(1), F(2), sin, referenceSin));
+            table.push_back(Exhaustive("Cos", tier, F(1), F(2), cos, referenceCos));
+            table.push_back(Exhaustive("Tan", tier, F(0.5), F(1), tan, referenceTan));
+            table.push_back(Exhaustive("ArcSin", tier, F(0.5), F(1), arcSin, referenceArcSin));
+            table.push_back(Exhaustive("ArcCos", tier, F(0.5), F(1), arcCos, referenceArcCos));
+            table.push_back(Exhaustive("ArcTan", tier, F(1), F(2), arcTan, referenceArcTan));
+            //two binades cover every mantissa with both exponent parities, which is every case the bit hack has
+            table.push_back(Exhaustive("Sqrt", tier, F(1), F(4), sqrt, referenceSqrt));
+            table.push_back(Exhaustive("InverseSqrt", tier, F(1), F(4), inverseSqrt, referenceInverseSqrt));
+            table.push_back(Exhaustive("SoftwareSqrt", tier, F(1), F(4), softwareSqrt, referenceSqrt));
+            table.push_back(Exhaustive("SoftwareInverseSqrt", tier, F(1), F(4), softwareInverseSqrt, referenceInverseSqrt));
+        }
+        table.push_back(Uniform("Sin", tier, -twoPI, twoPI, samples, sin, referenceSin));
+        table.push_back(Uniform("Sin", tier, F(-1000), F(1000), samples, sin, referenceSin));
+        table.push_back(Uniform("Cos", tier, -twoPI, twoPI, samples, cos, referenceCos));
+        table.push_back(Uniform("Cos", tier, F(-1000), F(1000), samples, cos, referenceCos));
+        table.push_back(Uniform("SinCos.sin", tier, -twoPI, twoPI, samples, sinCosSin, referenceSin));
+        table.push_back(Uniform("SinCos.cos", tier, -twoPI, twoPI, samples, sinCosCos, referenceCos));
+        table.push_back(Uniform("Tan", tier, -tanLimit, tanLimit, samples, tan, referenceTan));
+        table.push_back(Uniform("ArcSin", tier, F(-1), F(1), samples, arcSin, referenceArcSin));
+        table.push_back(Uniform("ArcCos", tier, F(-1), F(1), samples, arcCos, referenceArcCos));
+        table.push_back(Uniform("ArcTan", tier, F(-100), F(100), samples, arcTan, referenceArcTan));
+        table.push_back(Grid("ArcTan2", tier, F(-10), F(10), grid, arcTan2, referenceArcTan2));
+        table.push_back(Uniform("Sqrt", tier, F(0.001), F(1000000), samples, sqrt, referenceSqrt));
+        table.push_back(Uniform("InverseSqrt", tier, F(0.001), F(1000000), samples, inverseSqrt, referenceInverseSqrt));
+    }
+
+    //Simple.h has no precision tiers
+    template<std::floating_point F>
+    void SweepSimple(std::vector<Stats>& table) {
+        constexpr std::size_t samples = std::is_same_v<F, float> ? floatSamples : doubleSamples;
+        auto degreesToRadians = [](F x) { return lab::DegreesToRadians(x); };
+        auto radiansToDegrees = [](F x) { return lab::RadiansToDegrees(x); };
+        auto referenceDegreesToRadians = [](long double x) { return x * (piLong / 180.0L); };
+        auto referenceRadiansToDegrees = [](long double x) { return x * (180.0L / piLong); };
+
+        using namespace lab::Accuracy;
+        if constexpr (std::is_same_v<F, float>) {
+            table.push_back(Exhaustive("DegreesToRadians", "-", F(1), F(2), degreesToRadians, referenceDegreesToRadians));
+            table.push_back(Exhaustive("RadiansToDegrees", "-", F(1), F(2), radiansToDegrees, referenceRadiansToDegrees));
+        }
+        table.push_back(Uniform("DegreesToRadians", "-", F(-720), F(720), samples, degreesToRadians, referenceDegreesToRadians));
+        table.push_back(Uniform("RadiansToDegrees", "-", F(-13), F(13), samples, radiansToDegrees, referenceRadiansToDegrees));
+    }
+
+    using Quat4 = std::array<long double, 4>;
+    Quat4 Widen(lab::Quat const quat) {
+        return Quat4{ quat.x, quat.y, quat.z, quat.w };
+    }
+    //the textbook slerp in long double, shortest path
+    Quat4 ReferenceSlerp(lab::Quat const lhs, lab::Quat const rhs, long double const weight) {
+        const Quat4 q1 = Widen(lhs);
+        Quat4 q2 = Widen(rhs);
+        long double dot = q1[0] * q2[0] + q1[1] * q2[1] + q1[2] * q2[2] + q1[3] * q2[3];
+        if (dot < 0) {
+            for (auto& component : q2) {
+                component = -component;
+            }
+            dot = -dot;
+        }
+        const long double theta = std::acos(std::min(dot, 1.0L));
+        Quat4 ret{};
+        for (uint8_t i = 0; i < 4; i++) {
+            if (theta < 1e-9L) {
+                ret[i] = q1[i] * (1.0L - weight) + q2[i] * weight;
+            }
+            else {
+                ret[i] = (std::sin((1.0L - weight) * theta) * q1[i] + std::sin(weight * theta) * q2[i]) / std::sin(theta);
+            }
+        }
+        return ret;
+    }
+
+    //random unit quaternion pairs, a quarter of them pushed close to the same or the opposite rotation, at 65 weights each
+    //the float results are compared against Mix and against ReferenceSlerp
+    void SweepInterpolation(std::vector<lab::Accuracy::AngularStats>& table) {
+        constexpr std::size_t pairCount = 50000;
+        constexpr std::size_t weightSteps = 64;
+        std::mt19937 engine{ 7 };
+        std::normal_distribution<float> distribution{ 0.f, 1.f };
+
+        using lab::Accuracy::AngularStats;
+        AngularStats mixExact{ "Mix", "exact slerp" };
+        AngularStats nlerpMix{ "Nlerp", "Mix" };
+        AngularStats nlerpExact{ "Nlerp", "exact slerp" };
+        AngularStats fastMix{ "FastSlerp", "Mix" };
+        AngularStats fastExact{ "FastSlerp", "exact slerp" };
+        for (std::size_t pair = 0; pair < pairCount; pair++) {
+            const lab::Quat lhs = lab::Quat{ distribution(engine), distribution(engine), distribution(engine), distribution(engine) }.Normalized();
+            lab::Quat rhs = lab::Quat{ distribution(engine), distribution(engine), distribution(engine), distribution(engine) }.Normalized();
+            if (pair % 4 == 0) {
+                const float nudge = std::ldexp(1.f, -static_cast<int>(pair % 20));
+                rhs = (lhs * ((pair % 8 == 0) ? -1.f : 1.f) + rhs * nudge).Normalized();
+            }
+            const long double inputSpan = lab::Accuracy::RotationAngle(Widen(lhs), Widen(rhs));
+            for (std::size_t step = 0; step <= weightSteps; step++) {
+                const float weight = static_cast<float>(step) / static_cast<float>(weightSteps);
+                const Quat4 exact = ReferenceSlerp(lhs, rhs, weight);
+                const Quat4 mix = Widen(lab::Quat::Mix(lhs, rhs, weight));
+                const Quat4 nlerp = Widen(lab::Quat::Nlerp(lhs, rhs, weight));
+                const Quat4 fast = Widen(lab::Quat::FastSlerp(lhs, rhs, weight));
+                lab::Accuracy::AccumulateAngle(mixExact, lab::Accuracy::RotationAngle(mix, exact), inputSpan);
+                lab::Accuracy::AccumulateAngle(nlerpMix, lab::Accuracy::RotationAngle(nlerp, mix), inputSpan);
+                lab::Accuracy::AccumulateAngle(nlerpExact, lab::Accuracy::RotationAngle(nlerp, exact), inputSpan);
+                lab::Accuracy::AccumulateAngle(fastMix, lab::Accuracy::RotationAngle(fast, mix), inputSpan);
+                lab::Accuracy::AccumulateAngle(fastExact, lab::Accuracy::RotationAngle(fast, exact), inputSpan);
+            }
+        }
+        table.push_back(mixExact);
+        table.push_back(nlerpMix);
+        table.push_back(nlerpExact);
+        table.push_back(fastMix);
+        table.push_back(fastExact);
+    }
+
+    //random rotations through CompressSmallestThree and back, compared against the normalized input
+    //every 8th one has its components pushed towards +-0.5, where the rebuilt component is least precise
+    //the input span column is the input's own rotation angle
+    void SweepCompression(std::vector<lab::Accuracy::AngularStats>& table) {
+        constexpr std::size_t quatCount = 1000000;
+        std::mt19937 engine{ 7 };
+        std::normal_distribution<float> distribution{ 0.f, 1.f };
+
+        using lab::Accuracy::AngularStats;
+        AngularStats compressed32{ "SmallestThree<10>", "input" };
+        AngularStats compressed64{ "SmallestThree<15>", "input" };
+        const Quat4 identity{ 0, 0, 0, 1 };
+        for (std::size_t i = 0; i < quatCount; i++) {
+            lab::Quat quat{ distribution(engine), distribution(engine), distribution(engine), distribution(engine) };
+            if (i % 8 == 0) {
+                const float nudge = std::ldexp(1.f, -static_cast<int>(i % 24));
+                quat = lab::Quat{ std::copysign(1.f, quat.x), std::copysign(1.f, quat.y), std::copysign(1.f, quat.z), std::copysign(1.f, quat.w) } + quat * nudge;
+            }
+            const Quat4 input = Widen(quat);
+            const long double inputSpan = lab::Accuracy::RotationAngle(input, identity);
+            const Quat4 roundTrip32 = Widen(lab::DecompressSmallestThree<10>(lab::CompressSmallestThree<10>(quat)));
+            const Quat4 roundTrip64 = Widen(lab::DecompressSmallestThree<15>(lab::CompressSmallestThree<15>(quat)));
+            lab::Accuracy::AccumulateAngle(compressed32, lab::Accuracy::RotationAngle(roundTrip32, input), inputSpan);
+            lab::Accuracy::AccumulateAngle(compressed64, lab::Accuracy::RotationAngle(roundTrip64, input), inputSpan);
+        }
+        table.push_back(compressed32);
+        table.push_back(compressed64);
+    }
+
+    template<std::floating_point F>
+    void SweepType(std::vector<Stats>& table) {
+        SweepTier<Precision::Fast, F>(table, "Fast");
+        SweepTier<Precision::Balanced, F>(table, "Balanced");
+        SweepTier<Precision::Precise, F>(table, "Precise");
+        SweepSimple<F>(table);
+    }
+}
+
+int main(int argc, char** argv) {
+    //output is <base>.csv and <base>.md, the markdown table is also printed
+    const std::string base = (argc > 1) ? argv[1] : "accuracy";
+#ifdef LAB_USING_HARDWARE_SQRT
+    char const* sqrtType = "hardware sqrt";
+#else
+    char const* sqrtType = "software sqrt";
+#endif
+
+    std::vector<Stats> table;
+    SweepType<float>(table);
+    //msvc long double is double, so the reference would be no better than the result
+    if constexpr (std::numeric_limits<long double>::digits > std::numeric_limits<double>::digits) {
+        SweepType<double>(table);
+    }
+    else {
+        printf("long double has no more precision than double, skipping the double sweeps\n");
+    }
+
+    std::vector<lab::Accuracy::AngularStats> angularTable;
+    SweepInterpolation(angularTable);
+    std::vector<lab::Accuracy::AngularStats> compressionTable;
+    SweepCompression(compressionTable);
+
+    FILE* csv = fopen((base + ".csv").c_str(), "w");
+    FILE* markdown = fopen((base + ".md").c_str(), "w");
+    if (csv == nullptr || markdown == nullptr) {
+        printf("failed to open %s.csv or %s.md for writing\n", base.c_str(), base.c_str());
+        return 1;
+    }
+    lab::Accuracy::WriteCSV(csv, table);
+    fprintf(markdown, "LAB accuracy - %s, %s, reference is <cmath> in long double\n\n", SIMD_TYPE, sqrtType);
+    lab::Accuracy::WriteMarkdown(markdown, table);
+    fprintf(markdown, "\nquaternion interpolation, angle between the rotations\n\n");
+    lab::Accuracy::WriteAngularMarkdown(markdown, angularTable);
+    fprintf(markdown, "\nquaternion compression round trip, angle between the rotations\n\n");
+    lab::Accuracy::WriteAngularMarkdown(markdown, compressionTable);
+    fclose(csv);
+    fclose(markdown);
+
+    printf("LAB accuracy - %s, %s, reference is <cmath> in long double\n\n", SIMD_TYPE, sqrtType);
+    lab::Accuracy::WriteMarkdown(stdout, table);
+    printf("\nquaternion interpolation, angle between the rotations\n\n");
+    lab::Accuracy::WriteAngularMarkdown(stdout, angularTable);
+    printf("\nquaternion compression round trip, angle between the rotations\n\n");
+    lab::Accuracy::WriteAngularMarkdown(stdout, compressionTable);
+    return 0;
+}
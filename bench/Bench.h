@@ -0,0 +1,120 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+//minimal self contained benchmark harness, no external dependencies
+
+namespace lab {
+    namespace Bench {
+
+        //keeps the optimizer from discarding a result
+        template<typename T>
+        inline void DoNotOptimize(T const& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+            static volatile char sink;
+            sink = *reinterpret_cast<char const volatile*>(&value);
+            _ReadWriteBarrier();
+#else
+            asm volatile("" : : "r,m"(value) : "memory");
+#endif
+        }
+        //makes the optimizer assume the value was modified
+        template<typename T>
+        inline void ClobberValue(T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+            static volatile char sink;
+            sink = *reinterpret_cast<char volatile*>(&value);
+            _ReadWriteBarrier();
+#else
+            asm volatile("" : "+r,m"(value) : : "memory");
+#endif
+        }
+
+        struct Result {
+            char const* name;
+            double nsPerOp;
+            double opsPerSecond;
+        };
+
+        //calls func in growing batches until a batch takes at least the target time, then keeps the fastest of a few samples
+        //opsPerCall is how many operations a single call of func performs, so batched kernels report per element
+        template<typename Func>
+        Result Run(char const* name, std::size_t const opsPerCall, Func&& func) {
+            using Clock = std::chrono::steady_clock;
+            constexpr auto targetTime = std::chrono::milliseconds(50);
+            constexpr uint8_t sampleCount = 5;
+
+            std::size_t calls = 1;
+            while (true) {
+                const auto start = Clock::now();
+                for (std::size_t i = 0; i < calls; i++) {
+                    func();
+                }
+                if ((Clock::now() - start) >= targetTime) {
+                    break;
+                }
+                calls *= 2;
+            }
+
+            double best = 0.0;
+            for (uint8_t sample = 0; sample < sampleCount; sample++) {
+                const auto start = Clock::now();
+                for (std::size_t i = 0; i < calls; i++) {
+                    func();
+                }
+                const double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+                if (sample == 0 || elapsed < best) {
+                    best = elapsed;
+                }
+            }
+            const double nsPerOp = best / static_cast<double>(calls * opsPerCall);
+            return Result{ name, nsPerOp, 1e9 / nsPerOp };
+        }
+
+        inline void PrintHeader(char const* section) {
+            printf("\n%s\n", section);
+            printf("%-48s %14s %16s\n", "benchmark", "ns/op", "ops/s");
+        }
+        inline void Print(Result const& result) {
+            printf("%-48s %14.3f %16.0f\n", result.name, result.nsPerOp, result.opsPerSecond);
+        }
+        inline void PrintSpeedup(Result const& baseline, Result const& candidate) {
+            printf("%-48s %13.2fx\n", "  speedup", baseline.nsPerOp / candidate.nsPerOp);
+        }
+        template<typename Func>
+        Result RunAndPrint(char const* name, std::size_t const opsPerCall, Func&& func) {
+            const Result result = Run(name, opsPerCall, func);
+            Print(result);
+            return result;
+        }
+
+        //fixed seed, so every build flavor times the same inputs
+        inline std::vector<float> RandomFloats(std::size_t const count, float const min, float const max, uint32_t const seed = 1) {
+            std::mt19937 engine{ seed };
+            std::uniform_real_distribution<float> distribution{ min, max };
+            std::vector<float> ret(count);
+            for (auto& val : ret) {
+                val = distribution(engine);
+            }
+            return ret;
+        }
+
+        //element count for the per element loops, small enough to stay in L1 with a few arrays alive
+        inline constexpr std::size_t elementCount = 1024;
+
+        void BenchVector();
+        void BenchMatrix();
+        void BenchQuaternion();
+        void BenchMath();
+        void BenchCamera();
+        void BenchBounding();
+        void BenchGeometry();
+        void BenchSkinning();
+        void BenchTransform();
+    }
+}
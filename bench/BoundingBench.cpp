@@ -0,0 +1,85 @@
+#include "Bench.h"
+
+#include "Bounding.h"
+#include "Quaternion.h"
+
+#include <vector>
+
+namespace lab {
+    namespace Bench {
+        void BenchBounding() {
+            constexpr std::size_t boxCount = 4096;
+            const std::vector<float> centers = RandomFloats(boxCount * 3, -100.f, 100.f, 60);
+            const std::vector<float> sizes = RandomFloats(boxCount * 3, 0.5f, 5.f, 61);
+            VectorSoA<float, 3> mins;
+            VectorSoA<float, 3> maxs;
+            VectorSoA<float, 4> spheres;
+            std::vector<AABB<float>> boxes(boxCount);
+            for (std::size_t i = 0; i < boxCount; i++) {
+                const vec3 center{ centers[i * 3], centers[i * 3 + 1], centers[i * 3 + 2] };
+                const vec3 extents{ sizes[i * 3], sizes[i * 3 + 1], sizes[i * 3 + 2] };
+                boxes[i] = AABB<float>::FromCenterExtents(center, extents);
+                mins.PushBack(boxes[i].min);
+                maxs.PushBack(boxes[i].max);
+                spheres.PushBack(vec4{ center.x, center.y, center.z, extents.x });
+            }
+            mat4 matrix = Quat::AngleAxis(0.7f, vec3{ 0.3f, 1.f, -0.2f }.Normalized()).ToMat4();
+            matrix.columns[0] = matrix.columns[0] * 2.f;
+            matrix.columns[3] = mat4::ColType(1.f, -2.f, 3.f, 1.f);
+
+            std::vector<AABB<float>> outBoxes(boxCount);
+            VectorSoA<float, 3> outMins;
+            VectorSoA<float, 3> outMaxs;
+            VectorSoA<float, 4> outSpheres;
+            std::vector<uint64_t> hits(BitmaskWordCount(boxCount));
+
+            PrintHeader("Bounding volumes (per box, 4096 boxes)");
+            const Result corners = RunAndPrint("AABB transform, 8 corners", boxCount, [&] {
+                for (std::size_t i = 0; i < boxCount; i++) {
+                    const OBB<float> box = OBB<float>::FromAABB(boxes[i]);
+                    AABB<float> ret = AABB<float>::Empty();
+                    for (uint8_t corner = 0; corner < 8; corner++) {
+                        const vec4 transformed = matrix * vec4{ box.GetCorner(corner), 1.f };
+                        ret = ret.Merge(vec3{ transformed.x, transformed.y, transformed.z });
+                    }
+                    outBoxes[i] = ret;
+                }
+                DoNotOptimize(outBoxes.data());
+            });
+            const Result arvo = RunAndPrint("AABB::Transformed (Arvo)", boxCount, [&] {
+                for (std::size_t i = 0; i < boxCount; i++) {
+                    outBoxes[i] = boxes[i].Transformed(matrix);
+                }
+                DoNotOptimize(outBoxes.data());
+            });
+            PrintSpeedup(corners, arvo);
+            const Result batch = RunAndPrint("TransformAABBs", boxCount, [&] {
+                TransformAABBs(matrix, mins, maxs, outMins, outMaxs);
+                DoNotOptimize(outMins.data);
+            });
+            PrintSpeedup(corners, batch);
+            RunAndPrint("TransformSpheres", boxCount, [&] {
+                TransformSpheres(matrix, spheres, outSpheres);
+                DoNotOptimize(outSpheres.data);
+            });
+            RunAndPrint("MergeAABBs", boxCount, [&] {
+                DoNotOptimize(MergeAABBs(mins, maxs));
+            });
+            const AABB<float> query{ vec3{ -30.f }, vec3{ 30.f } };
+            const Result intersectScalar = RunAndPrint("AABB::Intersects, scalar loop", boxCount, [&] {
+                for (std::size_t i = 0; i < boxCount; i++) {
+                    DoNotOptimize(query.Intersects(boxes[i]));
+                }
+            });
+            const Result intersectBatch = RunAndPrint("IntersectAABBs", boxCount, [&] {
+                IntersectAABBs(query, mins, maxs, hits);
+                DoNotOptimize(hits.data());
+            });
+            PrintSpeedup(intersectScalar, intersectBatch);
+            RunAndPrint("IntersectSpheres", boxCount, [&] {
+                IntersectSpheres(Sphere<float>{ vec3{ 0.f }, 30.f }, spheres, hits);
+                DoNotOptimize(hits.data());
+            });
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#include "Bench.h"
+
+#include "Camera.h"
+#include "CameraCSRuntime.h"
+#include "Frustum.h"
+
+#include <vector>
+
+namespace lab {
+    namespace Bench {
+        namespace {
+            using BenchCS = CoordinateSystem<Direction::XDir<true>, Direction::YDir<true>, Direction::ZDir<true>>;
+        }
+
+        void BenchCamera() {
+            const std::vector<float> fovs = RandomFloats(elementCount, 0.5f, 2.f, 40);
+            const std::vector<float> aspects = RandomFloats(elementCount, 0.5f, 2.5f, 41);
+            const std::vector<float> coords = RandomFloats(elementCount * 3, -50.f, 50.f, 42);
+            std::vector<vec3> positions(elementCount);
+            std::vector<vec3> rotations(elementCount);
+            std::vector<vec3> forwards(elementCount);
+            for (std::size_t i = 0; i < elementCount; i++) {
+                positions[i] = vec3{ coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2] };
+                rotations[i] = vec3{ fovs[i], aspects[i], fovs[i] - aspects[i] };
+                //never parallel to the up vector
+                forwards[i] = vec3{ 1.f, fovs[i] - 1.f, aspects[i] - 1.5f }.Normalized();
+            }
+            std::vector<mat4> out(elementCount);
+
+            PrintHeader("Camera (per element)");
+            RunAndPrint("ProjectionMatrix", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    ProjectionMatrix(out[i], fovs[i], aspects[i], 0.1f, 1000.f);
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("PerspectiveMatrix", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    PerspectiveMatrix(out[i], fovs[i], aspects[i], 0.1f, 1000.f);
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("OrthographicMatrix", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    OrthographicMatrix(out[i], -aspects[i], aspects[i], -fovs[i], fovs[i], 0.1f, 1000.f);
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("ViewDirection", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    ViewDirection<BenchCS>(out[i], positions[i], forwards[i]);
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("ViewRotation", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    ViewRotation<BenchCS>(out[i], positions[i], rotations[i]);
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("ViewTarget", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    ViewTarget<BenchCS>(out[i], positions[i], positions[i] + forwards[i]);
+                }
+                DoNotOptimize(out.data());
+            });
+
+            const Runtime::CoordinateSystem runtimeCS{};
+            RunAndPrint("Runtime::ViewDirection", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    Runtime::ViewDirection(runtimeCS, out[i], positions[i], forwards[i]);
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("Runtime::ViewRotation", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    Runtime::ViewRotation(runtimeCS, out[i], positions[i], rotations[i]);
+                }
+                DoNotOptimize(out.data());
+            });
+
+            const mat4 viewProjection = ProjectionMatrix(1.2f, 1.5f, 0.1f, 1000.f) * ViewDirection<BenchCS>(positions[0], forwards[0]);
+            std::vector<Frustum<float>> frustums(elementCount);
+            RunAndPrint("Frustum::FromMatrix", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    frustums[i] = Frustum<float>::FromMatrix(out[i]);
+                }
+                DoNotOptimize(frustums.data());
+            });
+
+            //objects scattered around the camera, roughly a third of them end up visible
+            constexpr std::size_t objectCount = 4096;
+            const std::vector<float> centers = RandomFloats(objectCount * 3, -100.f, 100.f, 43);
+            const std::vector<float> radii = RandomFloats(objectCount, 0.5f, 5.f, 44);
+            const Frustum<float> frustum = Frustum<float>::FromMatrix(viewProjection);
+            VectorSoA<float, 4> spheres;
+            VectorSoA<float, 3> mins;
+            VectorSoA<float, 3> maxs;
+            for (std::size_t i = 0; i < objectCount; i++) {
+                const vec3 center = positions[0] + vec3{ centers[i * 3], centers[i * 3 + 1], centers[i * 3 + 2] };
+                spheres.PushBack(vec4{ center.x, center.y, center.z, radii[i] });
+                mins.PushBack(center - vec3{ radii[i] });
+                maxs.PushBack(center + vec3{ radii[i] });
+            }
+            std::vector<uint64_t> visibility(BitmaskWordCount(objectCount));
+
+            PrintHeader("Frustum culling (per object, 4096 objects)");
+            const Result sphereScalar = RunAndPrint("IntersectsSphere, scalar loop", objectCount, [&] {
+                for (std::size_t i = 0; i < objectCount; i++) {
+                    const vec4 sphere = spheres.Get(i);
+                    DoNotOptimize(frustum.IntersectsSphere(vec3{ sphere.x, sphere.y, sphere.z }, sphere.w));
+                }
+            });
+            const Result sphereBatch = RunAndPrint("CullSpheres", objectCount, [&] {
+                CullSpheres(frustum, spheres, visibility);
+                DoNotOptimize(visibility.data());
+            });
+            PrintSpeedup(sphereScalar, sphereBatch);
+            const Result aabbScalar = RunAndPrint("IntersectsAABB, scalar loop", objectCount, [&] {
+                for (std::size_t i = 0; i < objectCount; i++) {
+                    DoNotOptimize(frustum.IntersectsAABB(mins.Get(i), maxs.Get(i)));
+                }
+            });
+            const Result aabbBatch = RunAndPrint("CullAABBs", objectCount, [&] {
+                CullAABBs(frustum, mins, maxs, visibility);
+                DoNotOptimize(visibility.data());
+            });
+            PrintSpeedup(aabbScalar, aabbBatch);
+        }
+    }
+}
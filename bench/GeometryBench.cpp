@@ -0,0 +1,198 @@
+#include "Bench.h"
+
+#include "Geometry.h"
+#include "Vector/Hash.h"
+
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace lab {
+    namespace Bench {
+        void BenchGeometry() {
+            //a 128 x 128 height field, 32k triangles
+            constexpr int gridSize = 128;
+            std::vector<vec3> vertices;
+            vertices.reserve(gridSize * gridSize * 6);
+            auto height = [](int const x, int const z) {
+                return std::sin(static_cast<float>(x) * 0.3f) * std::cos(static_cast<float>(z) * 0.2f) * 3.f;
+            };
+            for (int x = 0; x < gridSize; x++) {
+                for (int z = 0; z < gridSize; z++) {
+                    const vec3 corner00{ static_cast<float>(x), height(x, z), static_cast<float>(z) };
+                    const vec3 corner10{ static_cast<float>(x + 1), height(x + 1, z), static_cast<float>(z) };
+                    const vec3 corner01{ static_cast<float>(x), height(x, z + 1), static_cast<float>(z + 1) };
+                    const vec3 corner11{ static_cast<float>(x + 1), height(x + 1, z + 1), static_cast<float>(z + 1) };
+                    vertices.insert(vertices.end(), { corner00, corner10, corner01, corner10, corner11, corner01 });
+                }
+            }
+            const std::size_t triangleCount = vertices.size() / 3;
+
+            //a 32 x 32 pixel camera looking down at the middle of the field, neighbouring rays end up in the same packet
+            constexpr std::size_t screenSize = 32;
+            static_assert(screenSize * screenSize == elementCount);
+            const vec3 eye{ 64.f, 40.f, -20.f };
+            std::vector<Ray<float>> rays(elementCount);
+            for (std::size_t y = 0; y < screenSize; y++) {
+                for (std::size_t x = 0; x < screenSize; x++) {
+                    const vec3 target{ 32.f + static_cast<float>(x) * 2.f, 0.f, 32.f + static_cast<float>(y) * 2.f };
+                    rays[y * screenSize + x] = Ray<float>{ eye, target - eye };
+                }
+            }
+            std::vector<RayHit<float>> hits(elementCount);
+
+            PrintHeader("BVH (32k triangle height field)");
+            BVH<float> bvh;
+            RunAndPrint("Build, per triangle", triangleCount, [&] {
+                bvh = BVH<float>::Build(vertices);
+                DoNotOptimize(bvh.nodes.data());
+            });
+
+            PrintHeader("Ray queries (per ray, 32k triangles)");
+            //the brute force row is 32k triangle tests per ray, it runs over a slice of the rays
+            constexpr std::size_t bruteRayCount = 16;
+            const Result brute = RunAndPrint("IntersectTriangle, every triangle", bruteRayCount, [&] {
+                for (std::size_t i = 0; i < bruteRayCount; i++) {
+                    RayHit<float> hit;
+                    for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+                        IntersectTriangle(rays[i], vertices[triangle * 3], vertices[triangle * 3 + 1], vertices[triangle * 3 + 2], triangle, hit);
+                    }
+                    DoNotOptimize(hit);
+                }
+            });
+            std::vector<uint32_t> indices(vertices.size());
+            for (uint32_t i = 0; i < indices.size(); i++) {
+                indices[i] = i;
+            }
+            const TriangleSoA<float> soa = TriangleSoA<float>::FromMesh(vertices, indices);
+            const Result soaBrute = RunAndPrint("IntersectTriangles, every triangle (SoA)", bruteRayCount, [&] {
+                for (std::size_t i = 0; i < bruteRayCount; i++) {
+                    RayHit<float> hit;
+                    IntersectTriangles(rays[i], soa, hit);
+                    DoNotOptimize(hit);
+                }
+            });
+            PrintSpeedup(brute, soaBrute);
+            const Result single = RunAndPrint("BVH::Intersect, single ray", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    RayHit<float> hit;
+                    bvh.Intersect(rays[i], hit);
+                    DoNotOptimize(hit);
+                }
+            });
+            PrintSpeedup(brute, single);
+            const Result packet = RunAndPrint("BVH::Intersect, packets", elementCount, [&] {
+                for (auto& hit : hits) {
+                    hit = RayHit<float>{};
+                }
+                bvh.Intersect(rays, hits);
+                DoNotOptimize(hits.data());
+            });
+            PrintSpeedup(single, packet);
+            RunAndPrint("BVH::Occluded", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    DoNotOptimize(bvh.Occluded(rays[i], 1.f));
+                }
+            });
+        
+            //agents spread over a 400 x 400 x 50 area, about 2 per cell
+            constexpr std::size_t agentCount = 128 * 1024;
+            constexpr float cellSize = 4.f;
+            const std::vector<float> xs = RandomFloats(agentCount, 0.f, 400.f, 11);
+            const std::vector<float> ys = RandomFloats(agentCount, 0.f, 50.f, 12);
+            const std::vector<float> zs = RandomFloats(agentCount, 0.f, 400.f, 13);
+            std::vector<vec3> agents(agentCount);
+            for (std::size_t i = 0; i < agentCount; i++) {
+                agents[i] = vec3{ xs[i], ys[i], zs[i] };
+            }
+
+            PrintHeader("Spatial hash grid (128k points, per point)");
+            //the baseline keys the cells by their floored corner through std::hash<Vector>
+            std::unordered_map<vec3, std::vector<uint32_t>> mapGrid;
+            auto mapCell = [&](vec3 const position) {
+                return vec3{ std::floor(position.x / cellSize), std::floor(position.y / cellSize), std::floor(position.z / cellSize) };
+            };
+            const Result mapBuild = RunAndPrint("unordered_map<vec3> grid, rebuild", agentCount, [&] {
+                for (auto& cell : mapGrid) {
+                    cell.second.clear();
+                }
+                for (uint32_t i = 0; i < agentCount; i++) {
+                    mapGrid[mapCell(agents[i])].push_back(i);
+                }
+                DoNotOptimize(mapGrid.size());
+            });
+            SpatialHashGrid<float, 3> grid{ cellSize };
+            const Result gridBuild = RunAndPrint("SpatialHashGrid, Clear + Insert", agentCount, [&] {
+                grid.Clear();
+                grid.Insert(agents);
+                DoNotOptimize(grid.indices.data());
+            });
+            PrintSpeedup(mapBuild, gridBuild);
+
+            PrintHeader("Spatial hash grid queries (per query, 128k points)");
+            constexpr std::size_t queryCount = 1024;
+            constexpr float queryRadius = 6.f;
+            const Result mapRadius = RunAndPrint("unordered_map<vec3> grid, radius 6", queryCount, [&] {
+                std::size_t found = 0;
+                for (std::size_t q = 0; q < queryCount; q++) {
+                    const vec3 center = agents[q * 97];
+                    const vec3 low = mapCell(center - vec3{ queryRadius });
+                    const vec3 high = mapCell(center + vec3{ queryRadius });
+                    for (float x = low.x; x <= high.x; x++) {
+                        for (float y = low.y; y <= high.y; y++) {
+                            for (float z = low.z; z <= high.z; z++) {
+                                const auto cell = mapGrid.find(vec3{ x, y, z });
+                                if (cell == mapGrid.end()) {
+                                    continue;
+                                }
+                                for (uint32_t const index : cell->second) {
+                                    found += (agents[index] - center).SquaredMagnitude() <= queryRadius * queryRadius;
+                                }
+                            }
+                        }
+                    }
+                }
+                DoNotOptimize(found);
+            });
+            std::vector<SpatialHashGrid<float, 3>::Neighbor> neighbors;
+            const Result gridRadius = RunAndPrint("SpatialHashGrid::QueryRadius, radius 6", queryCount, [&] {
+                for (std::size_t q = 0; q < queryCount; q++) {
+                    grid.QueryRadius(agents[q * 97], queryRadius, neighbors);
+                    DoNotOptimize(neighbors.data());
+                }
+            });
+            PrintSpeedup(mapRadius, gridRadius);
+            RunAndPrint("SpatialHashGrid::QueryNearest, k 8", queryCount, [&] {
+                for (std::size_t q = 0; q < queryCount; q++) {
+                    grid.QueryNearest(agents[q * 97], 8, neighbors);
+                    DoNotOptimize(neighbors.data());
+                }
+            });
+
+            //the height field is a triangle soup, every corner is in it up to 6 times
+            PrintHeader("Vertex welding (98k vertex triangle soup, per vertex)");
+            const Result mapWeld = RunAndPrint("unordered_map<vec3, uint32_t>, exact", vertices.size(), [&] {
+                std::unordered_map<vec3, uint32_t> unique;
+                std::vector<vec3> welded;
+                std::vector<uint32_t> remap(vertices.size());
+                for (std::size_t i = 0; i < vertices.size(); i++) {
+                    const auto inserted = unique.try_emplace(vertices[i], static_cast<uint32_t>(welded.size()));
+                    if (inserted.second) {
+                        welded.push_back(vertices[i]);
+                    }
+                    remap[i] = inserted.first->second;
+                }
+                DoNotOptimize(remap.data());
+            });
+            const Result exactWeld = RunAndPrint("WeldVertices, epsilon 0", vertices.size(), [&] {
+                const WeldResult<float> welded = WeldVertices<float>(vertices, 0.f);
+                DoNotOptimize(welded.remap.data());
+            });
+            PrintSpeedup(mapWeld, exactWeld);
+            RunAndPrint("WeldVertices, epsilon 0.001", vertices.size(), [&] {
+                const WeldResult<float> welded = WeldVertices<float>(vertices, 0.001f);
+                DoNotOptimize(welded.remap.data());
+            });
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#include "Bench.h"
+
+#include "Support/Trig.h"
+#include "Support/TrigBatch.h"
+
+#include <vector>
+
+namespace lab {
+    namespace Bench {
+        namespace {
+            //one row per function for a single precision tier
+            template<Precision P>
+            void BenchTier(char const* tierName, std::vector<float> const& angles, std::vector<float> const& unit, std::vector<float> const& positive, std::vector<float>& output) {
+                char name[64];
+                auto label = [&](char const* function) {
+                    snprintf(name, sizeof(name), "%s<%s>", function, tierName);
+                    return name;
+                };
+
+                RunAndPrint(label("Sin"), angles.size(), [&] {
+                    for (std::size_t i = 0; i < angles.size(); i++) {
+                        output[i] = Sin<P>(angles[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+                RunAndPrint(label("Cos"), angles.size(), [&] {
+                    for (std::size_t i = 0; i < angles.size(); i++) {
+                        output[i] = Cos<P>(angles[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+                RunAndPrint(label("SinCos"), angles.size(), [&] {
+                    for (std::size_t i = 0; i < angles.size(); i++) {
+                        const auto [sine, cosine] = SinCos<P>(angles[i]);
+                        output[i] = sine + cosine;
+                    }
+                    DoNotOptimize(output.data());
+                });
+                RunAndPrint(label("Tan"), angles.size(), [&] {
+                    for (std::size_t i = 0; i < angles.size(); i++) {
+                        output[i] = Tan<P>(angles[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+                RunAndPrint(label("ArcSin"), unit.size(), [&] {
+                    for (std::size_t i = 0; i < unit.size(); i++) {
+                        output[i] = ArcSin<P>(unit[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+                RunAndPrint(label("ArcCos"), unit.size(), [&] {
+                    for (std::size_t i = 0; i < unit.size(); i++) {
+                        output[i] = ArcCos<P>(unit[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+                RunAndPrint(label("ArcTan"), angles.size(), [&] {
+                    for (std::size_t i = 0; i < angles.size(); i++) {
+                        output[i] = ArcTan<P>(angles[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+                RunAndPrint(label("ArcTan2"), angles.size(), [&] {
+                    for (std::size_t i = 0; i < angles.size(); i++) {
+                        output[i] = ArcTan2<P>(angles[i], unit[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+                RunAndPrint(label("Sqrt"), positive.size(), [&] {
+                    for (std::size_t i = 0; i < positive.size(); i++) {
+                        output[i] = Sqrt<P>(positive[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+                RunAndPrint(label("InverseSqrt"), positive.size(), [&] {
+                    for (std::size_t i = 0; i < positive.size(); i++) {
+                        output[i] = InverseSqrt<P>(positive[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+            }
+
+            void BenchTrigBatch(std::vector<float> const& angles, std::vector<float>& output) {
+                PrintHeader("Trig batch (per element)");
+
+                const auto sinLoop = RunAndPrint("Sin, per call loop", angles.size(), [&] {
+                    for (std::size_t i = 0; i < angles.size(); i++) {
+                        output[i] = Sin(angles[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+                const auto sinBatch = RunAndPrint("SinBatch", angles.size(), [&] {
+                    SinBatch<float>(angles, output);
+                    DoNotOptimize(output.data());
+                });
+                PrintSpeedup(sinLoop, sinBatch);
+
+                const auto cosLoop = RunAndPrint("Cos, per call loop", angles.size(), [&] {
+                    for (std::size_t i = 0; i < angles.size(); i++) {
+                        output[i] = Cos(angles[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+                const auto cosBatch = RunAndPrint("CosBatch", angles.size(), [&] {
+                    CosBatch<float>(angles, output);
+                    DoNotOptimize(output.data());
+                });
+                PrintSpeedup(cosLoop, cosBatch);
+
+                const auto tanLoop = RunAndPrint("Tan, per call loop", angles.size(), [&] {
+                    for (std::size_t i = 0; i < angles.size(); i++) {
+                        output[i] = Tan(angles[i]);
+                    }
+                    DoNotOptimize(output.data());
+                });
+                const auto tanBatch = RunAndPrint("TanBatch", angles.size(), [&] {
+                    TanBatch<float>(angles, output);
+                    DoNotOptimize(output.data());
+                });
+                PrintSpeedup(tanLoop, tanBatch);
+
+                std::vector<float> cosOutput(angles.size());
+                const auto sinAndCos = RunAndPrint("Sin + Cos, per call loop", angles.size(), [&] {
+                    for (std::size_t i = 0; i < angles.size(); i++) {
+                        output[i] = Sin(angles[i]);
+                        cosOutput[i] = Cos(angles[i]);
+                    }
+                    DoNotOptimize(output.data());
+                    DoNotOptimize(cosOutput.data());
+                });
+                const auto sinCos = RunAndPrint("SinCos, per call loop", angles.size(), [&] {
+                    for (std::size_t i = 0; i < angles.size(); i++) {
+                        const auto [sine, cosine] = SinCos(angles[i]);
+                        output[i] = sine;
+                        cosOutput[i] = cosine;
+                    }
+                    DoNotOptimize(output.data());
+                    DoNotOptimize(cosOutput.data());
+                });
+                PrintSpeedup(sinAndCos, sinCos);
+            }
+        }
+
+        void BenchMath() {
+            const std::vector<float> angles = RandomFloats(elementCount, -20.f, 20.f);
+            const std::vector<float> unit = RandomFloats(elementCount, -1.f, 1.f, 2);
+            const std::vector<float> positive = RandomFloats(elementCount, 0.001f, 1000.f, 3);
+            std::vector<float> output(elementCount);
+
+            PrintHeader("Trig and sqrt (per element)");
+            BenchTier<Precision::Fast>("Fast", angles, unit, positive, output);
+            BenchTier<Precision::Balanced>("Balanced", angles, unit, positive, output);
+            BenchTier<Precision::Precise>("Precise", angles, unit, positive, output);
+
+            //the bit hack that constexpr and LAB_DETERMINISTIC use, against whatever InverseSqrt/Sqrt dispatch to in this build
+            const auto softwareInverseSqrt = RunAndPrint("SoftwareInverseSqrt", positive.size(), [&] {
+                for (std::size_t i = 0; i < positive.size(); i++) {
+                    output[i] = SoftwareInverseSqrt(positive[i]);
+                }
+                DoNotOptimize(output.data());
+            });
+            const auto inverseSqrt = RunAndPrint("InverseSqrt", positive.size(), [&] {
+                for (std::size_t i = 0; i < positive.size(); i++) {
+                    output[i] = InverseSqrt(positive[i]);
+                }
+                DoNotOptimize(output.data());
+            });
+            PrintSpeedup(softwareInverseSqrt, inverseSqrt);
+            const auto softwareSqrt = RunAndPrint("SoftwareSqrt", positive.size(), [&] {
+                for (std::size_t i = 0; i < positive.size(); i++) {
+                    output[i] = SoftwareSqrt(positive[i]);
+                }
+                DoNotOptimize(output.data());
+            });
+            const auto sqrt = RunAndPrint("Sqrt", positive.size(), [&] {
+                for (std::size_t i = 0; i < positive.size(); i++) {
+                    output[i] = Sqrt(positive[i]);
+                }
+                DoNotOptimize(output.data());
+            });
+            PrintSpeedup(softwareSqrt, sqrt);
+            //Precise is the InverseSqrt tier that takes the hardware sqrt, the default only changes Sqrt
+            const auto softwareInverseSqrtPrecise = RunAndPrint("SoftwareInverseSqrt Precise", positive.size(), [&] {
+                for (std::size_t i = 0; i < positive.size(); i++) {
+                    output[i] = SoftwareInverseSqrt<Precision::Precise>(positive[i]);
+                }
+                DoNotOptimize(output.data());
+            });
+            const auto inverseSqrtPrecise = RunAndPrint("InverseSqrt Precise", positive.size(), [&] {
+                for (std::size_t i = 0; i < positive.size(); i++) {
+                    output[i] = InverseSqrt<Precision::Precise>(positive[i]);
+                }
+                DoNotOptimize(output.data());
+            });
+            PrintSpeedup(softwareInverseSqrtPrecise, inverseSqrtPrecise);
+
+            BenchTrigBatch(angles, output);
+        }
+    }
+}
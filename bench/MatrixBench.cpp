@@ -0,0 +1,196 @@
+#include "Bench.h"
+
+#include "Vector.h"
+#include "Matrix.h"
+
+#include <vector>
+
+namespace lab {
+    namespace Bench {
+        namespace {
+            //random rotation * translation * scale, so every matrix is invertible
+            std::vector<mat4> RandomTransforms(std::size_t const count, uint32_t const seed) {
+                const std::vector<float> floats = RandomFloats(count * 8, 0.5f, 4.f, seed);
+                std::vector<mat4> ret(count);
+                for (std::size_t i = 0; i < count; i++) {
+                    float const* params = &floats[i * 8];
+                    const vec3 axis = vec3{ params[0], params[1], params[2] }.Normalized();
+                    ret[i] = RotateAroundAxis(params[3], axis) * IdentityTranslation(params[4], params[5], params[6]) * IdentityScale(params[7], params[7], params[7]);
+                }
+                return ret;
+            }
+
+            void BenchMatrix4x4(std::vector<mat4> const& lhs, std::vector<mat4> const& rhs) {
+                std::vector<mat4> out(lhs.size());
+                std::vector<float> scalarOut(lhs.size());
+                std::vector<vec4> vecOut(lhs.size());
+                const vec4 point{ 1.f, 2.f, 3.f, 1.f };
+
+                PrintHeader("Matrix4x4 (per element)");
+                RunAndPrint("mat4 * mat4", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i] * rhs[i];
+                    }
+                    DoNotOptimize(out.data());
+                });
+                RunAndPrint("mat4 * vec4", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        vecOut[i] = lhs[i] * point;
+                    }
+                    DoNotOptimize(vecOut.data());
+                });
+                RunAndPrint("mat4 Transposed", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i].Transposed();
+                    }
+                    DoNotOptimize(out.data());
+                });
+                RunAndPrint("mat4 GetDeterminant", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        scalarOut[i] = lhs[i].GetDeterminant();
+                    }
+                    DoNotOptimize(scalarOut.data());
+                });
+                RunAndPrint("mat4 GetInverse", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i].GetInverse();
+                    }
+                    DoNotOptimize(out.data());
+                });
+                RunAndPrint("mat4 GetAffineInverse", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i].GetAffineInverse();
+                    }
+                    DoNotOptimize(out.data());
+                });
+            }
+
+            void BenchMatrix3x3(std::vector<mat4> const& lhs4, std::vector<mat4> const& rhs4) {
+                std::vector<mat3> lhs(lhs4.size());
+                std::vector<mat3> rhs(rhs4.size());
+                for (std::size_t i = 0; i < lhs.size(); i++) {
+                    lhs[i] = mat3{ vec3{ lhs4[i].columns[0] }, vec3{ lhs4[i].columns[1] }, vec3{ lhs4[i].columns[2] } };
+                    rhs[i] = mat3{ vec3{ rhs4[i].columns[0] }, vec3{ rhs4[i].columns[1] }, vec3{ rhs4[i].columns[2] } };
+                }
+                std::vector<mat3> out(lhs.size());
+                std::vector<float> scalarOut(lhs.size());
+
+                PrintHeader("Matrix3x3 (per element)");
+                RunAndPrint("mat3 * mat3", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i] * rhs[i];
+                    }
+                    DoNotOptimize(out.data());
+                });
+                RunAndPrint("mat3 GetDeterminant", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        scalarOut[i] = lhs[i].GetDeterminant();
+                    }
+                    DoNotOptimize(scalarOut.data());
+                });
+                RunAndPrint("mat3 GetInverse", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i].GetInverse();
+                    }
+                    DoNotOptimize(out.data());
+                });
+            }
+
+            //count past L2 shows what the prefetch buys, elementCount stays in cache
+            void BenchMultiplyBatch(std::size_t const count) {
+                const std::vector<mat4> lhs = RandomTransforms(count, 23);
+                const std::vector<mat4> rhs = RandomTransforms(count, 24);
+                std::vector<mat4> out(count);
+                mat4 parent = lhs[0];
+                ClobberValue(parent);
+
+                char name[64];
+                snprintf(name, sizeof(name), "mat4 * mat4, per call loop (%zu)", count);
+                const auto perCall = RunAndPrint(name, count, [&] {
+                    for (std::size_t i = 0; i < count; i++) {
+                        out[i] = lhs[i] * rhs[i];
+                    }
+                    DoNotOptimize(out.data());
+                });
+                snprintf(name, sizeof(name), "MultiplyBatch (%zu)", count);
+                const auto batch = RunAndPrint(name, count, [&] {
+                    MultiplyBatch<float>(lhs, rhs, out);
+                    DoNotOptimize(out.data());
+                });
+                PrintSpeedup(perCall, batch);
+
+                snprintf(name, sizeof(name), "parent * mat4, per call loop (%zu)", count);
+                const auto perCallParent = RunAndPrint(name, count, [&] {
+                    for (std::size_t i = 0; i < count; i++) {
+                        out[i] = parent * rhs[i];
+                    }
+                    DoNotOptimize(out.data());
+                });
+                snprintf(name, sizeof(name), "MultiplyBatch, broadcast lhs (%zu)", count);
+                const auto batchParent = RunAndPrint(name, count, [&] {
+                    MultiplyBatch(parent, rhs, out);
+                    DoNotOptimize(out.data());
+                });
+                PrintSpeedup(perCallParent, batchParent);
+            }
+
+            void BenchTransformPoints(mat4 matrix) {
+                //otherwise the per call loop gets the matrix constant folded in, which a real caller wouldnt
+                ClobberValue(matrix);
+
+                const std::vector<float> floats = RandomFloats(elementCount * 3, -100.f, 100.f, 20);
+                std::vector<vec4> vec4In(elementCount);
+                std::vector<vec4> vec4Out(elementCount);
+                std::vector<vec3> vec3In(elementCount);
+                std::vector<vec3> vec3Out(elementCount);
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    vec3In[i] = vec3{ floats[i * 3], floats[i * 3 + 1], floats[i * 3 + 2] };
+                    vec4In[i] = vec4{ vec3In[i], 1.f };
+                }
+
+                PrintHeader("TransformPoints (per element)");
+
+                const auto perCall4 = RunAndPrint("mat4 * vec4, per call loop", elementCount, [&] {
+                    for (std::size_t i = 0; i < elementCount; i++) {
+                        vec4Out[i] = matrix * vec4In[i];
+                    }
+                    DoNotOptimize(vec4Out.data());
+                });
+                const auto batch4 = RunAndPrint("TransformPoints vec4", elementCount, [&] {
+                    TransformPoints(matrix, vec4In, vec4Out);
+                    DoNotOptimize(vec4Out.data());
+                });
+                PrintSpeedup(perCall4, batch4);
+
+                const auto perCall3 = RunAndPrint("mat4 * vec4(vec3, 1), per call loop", elementCount, [&] {
+                    for (std::size_t i = 0; i < elementCount; i++) {
+                        vec3Out[i] = vec3{ matrix * vec4{ vec3In[i], 1.f } };
+                    }
+                    DoNotOptimize(vec3Out.data());
+                });
+                const auto batch3 = RunAndPrint("TransformPoints vec3", elementCount, [&] {
+                    TransformPoints(matrix, vec3In, vec3Out);
+                    DoNotOptimize(vec3Out.data());
+                });
+                PrintSpeedup(perCall3, batch3);
+                RunAndPrint("TransformDirections vec3", elementCount, [&] {
+                    TransformDirections(matrix, vec3In, vec3Out);
+                    DoNotOptimize(vec3Out.data());
+                });
+            }
+        }
+
+        void BenchMatrix() {
+            const std::vector<mat4> lhs = RandomTransforms(elementCount, 21);
+            const std::vector<mat4> rhs = RandomTransforms(elementCount, 22);
+
+            BenchMatrix4x4(lhs, rhs);
+            BenchMatrix3x3(lhs, rhs);
+
+            PrintHeader("MultiplyBatch (per matrix)");
+            BenchMultiplyBatch(elementCount);
+            BenchMultiplyBatch(elementCount * 64);
+            BenchTransformPoints(lhs[0]);
+        }
+    }
+}
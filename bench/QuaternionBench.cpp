@@ -0,0 +1,160 @@
+#include "Bench.h"
+
+#include "Quaternion.h"
+#include "Quaternion/QuaternionBatch.h"
+#include "Quaternion/QuaternionCompression.h"
+
+#include <vector>
+
+namespace lab {
+    namespace Bench {
+        namespace {
+            std::vector<Quat> RandomRotations(std::size_t const count, uint32_t const seed) {
+                const std::vector<float> floats = RandomFloats(count * 4, -1.f, 1.f, seed);
+                std::vector<Quat> ret(count);
+                for (std::size_t i = 0; i < count; i++) {
+                    ret[i] = Quat::AngleAxis(floats[i * 4] * PI<float>, vec3{ floats[i * 4 + 1], floats[i * 4 + 2], floats[i * 4 + 3] });
+                }
+                return ret;
+            }
+        }
+
+        void BenchQuaternion() {
+            const std::vector<Quat> lhs = RandomRotations(elementCount, 30);
+            const std::vector<Quat> rhs = RandomRotations(elementCount, 31);
+            const std::vector<float> weights = RandomFloats(elementCount, 0.f, 1.f, 32);
+            std::vector<Quat> out(elementCount);
+            std::vector<mat4> matOut(elementCount);
+
+            PrintHeader("Quaternion (per element)");
+            RunAndPrint("Quat * Quat", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    out[i] = lhs[i] * rhs[i];
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("Quat Normalized", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    out[i] = lhs[i].Normalized();
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("Quat::Mix", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    out[i] = Quat::Mix(lhs[i], rhs[i], weights[i]);
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("Quat::Nlerp", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    out[i] = Quat::Nlerp(lhs[i], rhs[i], weights[i]);
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("Quat::FastSlerp", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    out[i] = Quat::FastSlerp(lhs[i], rhs[i], weights[i]);
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("Quat::AngleAxis", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    out[i] = Quat::AngleAxis(weights[i], vec3{ lhs[i].x, lhs[i].y, lhs[i].z });
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("Quat ToMat4", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    matOut[i] = lhs[i].ToMat4();
+                }
+                DoNotOptimize(matOut.data());
+            });
+            RunAndPrint("Quat::FromMatrix", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    out[i] = Quat::FromMatrix(matOut[i]);
+                }
+                DoNotOptimize(out.data());
+            });
+            const std::vector<float> coords = RandomFloats(elementCount * 3, -10.f, 10.f, 33);
+            std::vector<vec3> vectors(elementCount);
+            for (std::size_t i = 0; i < elementCount; i++) {
+                vectors[i] = vec3{ coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2] };
+            }
+            std::vector<vec3> vecOut(elementCount);
+            RunAndPrint("Quat RotateVector", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    vecOut[i] = lhs[i].RotateVector(vectors[i]);
+                }
+                DoNotOptimize(vecOut.data());
+            });
+            std::vector<uint32_t> compressed32(elementCount);
+            std::vector<uint64_t> compressed64(elementCount);
+            RunAndPrint("CompressSmallestThree<10>", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    compressed32[i] = CompressSmallestThree<10>(lhs[i]);
+                }
+                DoNotOptimize(compressed32.data());
+            });
+            RunAndPrint("DecompressSmallestThree<10>", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    out[i] = DecompressSmallestThree<10>(compressed32[i]);
+                }
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("CompressSmallestThree<15>", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    compressed64[i] = CompressSmallestThree<15>(lhs[i]);
+                }
+                DoNotOptimize(compressed64.data());
+            });
+            RunAndPrint("DecompressSmallestThree<15>", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    out[i] = DecompressSmallestThree<15>(compressed64[i]);
+                }
+                DoNotOptimize(out.data());
+            });
+
+            PrintHeader("Quaternion batch (per element)");
+            RunAndPrint("MultiplyBatch", elementCount, [&] {
+                MultiplyBatch<float>(lhs, rhs, out);
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("NormalizeBatch", elementCount, [&] {
+                NormalizeBatch<float>(lhs, out);
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("NlerpBatch", elementCount, [&] {
+                NlerpBatch<float>(lhs, rhs, weights, out);
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("FastSlerpBatch", elementCount, [&] {
+                FastSlerpBatch<float>(lhs, rhs, weights, out);
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("RotateVectorBatch", elementCount, [&] {
+                RotateVectorBatch<float>(lhs, vectors, vecOut);
+                DoNotOptimize(vecOut.data());
+            });
+            RunAndPrint("ToMat4Batch", elementCount, [&] {
+                ToMat4Batch<float>(lhs, matOut);
+                DoNotOptimize(matOut.data());
+            });
+            RunAndPrint("CompressSmallestThreeBatch<10>", elementCount, [&] {
+                CompressSmallestThreeBatch<10, float>(lhs, compressed32);
+                DoNotOptimize(compressed32.data());
+            });
+            RunAndPrint("DecompressSmallestThreeBatch<10>", elementCount, [&] {
+                DecompressSmallestThreeBatch<10, float>(compressed32, out);
+                DoNotOptimize(out.data());
+            });
+            RunAndPrint("CompressSmallestThreeBatch<15>", elementCount, [&] {
+                CompressSmallestThreeBatch<15, float>(lhs, compressed64);
+                DoNotOptimize(compressed64.data());
+            });
+            RunAndPrint("DecompressSmallestThreeBatch<15>", elementCount, [&] {
+                DecompressSmallestThreeBatch<15, float>(compressed64, out);
+                DoNotOptimize(out.data());
+            });
+        }
+    }
+}
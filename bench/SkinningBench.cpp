@@ -0,0 +1,84 @@
+#include "Bench.h"
+
+#include "Skinning.h"
+
+#include <vector>
+
+namespace lab {
+    namespace Bench {
+        void BenchSkinning() {
+            constexpr std::size_t boneCount = 64;
+            const std::vector<float> boneFloats = RandomFloats(boneCount * 7, -1.f, 1.f, 40);
+            std::vector<mat4> matrices(boneCount);
+            std::vector<DualQuat> dualQuats(boneCount);
+            for (std::size_t b = 0; b < boneCount; b++) {
+                float const* f = &boneFloats[b * 7];
+                const Quat rotation = Quat::AngleAxis(f[0] * PI<float>, vec3{ f[1], f[2], f[3] });
+                const vec3 translation{ f[4], f[5], f[6] };
+                matrices[b] = rotation.ToMat4();
+                matrices[b].columns[3] = mat4::ColType(translation.x, translation.y, translation.z, 1.f);
+                dualQuats[b] = DualQuat::FromRotationTranslation(rotation, translation);
+            }
+
+            const std::vector<float> rawWeights = RandomFloats(elementCount * SkinInfluences, 0.f, 1.f, 41);
+            const std::vector<float> rawIndices = RandomFloats(elementCount * SkinInfluences, 0.f, float(boneCount), 42);
+            std::vector<float> weights(elementCount * SkinInfluences);
+            std::vector<uint16_t> boneIndices(elementCount * SkinInfluences);
+            for (std::size_t i = 0; i < elementCount; i++) {
+                float sum = 0.f;
+                for (uint8_t k = 0; k < SkinInfluences; k++) {
+                    sum += rawWeights[i * SkinInfluences + k];
+                }
+                for (uint8_t k = 0; k < SkinInfluences; k++) {
+                    weights[i * SkinInfluences + k] = rawWeights[i * SkinInfluences + k] / sum;
+                    boneIndices[i * SkinInfluences + k] = static_cast<uint16_t>(rawIndices[i * SkinInfluences + k]) % boneCount;
+                }
+            }
+
+            const std::vector<float> coords = RandomFloats(elementCount * 3, -10.f, 10.f, 43);
+            VectorSoA<float, 3> positions(elementCount);
+            VectorSoA<float, 3> normals(elementCount);
+            for (std::size_t i = 0; i < elementCount; i++) {
+                const vec3 position{ coords[i * 3], coords[i * 3 + 1], coords[i * 3 + 2] };
+                positions.Set(i, position);
+                normals.Set(i, position.Normalized());
+            }
+            VectorSoA<float, 3> outPositions(elementCount);
+            VectorSoA<float, 3> outNormals(elementCount);
+
+            PrintHeader("Skinning (per vertex, 4 influences)");
+            RunAndPrint("linear blend, scalar loop", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    const mat4 blended = detail::BlendPalette<float>(matrices, &boneIndices[i * SkinInfluences], &weights[i * SkinInfluences]);
+                    outPositions.Set(i, detail::SkinPoint(blended, positions.Get(i)));
+                }
+                DoNotOptimize(outPositions.data);
+            });
+            RunAndPrint("SkinLinearBlend", elementCount, [&] {
+                SkinLinearBlend<float>(matrices, boneIndices, weights, positions, outPositions);
+                DoNotOptimize(outPositions.data);
+            });
+            RunAndPrint("SkinLinearBlend + normals", elementCount, [&] {
+                SkinLinearBlend<float>(matrices, boneIndices, weights, positions, normals, outPositions, outNormals);
+                DoNotOptimize(outPositions.data);
+                DoNotOptimize(outNormals.data);
+            });
+            RunAndPrint("dual quaternion, scalar loop", elementCount, [&] {
+                for (std::size_t i = 0; i < elementCount; i++) {
+                    const DualQuat blended = detail::BlendPalette<float>(dualQuats, &boneIndices[i * SkinInfluences], &weights[i * SkinInfluences]).Normalized();
+                    outPositions.Set(i, blended.TransformPoint(positions.Get(i)));
+                }
+                DoNotOptimize(outPositions.data);
+            });
+            RunAndPrint("SkinDualQuaternion", elementCount, [&] {
+                SkinDualQuaternion<float>(dualQuats, boneIndices, weights, positions, outPositions);
+                DoNotOptimize(outPositions.data);
+            });
+            RunAndPrint("SkinDualQuaternion + normals", elementCount, [&] {
+                SkinDualQuaternion<float>(dualQuats, boneIndices, weights, positions, normals, outPositions, outNormals);
+                DoNotOptimize(outPositions.data);
+                DoNotOptimize(outNormals.data);
+            });
+        }
+    }
+}
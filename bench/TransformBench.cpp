@@ -0,0 +1,65 @@
+#include "Bench.h"
+
+#include "Transform.h"
+
+#include <vector>
+
+namespace lab {
+    namespace Bench {
+        void BenchTransform() {
+            //scene sized hierarchy of 32 node objects (a skeleton, a prop with attachments) under one scene root
+            //inside an object every node picks a random earlier node of the same object as its parent
+            constexpr std::size_t nodeCount = 100000;
+            constexpr std::size_t objectSize = 32;
+            const std::vector<float> floats = RandomFloats(nodeCount * 8, -1.f, 1.f, 50);
+            const std::vector<float> parentPicks = RandomFloats(nodeCount, 0.f, 1.f, 51);
+            TransformHierarchy<float> hierarchy;
+            hierarchy.Reserve(nodeCount);
+            for (std::size_t i = 0; i < nodeCount; i++) {
+                float const* params = &floats[i * 8];
+                const std::size_t objectStart = (i == 0) ? 0 : ((i - 1) / objectSize) * objectSize + 1;
+                uint32_t parent = hierarchy.NoParent;
+                if (i == objectStart) {
+                    parent = (i == 0) ? hierarchy.NoParent : 0;
+                }
+                else {
+                    const std::size_t span = i - objectStart;
+                    parent = static_cast<uint32_t>(objectStart + static_cast<std::size_t>(parentPicks[i] * float(span)) % span);
+                }
+                const Quat rotation = Quat::AngleAxis(params[0] * PI<float>, vec3{ params[1], params[2], params[3] });
+                hierarchy.AddNode(parent, vec3{ params[4], params[5], params[6] }, rotation, vec3{ 1.f + params[7] * 0.1f });
+            }
+            hierarchy.Update();
+
+            //3% of the nodes change per frame, their subtrees come along (about 12% of the nodes end up recomputed)
+            const std::size_t changedCount = nodeCount * 3 / 100;
+            const std::vector<float> changedPicks = RandomFloats(changedCount, 0.f, float(nodeCount - 1), 52);
+            std::vector<uint32_t> changed(changedCount);
+            for (std::size_t i = 0; i < changedCount; i++) {
+                changed[i] = static_cast<uint32_t>(changedPicks[i]);
+            }
+
+            std::vector<mat4> worlds(nodeCount);
+            PrintHeader("TransformHierarchy (per node, 100k nodes)");
+            RunAndPrint("full recompute, scalar loop", nodeCount, [&] {
+                for (uint32_t i = 0; i < nodeCount; i++) {
+                    const uint32_t parent = hierarchy.GetParent(i);
+                    worlds[i] = (parent == hierarchy.NoParent) ? hierarchy.GetLocalMatrix(i) : worlds[parent] * hierarchy.GetLocalMatrix(i);
+                }
+                DoNotOptimize(worlds.data());
+            });
+            RunAndPrint("Update, every node dirty", nodeCount, [&] {
+                for (uint32_t i = 0; i < nodeCount; i++) {
+                    hierarchy.MarkDirty(i);
+                }
+                DoNotOptimize(hierarchy.Update());
+            });
+            RunAndPrint("Update, 3% dirty", nodeCount, [&] {
+                for (uint32_t const index : changed) {
+                    hierarchy.MarkDirty(index);
+                }
+                DoNotOptimize(hierarchy.Update());
+            });
+        }
+    }
+}
@@ -0,0 +1,353 @@
+#include "Bench.h"
+
+#include "Vector.h"
+#include "Vector/Hash.h"
+#include "Support/Memory.h"
+
+#include <bit>
+#include <span>
+#include <vector>
+
+namespace lab {
+    namespace Bench {
+        namespace {
+            std::vector<vec3> RandomVec3s(std::size_t const count, uint32_t const seed) {
+                const std::vector<float> floats = RandomFloats(count * 3, -100.f, 100.f, seed);
+                std::vector<vec3> ret(count);
+                for (std::size_t i = 0; i < count; i++) {
+                    ret[i] = vec3{ floats[i * 3], floats[i * 3 + 1], floats[i * 3 + 2] };
+                }
+                return ret;
+            }
+            std::vector<vec4> RandomVec4s(std::size_t const count, uint32_t const seed) {
+                const std::vector<float> floats = RandomFloats(count * 4, -100.f, 100.f, seed);
+                std::vector<vec4> ret(count);
+                for (std::size_t i = 0; i < count; i++) {
+                    ret[i] = vec4{ floats[i * 4], floats[i * 4 + 1], floats[i * 4 + 2], floats[i * 4 + 3] };
+                }
+                return ret;
+            }
+
+            void BenchVec3(std::vector<vec3> const& lhs, std::vector<vec3> const& rhs) {
+                std::vector<vec3> out(lhs.size());
+                std::vector<float> scalarOut(lhs.size());
+
+                RunAndPrint("vec3 +", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i] + rhs[i];
+                    }
+                    DoNotOptimize(out.data());
+                });
+                RunAndPrint("vec3 Dot", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        scalarOut[i] = lhs[i].Dot(rhs[i]);
+                    }
+                    DoNotOptimize(scalarOut.data());
+                });
+                RunAndPrint("vec3 Cross", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i].Cross(rhs[i]);
+                    }
+                    DoNotOptimize(out.data());
+                });
+                RunAndPrint("vec3 Magnitude", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        scalarOut[i] = lhs[i].Magnitude();
+                    }
+                    DoNotOptimize(scalarOut.data());
+                });
+                RunAndPrint("vec3 Normalized", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i].Normalized();
+                    }
+                    DoNotOptimize(out.data());
+                });
+            }
+
+            void BenchVec4(std::vector<vec4> const& lhs, std::vector<vec4> const& rhs) {
+                std::vector<vec4> out(lhs.size());
+                std::vector<float> scalarOut(lhs.size());
+
+                RunAndPrint("vec4 +", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i] + rhs[i];
+                    }
+                    DoNotOptimize(out.data());
+                });
+                RunAndPrint("vec4 *", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i] * rhs[i];
+                    }
+                    DoNotOptimize(out.data());
+                });
+                RunAndPrint("vec4 Dot", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        scalarOut[i] = lhs[i].Dot(rhs[i]);
+                    }
+                    DoNotOptimize(scalarOut.data());
+                });
+                RunAndPrint("vec4 Normalized", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i].Normalized();
+                    }
+                    DoNotOptimize(out.data());
+                });
+            }
+
+#ifdef USING_SIMD
+            void BenchVectorSIMD(std::vector<vec4> const& lhsVec4, std::vector<vec4> const& rhsVec4) {
+                std::vector<VectorSIMD> lhs(lhsVec4.begin(), lhsVec4.end());
+                std::vector<VectorSIMD> rhs(rhsVec4.begin(), rhsVec4.end());
+                std::vector<VectorSIMD> out(lhs.size());
+                std::vector<float> scalarOut(lhs.size());
+
+                RunAndPrint("VectorSIMD +", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i] + rhs[i];
+                    }
+                    DoNotOptimize(out.data());
+                });
+                RunAndPrint("VectorSIMD *", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i] * rhs[i];
+                    }
+                    DoNotOptimize(out.data());
+                });
+                RunAndPrint("VectorSIMD Dot", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        scalarOut[i] = lhs[i].Dot(rhs[i]);
+                    }
+                    DoNotOptimize(scalarOut.data());
+                });
+                RunAndPrint("VectorSIMD Normalized", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs.size(); i++) {
+                        out[i] = lhs[i].Normalized();
+                    }
+                    DoNotOptimize(out.data());
+                });
+
+#ifdef LAB_USING_AVX2
+                //two vec4s per VectorSIMD8, so ops per call is the vec4 count
+                std::vector<VectorSIMD8> lhs8(lhs.size() / 2);
+                std::vector<VectorSIMD8> rhs8(lhs.size() / 2);
+                std::vector<VectorSIMD8> out8(lhs.size() / 2);
+                for (std::size_t i = 0; i < lhs8.size(); i++) {
+                    lhs8[i] = VectorSIMD8{ lhsVec4[i * 2], lhsVec4[i * 2 + 1] };
+                    rhs8[i] = VectorSIMD8{ rhsVec4[i * 2], rhsVec4[i * 2 + 1] };
+                }
+                RunAndPrint("VectorSIMD8 + (per vec4)", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs8.size(); i++) {
+                        out8[i] = lhs8[i] + rhs8[i];
+                    }
+                    DoNotOptimize(out8.data());
+                });
+                RunAndPrint("VectorSIMD8 Dot (per vec4)", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs8.size(); i++) {
+                        const auto dots = lhs8[i].Dot(rhs8[i]);
+                        scalarOut[i * 2] = dots.x;
+                        scalarOut[i * 2 + 1] = dots.y;
+                    }
+                    DoNotOptimize(scalarOut.data());
+                });
+                RunAndPrint("VectorSIMD8 Normalized (per vec4)", lhs.size(), [&] {
+                    for (std::size_t i = 0; i < lhs8.size(); i++) {
+                        out8[i] = lhs8[i].Normalized();
+                    }
+                    DoNotOptimize(out8.data());
+                });
+#endif
+            }
+#endif
+
+            void BenchSoA(std::vector<vec3> const& lhsVec3, std::vector<vec3> const& rhsVec3) {
+                const VectorSoA<float, 3> lhs{ std::span<const vec3>{ lhsVec3 } };
+                const VectorSoA<float, 3> rhs{ std::span<const vec3>{ rhsVec3 } };
+                VectorSoA<float, 3> out{ lhs.Size() };
+                std::vector<float> scalarOut(lhs.Size());
+
+                RunAndPrint("VectorSoA<3> Add", lhs.Size(), [&] {
+                    Add(lhs, rhs, out);
+                    DoNotOptimize(out.data);
+                });
+                RunAndPrint("VectorSoA<3> Dot", lhs.Size(), [&] {
+                    Dot(lhs, rhs, std::span<float>{ scalarOut });
+                    DoNotOptimize(scalarOut.data());
+                });
+                RunAndPrint("VectorSoA<3> Cross", lhs.Size(), [&] {
+                    Cross(lhs, rhs, out);
+                    DoNotOptimize(out.data);
+                });
+                RunAndPrint("VectorSoA<3> Magnitude", lhs.Size(), [&] {
+                    Magnitude(lhs, std::span<float>{ scalarOut });
+                    DoNotOptimize(scalarOut.data());
+                });
+                RunAndPrint("VectorSoA<3> Normalize", lhs.Size(), [&] {
+                    Normalize(lhs, out);
+                    DoNotOptimize(out.data);
+                });
+            }
+
+            void BenchHash(std::vector<vec3> const& vectors) {
+                std::vector<uint32_t> hashes(vectors.size());
+                std::vector<std::size_t> sizeHashes(vectors.size());
+
+                //what std::hash<Vector> used to do, a full MurmurHash3 per component and the glm hash_combine between them
+                const Result perComponent = RunAndPrint("vec3 hash, MurmurHash3 per component", vectors.size(), [&] {
+                    for (std::size_t i = 0; i < vectors.size(); i++) {
+                        std::size_t seed = 0;
+                        for (uint8_t dim = 0; dim < 3; dim++) {
+                            float component = vectors[i][dim];
+                            if (component == 0.f) {
+                                component = 0.f;
+                            }
+                            std::size_t hash = detail::MurmurFinish(detail::MurmurBlock(0, std::bit_cast<uint32_t>(component)), sizeof(float));
+                            hash += 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                            seed ^= hash;
+                        }
+                        sizeHashes[i] = seed;
+                    }
+                    DoNotOptimize(sizeHashes.data());
+                });
+                const Result single = RunAndPrint("vec3 Hash (std::hash)", vectors.size(), [&] {
+                    for (std::size_t i = 0; i < vectors.size(); i++) {
+                        hashes[i] = Hash(vectors[i]);
+                    }
+                    DoNotOptimize(hashes.data());
+                });
+                PrintSpeedup(perComponent, single);
+                const Result batch = RunAndPrint("vec3 HashBatch", vectors.size(), [&] {
+                    HashBatch<float, 3>(vectors, hashes);
+                    DoNotOptimize(hashes.data());
+                });
+                PrintSpeedup(single, batch);
+                const VectorSoA<float, 3> soa{ std::span<const vec3>{ vectors } };
+                const Result soaBatch = RunAndPrint("VectorSoA<3> HashBatch", soa.Size(), [&] {
+                    HashBatch(soa, hashes);
+                    DoNotOptimize(hashes.data());
+                });
+                PrintSpeedup(single, soaBatch);
+            }
+
+            void BenchPacked(std::vector<vec3> const& vectors) {
+                //snorm and unorm clamp, give them data in range like normals and colors
+                const std::vector<float> normalFloats = RandomFloats(vectors.size() * 3, -1.f, 1.f, 14);
+                const std::vector<float> colorFloats = RandomFloats(vectors.size() * 4, 0.f, 1.f, 15);
+                std::vector<vec3> normals(vectors.size());
+                std::vector<vec4> colors(vectors.size());
+                for (std::size_t i = 0; i < vectors.size(); i++) {
+                    normals[i] = vec3{ normalFloats[i * 3], normalFloats[i * 3 + 1], normalFloats[i * 3 + 2] };
+                    colors[i] = vec4{ colorFloats[i * 4], colorFloats[i * 4 + 1], colorFloats[i * 4 + 2], colorFloats[i * 4 + 3] };
+                }
+
+                std::vector<half3> halfs(vectors.size());
+                std::vector<vec3> unpacked(vectors.size());
+                const Result scalarHalf = RunAndPrint("vec3 -> half3, one at a time", vectors.size(), [&] {
+                    for (std::size_t i = 0; i < vectors.size(); i++) {
+                        halfs[i] = half3{ vectors[i] };
+                    }
+                    DoNotOptimize(halfs.data());
+                });
+                const Result batchHalf = RunAndPrint("vec3 -> half3, PackBatch", vectors.size(), [&] {
+                    PackBatch<PackedFormat::Half, 3>(vectors, halfs);
+                    DoNotOptimize(halfs.data());
+                });
+                PrintSpeedup(scalarHalf, batchHalf);
+                const Result scalarUnpack = RunAndPrint("half3 -> vec3, one at a time", vectors.size(), [&] {
+                    for (std::size_t i = 0; i < vectors.size(); i++) {
+                        unpacked[i] = halfs[i].Unpack();
+                    }
+                    DoNotOptimize(unpacked.data());
+                });
+                const Result batchUnpack = RunAndPrint("half3 -> vec3, UnpackBatch", vectors.size(), [&] {
+                    UnpackBatch<PackedFormat::Half, 3>(halfs, unpacked);
+                    DoNotOptimize(unpacked.data());
+                });
+                PrintSpeedup(scalarUnpack, batchUnpack);
+
+                std::vector<snorm16x3> snorms(normals.size());
+                const Result scalarSnorm = RunAndPrint("vec3 -> snorm16x3, one at a time", normals.size(), [&] {
+                    for (std::size_t i = 0; i < normals.size(); i++) {
+                        snorms[i] = snorm16x3{ normals[i] };
+                    }
+                    DoNotOptimize(snorms.data());
+                });
+                const Result batchSnorm = RunAndPrint("vec3 -> snorm16x3, PackBatch", normals.size(), [&] {
+                    PackBatch<PackedFormat::Snorm16, 3>(normals, snorms);
+                    DoNotOptimize(snorms.data());
+                });
+                PrintSpeedup(scalarSnorm, batchSnorm);
+
+                std::vector<unorm8x4> unorms(colors.size());
+                const Result scalarUnorm = RunAndPrint("vec4 -> unorm8x4, one at a time", colors.size(), [&] {
+                    for (std::size_t i = 0; i < colors.size(); i++) {
+                        unorms[i] = unorm8x4{ colors[i] };
+                    }
+                    DoNotOptimize(unorms.data());
+                });
+                const Result batchUnorm = RunAndPrint("vec4 -> unorm8x4, PackBatch", colors.size(), [&] {
+                    PackBatch<PackedFormat::Unorm8, 4>(colors, unorms);
+                    DoNotOptimize(unorms.data());
+                });
+                PrintSpeedup(scalarUnorm, batchUnorm);
+            }
+            //a frame of small batch jobs, each needing a scratch buffer. the heap version allocates and frees one per job
+            void BenchScratch(std::vector<vec3> const& vectors) {
+                //a frame of small jobs whose outputs are read after every job is done, so each job's buffer lives until the end of the frame
+                constexpr std::size_t jobCount = 64;
+                const std::size_t jobSize = vectors.size() / jobCount;
+                uint32_t checksum = 0;
+                std::vector<std::vector<uint32_t>> heapOutputs;
+                heapOutputs.reserve(jobCount);
+                const Result heap = RunAndPrint("scratch std::vector per job + HashBatch", jobCount * jobSize, [&] {
+                    for (std::size_t job = 0; job < jobCount; job++) {
+                        std::vector<uint32_t>& hashes = heapOutputs.emplace_back(jobSize);
+                        HashBatch<float, 3>(std::span<const vec3>{ vectors.data() + job * jobSize, jobSize }, hashes);
+                    }
+                    for (std::size_t job = 0; job < jobCount; job++) {
+                        checksum += heapOutputs[job][job % jobSize];
+                    }
+                    heapOutputs.clear();
+                    DoNotOptimize(checksum);
+                });
+                FrameArena arena{};
+                std::vector<std::span<uint32_t>> arenaOutputs;
+                arenaOutputs.reserve(jobCount);
+                const Result arenaResult = RunAndPrint("scratch FrameArena per job + HashBatch", jobCount * jobSize, [&] {
+                    for (std::size_t job = 0; job < jobCount; job++) {
+                        const std::span<uint32_t> hashes = arenaOutputs.emplace_back(arena.Allocate<uint32_t>(jobSize));
+                        HashBatch<float, 3>(std::span<const vec3>{ vectors.data() + job * jobSize, jobSize }, hashes);
+                    }
+                    for (std::size_t job = 0; job < jobCount; job++) {
+                        checksum += arenaOutputs[job][job % jobSize];
+                    }
+                    arenaOutputs.clear();
+                    arena.Reset();
+                    DoNotOptimize(checksum);
+                });
+                PrintSpeedup(heap, arenaResult);
+            }
+        }
+
+        void BenchVector() {
+            const std::vector<vec3> lhsVec3 = RandomVec3s(elementCount, 10);
+            const std::vector<vec3> rhsVec3 = RandomVec3s(elementCount, 11);
+            const std::vector<vec4> lhsVec4 = RandomVec4s(elementCount, 12);
+            const std::vector<vec4> rhsVec4 = RandomVec4s(elementCount, 13);
+
+            PrintHeader("Vector (per element)");
+            BenchVec3(lhsVec3, rhsVec3);
+            BenchVec4(lhsVec4, rhsVec4);
+#ifdef USING_SIMD
+            BenchVectorSIMD(lhsVec4, rhsVec4);
+#endif
+            BenchSoA(lhsVec3, rhsVec3);
+            BenchHash(lhsVec3);
+
+            PrintHeader("Packed vectors (per vector)");
+            BenchPacked(lhsVec3);
+
+            PrintHeader("Scratch buffers (per element)");
+            BenchScratch(lhsVec3);
+        }
+    }
+}
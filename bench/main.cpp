@@ -0,0 +1,37 @@
+#include "Bench.h"
+
+#include "Support/Precision.h"
+#include "Support/Sqrt.h"
+
+#include <cstdio>
+
+#if LAB_USING_AVX2
+    char const* SIMD_TYPE = "avx2";
+#elif LAB_USING_SSE
+    char const* SIMD_TYPE = "sse";
+#else
+    char const* SIMD_TYPE = "scalar";
+#endif
+
+#ifdef LAB_USING_HARDWARE_SQRT
+    char const* SQRT_TYPE = "hardware sqrt";
+#else
+    char const* SQRT_TYPE = "software sqrt";
+#endif
+
+int main() {
+    //configure once per flavor (USE_SSE_INTERNAL, USE_AVX2_INTERNAL, or neither) to compare scalar, sse and avx2
+    printf("LAB benchmarks - %s, %s, LAB_PRECISION %d\n", SIMD_TYPE, SQRT_TYPE, static_cast<int>(lab::DefaultPrecision));
+
+    lab::Bench::BenchVector();
+    lab::Bench::BenchMatrix();
+    lab::Bench::BenchQuaternion();
+    lab::Bench::BenchMath();
+    lab::Bench::BenchCamera();
+    lab::Bench::BenchBounding();
+    lab::Bench::BenchGeometry();
+    lab::Bench::BenchSkinning();
+    lab::Bench::BenchTransform();
+
+    return 0;
+}
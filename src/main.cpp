@@ -5,7 +5,16 @@
 #include "Vector/Hash.h"
 #include "CameraCSRuntime.h"
 #include "Quaternion.h"
-
+#include "Quaternion/QuaternionBatch.h"
+#include "Quaternion/QuaternionCompression.h"
+#include "Skinning.h"
+#include "Frustum.h"
+#include "Bounding.h"
+#include "Geometry.h"
+#include "Support/TrigBatch.h"
+#include "Support/Memory.h"
+
+#include <bit>
 #include <cstdio>
 #include <fstream>
 #include <concepts>
@@ -76,6 +85,25 @@ int main() {
 
 		const auto normalMat = lab::Matrix<float, 3, 3>(5.f).GetInverse().Transposed();
 		outFile.write(reinterpret_cast<const char*>(&normalMat), sizeof(normalMat));
+
+		//rotation about z, per axis scale and a translation. the constexpr and SIMD inverses have to match bit for bit
+		LAB_constexpr lab::mat4 transform{
+			lab::vec4{0.6f, 0.8f, 0.f, 0.f} * 2.f,
+			lab::vec4{-0.8f, 0.6f, 0.f, 0.f} * 3.f,
+			lab::vec4{0.f, 0.f, 0.5f, 0.f},
+			lab::vec4{1.f, -2.f, 3.f, 1.f}
+		};
+		LAB_constexpr lab::mat4 inverseConst = transform.GetInverse();
+		LAB_constexpr lab::mat4 affineInverseConst = transform.GetAffineInverse();
+		lab::mat4 transformRuntime = transform;
+		const lab::mat4 inverseRuntime = transformRuntime.GetInverse();
+		const lab::mat4 affineInverseRuntime = transformRuntime.GetAffineInverse();
+		outFile.write(reinterpret_cast<const char*>(&inverseConst), sizeof(inverseConst));
+		outFile.write(reinterpret_cast<const char*>(&inverseRuntime), sizeof(inverseRuntime));
+		outFile.write(reinterpret_cast<const char*>(&affineInverseConst), sizeof(affineInverseConst));
+		outFile.write(reinterpret_cast<const char*>(&affineInverseRuntime), sizeof(affineInverseRuntime));
+		printf("inverse comparison : (%.10f) - (%.10f)\n", inverseConst.columns[3][0], inverseRuntime.columns[3][0]);
+		printf("affine inverse comparison : (%.10f) - (%.10f)\n", affineInverseConst.columns[3][0], affineInverseRuntime.columns[3][0]);
 	}
 
 	
@@ -83,6 +111,56 @@ int main() {
 		std::size_t seed = 0;
 		seed ^= std::hash<lab::vec2>{}(lab::vec2(1.f, 0.f));
 		outFile.write(reinterpret_cast<const char*>(&seed), sizeof(std::size_t));
+
+		//the constexpr hash and the runtime (SIMD) batch need to agree, -0 and 0 hash the same
+		auto hashTest = []() {
+			lab::vec3 vectors[11];
+			for (uint8_t i = 0; i < 11; i++) {
+				vectors[i] = lab::vec3{static_cast<float>(i) * 0.5f, (i % 2 == 0) ? 0.f : -0.f, 3.f - static_cast<float>(i)};
+			}
+			uint32_t hashes[11];
+			lab::HashBatch<float, 3>(vectors, hashes);
+			uint32_t ret = lab::Hash(lab::vec3{0.f, -0.f, 3.f}) ^ lab::Hash(lab::vec3{0.f, 0.f, 3.f});
+			for (uint8_t i = 0; i < 11; i++) {
+				ret = ret * 31 + hashes[i];
+			}
+			return ret;
+		};
+		LAB_constexpr uint32_t hashConst = hashTest();
+		const uint32_t hashRuntime = hashTest();
+		outFile.write(reinterpret_cast<const char*>(&hashConst), sizeof(uint32_t));
+		outFile.write(reinterpret_cast<const char*>(&hashRuntime), sizeof(uint32_t));
+		printf("hash comparison : (%u) - (%u)\n", hashConst, hashRuntime);
+	}
+	{ //packed vectors, the constexpr software conversions and the runtime batch (F16C with AVX2) need the same bits
+		auto packedTest = []() {
+			lab::vec4 vectors[9];
+			for (uint8_t i = 0; i < 9; i++) {
+				//denormal halfs, round to even ties, clamping and -0
+				vectors[i] = lab::vec4{static_cast<float>(i) * 1e-6f, 1.f + static_cast<float>(i) * 0.00048828125f, static_cast<float>(i) * 0.3f - 1.3f, (i == 4) ? -0.f : static_cast<float>(i) / 9.f};
+			}
+			lab::half4 halfs[9];
+			lab::snorm16x4 snorms[9];
+			lab::unorm8x4 unorms[9];
+			lab::PackBatch<lab::PackedFormat::Half, 4>(vectors, halfs);
+			lab::PackBatch<lab::PackedFormat::Snorm16, 4>(vectors, snorms);
+			lab::PackBatch<lab::PackedFormat::Unorm8, 4>(vectors, unorms);
+			lab::vec4 unpacked[9];
+			lab::UnpackBatch<lab::PackedFormat::Half, 4>(halfs, unpacked);
+			float ret = 0.f;
+			for (uint8_t i = 0; i < 9; i++) {
+				ret += unpacked[i].x * 1e6f + unpacked[i].y + unpacked[i].z + unpacked[i].w;
+				for (uint8_t dim = 0; dim < 4; dim++) {
+					ret += static_cast<float>(halfs[i].data[dim] % 97) + static_cast<float>(snorms[i].data[dim]) * 1e-4f + static_cast<float>(unorms[i].data[dim]);
+				}
+			}
+			return ret;
+		};
+		LAB_constexpr float packedConst = packedTest();
+		const float packedRuntime = packedTest();
+		outFile.write(reinterpret_cast<const char*>(&packedConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&packedRuntime), sizeof(float));
+		printf("packed vector comparison : (%.10f) - (%.10f)\n", packedConst, packedRuntime);
 	}
 	
 	
@@ -127,6 +205,30 @@ int main() {
 		outFile.write(reinterpret_cast<const char*>(&nDP), sizeof(float));
 		//printf("nDP : %.2f\n", nDP);
 	}
+	{ //structure of arrays, the constexpr and runtime (SIMD) kernels need to agree
+		auto soaTest = []() {
+			lab::VectorSoA<float, 3> lhs{};
+			lab::VectorSoA<float, 3> rhs{};
+			for (uint8_t i = 0; i < 11; i++) {
+				lhs.PushBack(lab::vec3{ static_cast<float>(i), 1.f, 2.f });
+				rhs.PushBack(lab::vec3{ 3.f, static_cast<float>(i), 4.f });
+			}
+			lab::VectorSoA<float, 3> crossed{};
+			lab::Cross(lhs, rhs, crossed);
+			lab::Add(crossed, lhs, crossed);
+			lab::Normalize(crossed, crossed);
+			float dots[11];
+			lab::Dot(crossed, rhs, std::span<float>{dots});
+			float mags[11];
+			lab::Magnitude(lhs, std::span<float>{mags});
+			return dots[0] + dots[10] + mags[10];
+		};
+		LAB_constexpr float soaConst = soaTest();
+		const float soaRuntime = soaTest();
+		outFile.write(reinterpret_cast<const char*>(&soaConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&soaRuntime), sizeof(float));
+		printf("soa comparison : (%.10f) - (%.10f)\n", soaConst, soaRuntime);
+	}
 
 	{ //matrices
 
@@ -145,6 +247,190 @@ int main() {
 
 		//LAB_constexpr lab::Matrix<float, 3, 3, 4> mat1(vecArray);
 	}
+	{ //aligned storage, the runtime matrix batch uses aligned loads and has to match the constexpr product
+		LAB_static_assert(alignof(lab::mat4) == lab::BatchAlignment);
+		auto alignedTest = []() {
+			lab::AlignedVector<lab::mat4> lhs{};
+			for (uint8_t i = 0; i < 5; i++) {
+				lhs.push_back(lab::mat4{static_cast<float>(i + 1)});
+				lhs.back().columns[3] = lab::mat4::ColType(1.f, -2.f, static_cast<float>(i), 1.f);
+			}
+			lab::AlignedVector<lab::mat4> products(lhs.size());
+			lab::MultiplyBatch<float>(lhs, lhs, products);
+			return products[4].columns[3][2] + products[2].columns[1][1];
+		};
+		LAB_constexpr float alignedConst = alignedTest();
+		const float alignedRuntime = alignedTest();
+		outFile.write(reinterpret_cast<const char*>(&alignedConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&alignedRuntime), sizeof(float));
+		printf("aligned storage comparison : (%.10f) - (%.10f)\n", alignedConst, alignedRuntime);
+
+		//the arena is runtime only, its buffers have to land on the same boundary
+		lab::FrameArena arena{256};
+		const std::span<float> scratch = arena.Allocate<float>(13);
+		const std::span<lab::mat4> spilled = arena.Allocate<lab::mat4>(9);
+		printf("frame arena misalignment : %zu - %zu\n", reinterpret_cast<std::uintptr_t>(scratch.data()) % lab::BatchAlignment, reinterpret_cast<std::uintptr_t>(spilled.data()) % lab::BatchAlignment);
+		arena.Reset();
+	}
+	{ //batched transforms, 11 points so the SIMD body and the scalar tail both run and have to match the constexpr loop
+		auto transformTest = []() {
+			lab::mat4 matrix{1.f};
+			matrix.columns[0] = lab::mat4::ColType(0.7f, 0.3f, -0.64f, 0.f);
+			matrix.columns[1] = lab::mat4::ColType(-0.21f, 0.93f, 0.3f, 0.f);
+			matrix.columns[2] = lab::mat4::ColType(0.68f, -0.13f, 0.72f, 0.f);
+			matrix.columns[3] = lab::mat4::ColType(1.1f, -2.3f, 0.37f, 1.f);
+			lab::vec3 points[11];
+			for (uint8_t i = 0; i < 11; i++) {
+				points[i] = lab::vec3{static_cast<float>(i) * 0.37f - 1.f, 1.f / static_cast<float>(i + 1), static_cast<float>(i) * 0.23f + 0.1f};
+			}
+			lab::vec3 moved[11];
+			lab::vec3 turned[11];
+			lab::TransformPoints<float>(matrix, points, moved);
+			lab::TransformDirections<float>(matrix, points, turned);
+			float ret = 0.f;
+			for (uint8_t i = 0; i < 11; i++) {
+				//halved every step so the tail, which is where the two loops meet, keeps its last bits
+				ret = ret * 0.5f + moved[i].x + moved[i].y * 2.f + moved[i].z * 3.f;
+				ret = ret * 0.5f + turned[i].x + turned[i].y * 2.f + turned[i].z * 3.f;
+			}
+			return ret;
+		};
+		LAB_constexpr float transformConst = transformTest();
+		const float transformRuntime = transformTest();
+		outFile.write(reinterpret_cast<const char*>(&transformConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&transformRuntime), sizeof(float));
+		printf("batched transform comparison : (%.10f) - (%.10f)\n", transformConst, transformRuntime);
+	}
+	{ //quaternions, the SIMD product and ToMat4 have to match the constexpr ones bit for bit
+		auto quatTest = []() {
+			const lab::Quat quatA{0.25f, -0.5f, 0.75f, 0.35f};
+			const lab::Quat quatB{-0.3f, 0.1f, 0.6f, -0.7f};
+			const lab::vec3 rotateInput{1.5f, -2.f, 0.25f};
+			std::array<lab::Quat, 9> lhs{};
+			std::array<lab::Quat, 9> rhs{};
+			std::array<lab::vec3, 9> vecs{};
+			for (uint8_t i = 0; i < 9; i++) {
+				lhs[i] = quatA * static_cast<float>(i + 1);
+				rhs[i] = quatB;
+				vecs[i] = rotateInput;
+			}
+			std::array<lab::Quat, 9> products{};
+			lab::MultiplyBatch<float>(lhs, rhs, products);
+			std::array<lab::mat4, 9> mats{};
+			lab::ToMat4Batch<float>(products, mats);
+			lab::RotateVectorBatch<float>(products, vecs, vecs);
+			const lab::mat4 single = (quatA * quatB).ToMat4();
+			return mats[8].columns[1][2] + single.columns[2][0] + vecs[8].z;
+		};
+		LAB_constexpr float quatConst = quatTest();
+		const float quatRuntime = quatTest();
+		outFile.write(reinterpret_cast<const char*>(&quatConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&quatRuntime), sizeof(float));
+		printf("quaternion comparison : (%.10f) - (%.10f)\n", quatConst, quatRuntime);
+
+		//these normalize, so they only match with LAB_DETERMINISTIC
+		auto interpolationTest = []() {
+			std::array<lab::Quat, 9> lhs{};
+			std::array<lab::Quat, 9> rhs{};
+			for (uint8_t i = 0; i < 9; i++) {
+				lhs[i] = lab::Quat{0.5f, 0.5f, -0.5f, 0.5f};
+				rhs[i] = lab::Quat{0.f, -0.6f, 0.f, static_cast<float>(i) * 0.1f - 0.4f};
+			}
+			std::array<lab::Quat, 9> nlerps{};
+			std::array<lab::Quat, 9> slerps{};
+			lab::NlerpBatch<float>(lhs, rhs, 0.3f, nlerps);
+			lab::FastSlerpBatch<float>(lhs, rhs, 0.3f, slerps);
+			return nlerps[8].y + slerps[8].y + slerps[0].w;
+		};
+		LAB_constexpr float interpolationConst = interpolationTest();
+		const float interpolationRuntime = interpolationTest();
+		outFile.write(reinterpret_cast<const char*>(&interpolationConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&interpolationRuntime), sizeof(float));
+		printf("interpolation comparison : (%.10f) - (%.10f)\n", interpolationConst, interpolationRuntime);
+
+		//smallest three only uses the software sqrt, so this one always matches
+		auto compressionTest = []() {
+			std::array<lab::Quat, 9> quats{};
+			for (uint8_t i = 0; i < 9; i++) {
+				//unnormalized, negative largest components, ties and the all 0.5 worst case
+				quats[i] = lab::Quat{0.5f, -0.5f, 0.5f - static_cast<float>(i) * 0.1f, -0.5f} * static_cast<float>(i + 1);
+			}
+			std::array<uint32_t, 9> compressed32{};
+			std::array<uint64_t, 9> compressed64{};
+			lab::CompressSmallestThreeBatch<10, float>(quats, compressed32);
+			lab::CompressSmallestThreeBatch<15, float>(quats, compressed64);
+			std::array<lab::Quat, 9> decompressed32{};
+			std::array<lab::Quat, 9> decompressed64{};
+			lab::DecompressSmallestThreeBatch<10, float>(compressed32, decompressed32);
+			lab::DecompressSmallestThreeBatch<15, float>(compressed64, decompressed64);
+			float ret = 0.f;
+			for (uint8_t i = 0; i < 9; i++) {
+				ret += static_cast<float>(compressed32[i] % 1009) + static_cast<float>(compressed64[i] % 1013);
+				ret += decompressed32[i].x + decompressed32[i].w + decompressed64[i].y + decompressed64[i].z;
+			}
+			return ret;
+		};
+		LAB_constexpr float compressionConst = compressionTest();
+		const float compressionRuntime = compressionTest();
+		outFile.write(reinterpret_cast<const char*>(&compressionConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&compressionRuntime), sizeof(float));
+		printf("smallest three comparison : (%.10f) - (%.10f)\n", compressionConst, compressionRuntime);
+	}
+	{ //skinning
+		auto linearBlendTest = []() {
+			std::array<lab::mat4, 3> palette{};
+			for (uint8_t b = 0; b < 3; b++) {
+				palette[b] = lab::Quat{0.f, 0.6f, 0.f, 0.8f - static_cast<float>(b) * 0.1f}.ToMat4();
+				palette[b].columns[3] = lab::mat4::ColType(static_cast<float>(b), 1.f, -2.f, 1.f);
+			}
+			std::array<uint16_t, 9 * lab::SkinInfluences> boneIndices{};
+			std::array<float, 9 * lab::SkinInfluences> weights{};
+			lab::VectorSoA<float, 3> positions(9);
+			for (uint8_t i = 0; i < 9; i++) {
+				for (uint8_t k = 0; k < lab::SkinInfluences; k++) {
+					boneIndices[i * lab::SkinInfluences + k] = static_cast<uint16_t>((i + k) % 3);
+					weights[i * lab::SkinInfluences + k] = 0.25f + static_cast<float>(k) * 0.05f - 0.075f;
+				}
+				positions.Set(i, lab::vec3{static_cast<float>(i), 0.5f, -1.f});
+			}
+			lab::SkinLinearBlend<float>(palette, boneIndices, weights, positions, positions);
+			return positions.Get(8).x + positions.Get(0).z;
+		};
+		LAB_constexpr float linearBlendConst = linearBlendTest();
+		const float linearBlendRuntime = linearBlendTest();
+		outFile.write(reinterpret_cast<const char*>(&linearBlendConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&linearBlendRuntime), sizeof(float));
+		printf("linear blend skinning comparison : (%.10f) - (%.10f)\n", linearBlendConst, linearBlendRuntime);
+
+		//the blend is normalized, so this only matches with LAB_DETERMINISTIC
+		auto dualQuaternionTest = []() {
+			std::array<lab::DualQuat, 3> palette{};
+			for (uint8_t b = 0; b < 3; b++) {
+				palette[b] = lab::DualQuat::FromRotationTranslation(lab::Quat{0.f, 0.6f, 0.f, 0.8f}, lab::vec3{static_cast<float>(b), 1.f, -2.f});
+			}
+			palette[2].real = palette[2].real * -1.f;
+			palette[2].dual = palette[2].dual * -1.f;
+			std::array<uint16_t, 9 * lab::SkinInfluences> boneIndices{};
+			std::array<float, 9 * lab::SkinInfluences> weights{};
+			lab::VectorSoA<float, 3> positions(9);
+			lab::VectorSoA<float, 3> normals(9);
+			for (uint8_t i = 0; i < 9; i++) {
+				for (uint8_t k = 0; k < lab::SkinInfluences; k++) {
+					boneIndices[i * lab::SkinInfluences + k] = static_cast<uint16_t>((i + k) % 3);
+					weights[i * lab::SkinInfluences + k] = 0.25f + static_cast<float>(k) * 0.05f - 0.075f;
+				}
+				positions.Set(i, lab::vec3{static_cast<float>(i), 0.5f, -1.f});
+				normals.Set(i, lab::vec3{0.f, 0.6f, 0.8f});
+			}
+			lab::SkinDualQuaternion<float>(palette, boneIndices, weights, positions, normals, positions, normals);
+			return positions.Get(8).x + positions.Get(0).z + normals.Get(5).x;
+		};
+		LAB_constexpr float dualQuaternionConst = dualQuaternionTest();
+		const float dualQuaternionRuntime = dualQuaternionTest();
+		outFile.write(reinterpret_cast<const char*>(&dualQuaternionConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&dualQuaternionRuntime), sizeof(float));
+		printf("dual quaternion skinning comparison : (%.10f) - (%.10f)\n", dualQuaternionConst, dualQuaternionRuntime);
+	}
 	{ //rotation, scale, and translate of matrices
 		LAB_constexpr lab::Vector<float, 3> testVec{ 0.f, 1.f, 2.f };
 		LAB_constexpr float testFloat0 = testVec[0];
@@ -206,6 +492,26 @@ int main() {
 		auto normMat = transformScale.GetNormalMatrix();
 		printf("normMat 0,0 - %.2f\n", normMat.At(0, 0));
 	}
+	{ //transform hierarchy, only the moved node and its subtree are recomputed
+		auto hierarchyTest = []() {
+			lab::TransformHierarchy<float> hierarchy;
+			const uint32_t root = hierarchy.AddNode(hierarchy.NoParent, lab::vec3{1.f, 0.f, 0.f}, lab::Quat{0.f, 0.6f, 0.f, 0.8f}, lab::vec3{2.f});
+			uint32_t previous = root;
+			for (uint8_t i = 0; i < 9; i++) {
+				const uint32_t parent = (i % 3 == 0) ? root : previous;
+				previous = hierarchy.AddNode(parent, lab::vec3{static_cast<float>(i) * 0.1f, 1.f, -0.5f}, lab::Quat{0.f, 0.f, 0.6f, 0.8f}, lab::vec3{1.f, 0.9f, 1.1f});
+			}
+			hierarchy.Update();
+			hierarchy.SetTranslation(2, lab::vec3{3.f, 2.f, 1.f});
+			const std::size_t updated = hierarchy.Update();
+			return hierarchy.GetWorldMatrix(9).At(3, 0) + hierarchy.GetWorldMatrix(3).At(1, 2) + static_cast<float>(updated);
+		};
+		LAB_constexpr float hierarchyConst = hierarchyTest();
+		const float hierarchyRuntime = hierarchyTest();
+		outFile.write(reinterpret_cast<const char*>(&hierarchyConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&hierarchyRuntime), sizeof(float));
+		printf("transform hierarchy comparison : (%.10f) - (%.10f)\n", hierarchyConst, hierarchyRuntime);
+	}
 	{ //camera functions
 		LAB_constexpr auto proj = lab::ProjectionMatrix(lab::DegreesToRadians(70.f), 1.44f, 0.f, 100.f);
 	
@@ -233,6 +539,182 @@ int main() {
 		lab::Runtime::CoordinateSystem rCS;
 		lab::Runtime::ViewRotation(rCS, lab::vec3(0.f), MyCS::unitForwardVector);
 	}
+	{ //frustum culling, the constexpr and runtime (SIMD) visibility masks need to agree
+		auto cullTest = []() {
+			const lab::Frustum<float> frustum = lab::Frustum<float>::FromMatrix(lab::ProjectionMatrix(lab::DegreesToRadians(70.f), 1.44f, 0.1f, 100.f));
+			lab::VectorSoA<float, 4> spheres;
+			lab::VectorSoA<float, 3> mins;
+			lab::VectorSoA<float, 3> maxs;
+			for (uint8_t i = 0; i < 10; i++) {
+				const lab::vec3 center{static_cast<float>(i) * 3.f - 15.f, 1.f, static_cast<float>(i) * 12.f - 10.f};
+				const float radius = 0.5f + static_cast<float>(i) * 0.25f;
+				spheres.PushBack(lab::vec4{center.x, center.y, center.z, radius});
+				mins.PushBack(center - lab::vec3{radius});
+				maxs.PushBack(center + lab::vec3{radius});
+			}
+			uint64_t sphereVisibility[1];
+			uint64_t aabbVisibility[1];
+			lab::CullSpheres(frustum, spheres, sphereVisibility);
+			lab::CullAABBs(frustum, mins, maxs, aabbVisibility);
+			//10 bits each, exact in a float
+			return static_cast<float>(sphereVisibility[0] | (aabbVisibility[0] << 10));
+		};
+		LAB_constexpr float cullConst = cullTest();
+		const float cullRuntime = cullTest();
+		outFile.write(reinterpret_cast<const char*>(&cullConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&cullRuntime), sizeof(float));
+		printf("frustum culling comparison : (%.10f) - (%.10f)\n", cullConst, cullRuntime);
+	}
+	{ //Frustum::FromCamera against the planes extracted from projection * view, MyCS puts forward on x and looks down view z = -up
+		auto cameraTest = [](bool const fromMatrix) {
+			const lab::vec3 position{1.f, -2.f, 0.5f};
+			const lab::vec3 forward{0.8f, 0.6f, 0.f};
+			const float fov = lab::DegreesToRadians(70.f);
+			const lab::Frustum<float> frustum = fromMatrix
+				? lab::Frustum<float>::FromMatrix(lab::ProjectionMatrix(fov, 1.44f, 0.1f, 30.f) * lab::ViewDirection<MyCS>(position, forward))
+				: lab::Frustum<float>::FromCamera<MyCS>(position, forward, fov, 1.44f, 0.1f, 30.f);
+			//a 4x4x4 grid of points around the camera, off the planes so rounding can't flip one. 64 bits, the float keeps the popcount and the low bits
+			uint64_t visibility = 0;
+			for (uint8_t i = 0; i < 64; i++) {
+				const lab::vec3 offset{static_cast<float>(i % 4) * 9.1f - 13.3f, static_cast<float>((i / 4) % 4) * 9.1f - 13.7f, static_cast<float>(i / 16) * 9.1f - 27.9f};
+				visibility |= static_cast<uint64_t>(frustum.ContainsPoint(position + offset)) << i;
+			}
+			return static_cast<float>(std::popcount(visibility)) * 65536.f + static_cast<float>(visibility & 0xFFFF);
+		};
+		LAB_constexpr float cameraConst = cameraTest(false);
+		const float matrixRuntime = cameraTest(true);
+		outFile.write(reinterpret_cast<const char*>(&cameraConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&matrixRuntime), sizeof(float));
+		printf("frustum from camera comparison : (%.10f) - (%.10f)\n", cameraConst, matrixRuntime);
+	}
+	{ //bounding volumes, the constexpr and runtime (SIMD) batches need to agree
+		auto boundsTest = []() {
+			const lab::mat4 matrix = lab::Quat::AngleAxis(0.7f, lab::vec3{0.f, 1.f, 0.f}).ToMat4() * lab::IdentityScale(lab::vec3{2.f, 1.f, 0.5f});
+			lab::VectorSoA<float, 3> mins;
+			lab::VectorSoA<float, 3> maxs;
+			lab::VectorSoA<float, 4> spheres;
+			for (uint8_t i = 0; i < 11; i++) {
+				const lab::vec3 center{static_cast<float>(i) - 5.f, static_cast<float>(i % 3), static_cast<float>(i) * 0.5f};
+				mins.PushBack(center - lab::vec3{0.25f * static_cast<float>(i + 1)});
+				maxs.PushBack(center + lab::vec3{0.5f});
+				spheres.PushBack(lab::vec4{center.x, center.y, center.z, 0.1f * static_cast<float>(i + 1)});
+			}
+			lab::TransformAABBs(matrix, mins, maxs, mins, maxs);
+			lab::TransformSpheres(matrix, spheres, spheres);
+			const lab::AABB<float> merged = lab::MergeAABBs(mins, maxs);
+			uint64_t hits[1];
+			lab::IntersectSpheres(lab::Sphere<float>{lab::vec3{0.f, 1.f, 2.f}, 2.f}, spheres, hits);
+			return merged.min.x + merged.max.z + spheres.Get(10).w + static_cast<float>(hits[0]);
+		};
+		//the sphere radius scale is a sqrt, so this only matches with LAB_DETERMINISTIC
+		LAB_constexpr float boundsConst = boundsTest();
+		const float boundsRuntime = boundsTest();
+		outFile.write(reinterpret_cast<const char*>(&boundsConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&boundsRuntime), sizeof(float));
+		printf("bounding volume comparison : (%.10f) - (%.10f)\n", boundsConst, boundsRuntime);
+	}
+	{ //bvh ray queries, the constexpr single rays and the runtime (SIMD) packets need to agree
+		auto bvhTest = []() {
+			lab::vec3 vertices[60];
+			for (uint8_t i = 0; i < 20; i++) {
+				const lab::vec3 corner{static_cast<float>(i % 5) * 2.f, static_cast<float>(i / 5) * 2.f, static_cast<float>(i % 3)};
+				vertices[i * 3] = corner;
+				vertices[i * 3 + 1] = corner + lab::vec3{1.5f, 0.f, 0.5f};
+				vertices[i * 3 + 2] = corner + lab::vec3{0.f, 1.5f, -0.5f};
+			}
+			const lab::BVH<float> bvh = lab::BVH<float>::Build(std::span<const lab::vec3>(vertices));
+			lab::Ray<float> rays[6];
+			lab::RayHit<float> hits[6];
+			for (uint8_t i = 0; i < 6; i++) {
+				//reset explicitly, gcc 12 loses the default initialization of part of the array at runtime once this lambda has been constant evaluated
+				hits[i] = lab::RayHit<float>{};
+				rays[i] = lab::Ray<float>{lab::vec3{static_cast<float>(i) * 1.5f + 0.3f, static_cast<float>(i) + 0.4f, 10.f}, lab::vec3{0.f, 0.1f, -1.f}};
+			}
+			bvh.Intersect(rays, hits);
+			float ret = 0.f;
+			for (auto const& hit : hits) {
+				ret += hit.distance * static_cast<float>(hit.Hit()) + hit.u + static_cast<float>(hit.triangle % 64);
+			}
+			return ret;
+		};
+		LAB_constexpr float bvhConst = bvhTest();
+		const float bvhRuntime = bvhTest();
+		outFile.write(reinterpret_cast<const char*>(&bvhConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&bvhRuntime), sizeof(float));
+		printf("bvh comparison : (%.10f) - (%.10f)\n", bvhConst, bvhRuntime);
+	}
+	{ //triangle soa, the constexpr scalar loop and the runtime (SIMD) lanes need to agree
+		auto triangleTest = []() {
+			lab::vec3 vertices[24];
+			uint32_t indices[33];
+			for (uint8_t i = 0; i < 24; i++) {
+				vertices[i] = lab::vec3{static_cast<float>(i % 4) - 1.5f, static_cast<float>(i % 5) * 0.5f - 1.f, static_cast<float>(i / 4) * -0.5f};
+			}
+			for (uint8_t i = 0; i < 33; i++) {
+				indices[i] = (i * 5 + 2) % 24;
+			}
+			const lab::TriangleSoA<float> triangles = lab::TriangleSoA<float>::FromMesh(vertices, indices);
+			float ret = 0.f;
+			for (uint8_t i = 0; i < 5; i++) {
+				lab::RayHit<float> hit;
+				lab::IntersectTriangles(lab::Ray<float>{lab::vec3{static_cast<float>(i) * 0.3f - 0.6f, 0.2f, 2.f}, lab::vec3{0.05f, 0.f, -1.f}}, triangles, hit);
+				ret += hit.distance * static_cast<float>(hit.Hit()) + hit.u + hit.v + static_cast<float>(hit.triangle % 64);
+			}
+			return ret;
+		};
+		LAB_constexpr float triangleConst = triangleTest();
+		const float triangleRuntime = triangleTest();
+		outFile.write(reinterpret_cast<const char*>(&triangleConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&triangleRuntime), sizeof(float));
+		printf("triangle soa comparison : (%.10f) - (%.10f)\n", triangleConst, triangleRuntime);
+	}
+	{ //spatial hash grid, constexpr and runtime need to find the same neighbors
+		auto gridTest = []() {
+			lab::vec3 points[40];
+			for (uint8_t i = 0; i < 40; i++) {
+				points[i] = lab::vec3{static_cast<float>(i % 7) * 0.9f - 3.f, static_cast<float>(i % 3) * 1.3f, static_cast<float>(i / 7) * -0.7f};
+			}
+			lab::SpatialHashGrid<float, 3> grid{1.f};
+			grid.Insert(points);
+			std::vector<lab::SpatialHashGrid<float, 3>::Neighbor> neighbors;
+			grid.QueryNearest(lab::vec3{0.2f, 1.f, -1.f}, 5, neighbors);
+			float ret = 0.f;
+			for (auto const& neighbor : neighbors) {
+				ret = ret * 2.f + static_cast<float>(neighbor.index) + neighbor.squaredDistance;
+			}
+			grid.QueryRadius(lab::vec3{-1.f, 0.5f, -2.f}, 1.5f, neighbors);
+			for (auto const& neighbor : neighbors) {
+				ret += static_cast<float>(neighbor.index);
+			}
+			return ret;
+		};
+		LAB_constexpr float gridConst = gridTest();
+		const float gridRuntime = gridTest();
+		outFile.write(reinterpret_cast<const char*>(&gridConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&gridRuntime), sizeof(float));
+		printf("spatial hash grid comparison : (%.10f) - (%.10f)\n", gridConst, gridRuntime);
+	}
+	{ //vertex welding, constexpr and runtime need to weld the same groups
+		auto weldTest = []() {
+			lab::vec3 vertices[24];
+			for (uint8_t i = 0; i < 24; i++) {
+				//every position comes up 3 times, nudged by less than epsilon, and -0 against 0
+				const float nudge = static_cast<float>(i / 8) * 0.0004f;
+				vertices[i] = lab::vec3{static_cast<float>(i % 4) * 0.5f + nudge, static_cast<float>(i % 8 / 4) - nudge, (i / 8 == 1) ? -0.f : 0.f};
+			}
+			const lab::WeldResult<float> welded = lab::WeldVertices<float>(vertices, 0.001f);
+			float ret = static_cast<float>(welded.vertices.size());
+			for (uint32_t const index : welded.remap) {
+				ret = ret * 1.5f + static_cast<float>(index);
+			}
+			return ret;
+		};
+		LAB_constexpr float weldConst = weldTest();
+		const float weldRuntime = weldTest();
+		outFile.write(reinterpret_cast<const char*>(&weldConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&weldRuntime), sizeof(float));
+		printf("vertex weld comparison : (%.10f) - (%.10f)\n", weldConst, weldRuntime);
+	}
 	{ //trig functions
 		LAB_constexpr float trigInput = 50.f;
 		LAB_constexpr auto cosRet = lab::Cos(trigInput);
@@ -262,6 +744,33 @@ int main() {
 
 		//printf("arc tan comparison : (%.10f):(%.10f)\n", lab::ArcTan2BitMasking(trigInput, 1.f), lab::ArcTan2(trigInput, 1.f));
 	}
+	{ //batched trig, the constexpr and runtime (SIMD) kernels need to agree
+		auto trigBatchTest = []() {
+			float input[11];
+			for (uint8_t i = 0; i < 11; i++) {
+				input[i] = static_cast<float>(i) * 7.5f - 40.f;
+			}
+			float sinOut[11];
+			float cosOut[11];
+			float tanOut[11];
+			lab::SinBatch<float>(input, sinOut);
+			lab::CosBatch<float>(input, cosOut);
+			lab::TanBatch<float>(input, tanOut);
+			float ret = sinOut[0] + sinOut[9] + cosOut[3] + cosOut[10] + tanOut[2] + tanOut[7];
+			//the other tiers have their own kernels
+			lab::SinBatch<float, lab::Precision::Fast>(input, sinOut);
+			lab::CosBatch<float, lab::Precision::Precise>(input, cosOut);
+			lab::TanBatch<float, lab::Precision::Fast>(input, tanOut);
+			ret += sinOut[1] + sinOut[8] + cosOut[0] + cosOut[10] + tanOut[3] + tanOut[9];
+			lab::TanBatch<float, lab::Precision::Precise>(input, tanOut);
+			return ret + tanOut[4] + tanOut[10];
+		};
+		LAB_constexpr float trigBatchConst = trigBatchTest();
+		const float trigBatchRuntime = trigBatchTest();
+		outFile.write(reinterpret_cast<const char*>(&trigBatchConst), sizeof(float));
+		outFile.write(reinterpret_cast<const char*>(&trigBatchRuntime), sizeof(float));
+		printf("trig batch comparison : (%.10f) - (%.10f)\n", trigBatchConst, trigBatchRuntime);
+	}
 	{ //other math functions
 		LAB_constexpr float truncRet = lab::Trunc(11.f);
 		LAB_constexpr float truncRet2 = lab::Trunc(11.2f);